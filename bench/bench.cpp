@@ -0,0 +1,141 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Entry point for the micro-benchmarks. Runs every registered
+ * case (or those whose name contains one of the program arguments) and
+ * prints the results to stdout as JSON.
+ *
+ * USAGE: > todo-bench [--max-tasks N] [name...]
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include "bench.h"
+
+namespace Bench {
+
+Run::Run(unsigned long maxTasks) : maxTasks(maxTasks), results(Json::array()) {}
+
+// Powers of ten from 'from' up to the largest size requested
+std::vector<unsigned long> Run::sizes(unsigned long from) const {
+  std::vector<unsigned long> result;
+  for (unsigned long n = from; n <= maxTasks; n *= 10) {
+    result.push_back(n);
+  }
+  return result;
+}
+
+double Run::time(const String &name, const Json &params, unsigned long items,
+               unsigned int repetitions, const std::function<void()> &fn) {
+  std::vector<double> samples;
+  samples.reserve(repetitions);
+  for (unsigned int i = 0; i < repetitions; i++) {
+    auto start = Clock::now();
+    fn();
+    auto end = Clock::now();
+    samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+  }
+  std::sort(samples.begin(), samples.end());
+
+  auto percentile = [&samples](double p) {
+    std::size_t i = static_cast<std::size_t>(std::ceil(p * samples.size())) - 1;
+    return samples[std::min(i, samples.size() - 1)];
+  };
+
+  Json j;
+  j["name"] = name;
+  j["params"] = params;
+  j["repetitions"] = repetitions;
+  j["min_ns"] = samples.front();
+  j["median_ns"] = percentile(0.5);
+  j["p90_ns"] = percentile(0.9);
+  j["p99_ns"] = percentile(0.99);
+  j["max_ns"] = samples.back();
+  if (items > 0) {
+    j["items_per_second"] = items / (percentile(0.5) / 1e9);
+  }
+  std::cerr << name << " " << params << ": " << percentile(0.5) / 1e6 << " ms" << std::endl;
+  results.push_back(j);
+  return percentile(0.5);
+}
+
+void Run::record(const String &name, const Json &params, const Json &values) {
+  Json j;
+  j["name"] = name;
+  j["params"] = params;
+  j["values"] = values;
+  std::cerr << name << " " << params << ": " << values << std::endl;
+  results.push_back(j);
+}
+
+const Json &Run::report() const noexcept {
+  return results;
+}
+
+std::vector<std::pair<String, Case>> &registry() {
+  static std::vector<std::pair<String, Case>> cases;
+  return cases;
+}
+
+Register::Register(const String &name, Case fn) {
+  registry().emplace_back(name, fn);
+}
+
+TodoList generate(unsigned long tasks, unsigned int tasksPerProject,
+                  unsigned int tagsPerTask) {
+  static const char *TAGS[] = {"uni", "home", "work", "c++", "programming",
+                               "urgent", "reading", "android", "shopping",
+                               "standard library", "maths", "admin"};
+  const unsigned int numTags = sizeof(TAGS) / sizeof(TAGS[0]);
+
+  TodoList tl;
+  Project *project = nullptr;
+  for (unsigned long i = 0; i < tasks; i++) {
+    if (i % tasksPerProject == 0) {
+      project = &tl.newProject("Module " + std::to_string(i / tasksPerProject));
+    }
+    Task &task = project->newTask("Lab Assignment " + std::to_string(i % tasksPerProject));
+    for (unsigned int t = 0; t < tagsPerTask; t++) {
+      task.addTag(TAGS[(i * 7 + t * 5) % numTags]);
+    }
+    if (i % 5 != 0) {
+      Date due;
+      // Two-digit months and days, which Date::str writes as load reads them
+      due.setDate(2020 + i % 7, 10 + i % 3, 10 + i % 19);
+      task.setDueDate(due);
+    }
+    task.setComplete(i % 3 == 0);
+  }
+  return tl;
+}
+
+} // namespace Bench
+
+int main(int argc, char *argv[]) {
+  unsigned long maxTasks = 100000;
+  std::vector<String> filters;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--max-tasks") == 0 && i + 1 < argc) {
+      maxTasks = std::stoul(argv[++i]);
+    } else {
+      filters.push_back(argv[i]);
+    }
+  }
+
+  Bench::Run run(maxTasks);
+  for (auto &entry : Bench::registry()) {
+    bool selected = filters.empty();
+    for (const String &filter : filters) {
+      selected = selected || entry.first.find(filter) != String::npos;
+    }
+    if (selected) {
+      entry.second(run);
+    }
+  }
+  std::cout << run.report().dump(2) << std::endl;
+  return 0;
+}
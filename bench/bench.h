@@ -0,0 +1,78 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Harness for the micro-benchmarks in the bench/ directory.
+ * Each benchmark file registers its cases with a Bench::Register object;
+ * bench.cpp runs the registered cases and prints every timing as JSON.
+*/
+
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <functional>
+#include <streambuf>
+
+#include "../src/todolist.h"
+
+namespace Bench {
+
+using Clock = std::chrono::steady_clock;
+
+// Settings and results shared by every case in a run
+class Run {
+  unsigned long maxTasks;
+  Json results;
+
+public:
+  explicit Run(unsigned long maxTasks);
+
+  // The database sizes (in tasks) to run size-dependent cases at
+  std::vector<unsigned long> sizes(unsigned long from = 1000) const;
+
+  /*
+   * Time a function over a number of repetitions and record the median and
+   * percentile timings. 'items' is the amount of work done per call (e.g.
+   * the number of tasks scanned) and is used to report a throughput.
+   * Returns the median, in nanoseconds.
+   */
+  double time(const String &name, const Json &params, unsigned long items,
+            unsigned int repetitions, const std::function<void()> &fn);
+
+  // Record values measured by the case itself, such as counters
+  void record(const String &name, const Json &params, const Json &values);
+
+  const Json &report() const noexcept;
+};
+
+using Case = std::function<void(Run &)>;
+
+// Registers a benchmark case under a name when constructed
+struct Register {
+  Register(const String &name, Case fn);
+};
+
+std::vector<std::pair<String, Case>> &registry();
+
+// Build a TodoList of the given size with a realistic spread of projects,
+// tags, due dates and completed tasks.
+TodoList generate(unsigned long tasks, unsigned int tasksPerProject = 100,
+                  unsigned int tagsPerTask = 3);
+
+// A stream buffer that throws away what is written to it, so that only the
+// cost of producing output is measured
+class DiscardBuffer : public std::streambuf {
+protected:
+  std::streamsize xsputn(const char *, std::streamsize count) override { return count; }
+  int overflow(int c) override { return c; }
+};
+
+// Keep the optimiser from discarding a computed value
+template <typename T> inline void keep(const T &value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // namespace Bench
+
+#endif // BENCH_H
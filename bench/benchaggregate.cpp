@@ -0,0 +1,27 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for the aggregate action, reporting the scan
+ * throughput for an increasing number of threads.
+*/
+
+
+#include <thread>
+
+#include "bench.h"
+#include "../src/aggregation.h"
+
+static Bench::Register aggregateThreads("aggregate/threads", [](Bench::Run &run) {
+  const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+
+  for (unsigned long tasks : run.sizes(10000)) {
+    TodoList tl = Bench::generate(tasks);
+    for (const String spec : {"project", "tag,completed", "month"}) {
+      Aggregation aggregation(spec);
+      for (unsigned int threads = 1; threads <= cores; threads *= 2) {
+        run.time("aggregate/threads", {{"tasks", tasks}, {"by", spec}, {"threads", threads}},
+                 tasks, 5, [&]() { Bench::keep(aggregation.run(tl, threads)); });
+      }
+    }
+  }
+});
@@ -0,0 +1,19 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file builds all the benchmarks.
+*/
+
+#include "benchaggregate.cpp"
+#include "benchsearch.cpp"
+#include "benchcomplete.cpp"
+#include "benchthreadpool.cpp"
+#include "benchwrite.cpp"
+#include "benchserver.cpp"
+#include "benchreplica.cpp"
+#include "benchjson.cpp"
+#include "benchexport.cpp"
+#include "benchescape.cpp"
+#include "benchparse.cpp"
+#include "benchdate.cpp"
+#include "benchcore.cpp"
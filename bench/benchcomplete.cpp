@@ -0,0 +1,48 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for completing identifiers from the Completions
+ * file saved next to a database.
+*/
+
+
+#include <cstdio>
+
+#include "bench.h"
+#include "../src/prefixindex.h"
+
+static Bench::Register completeLookup("complete/lookup", [](Bench::Run &run) {
+  const String db = "bench-complete.json";
+
+  for (unsigned long tasks : run.sizes()) {
+    TodoList tl = Bench::generate(tasks);
+    tl.save(db);
+
+    run.time("complete/build", {{"tasks", tasks}}, tasks, 3, [&]() {
+      Completions completions;
+      completions.build(tl);
+      completions.save(db, tl.getGeneration());
+    });
+
+    // Includes mapping the file, as each complete action has to
+    run.time("complete/project", {{"tasks", tasks}}, 0, 50, [&]() {
+      Completions completions;
+      completions.load(db);
+      Bench::keep(completions.projectIdents("Module 4", 10));
+    });
+    run.time("complete/task", {{"tasks", tasks}}, 0, 50, [&]() {
+      Completions completions;
+      completions.load(db);
+      Bench::keep(completions.taskIdents("Module 4", "Lab Assignment 9", 10));
+    });
+    run.time("complete/tag", {{"tasks", tasks}}, 0, 50, [&]() {
+      Completions completions;
+      completions.load(db);
+      Bench::keep(completions.tagNames("s", 10));
+    });
+  }
+
+  for (const String suffix : {"", ".stats", ".complete"}) {
+    std::remove((db + suffix).c_str());
+  }
+});
@@ -0,0 +1,101 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for the core of the library: loading and saving
+ * a database, finding projects and tasks by identifier, adding tasks, and
+ * adding and checking tags. Reading due dates and printing a database are
+ * timed in benchdate.cpp and benchjson.cpp.
+*/
+
+
+#include <cstdio>
+#include <random>
+
+#include "bench.h"
+
+// The number of identifiers looked up per repetition
+static const unsigned long LOOKUPS = 10000;
+
+static Bench::Register core("core/todolist", [](Bench::Run &run) {
+  const String db = "bench-core.json";
+  std::mt19937 random(1);
+
+  for (unsigned long tasks : run.sizes()) {
+    const Json params = {{"tasks", tasks}};
+    TodoList tl = Bench::generate(tasks);
+
+    run.time("core/save", params, tasks, 5, [&]() { tl.save(db); });
+    run.time("core/load", params, tasks, 5, [&]() {
+      TodoList loaded;
+      loaded.load(db);
+      Bench::keep(loaded.getProjects().size());
+    });
+
+    // Identifiers chosen up front, so that only the lookups are timed
+    std::vector<String> projectIdents;
+    for (unsigned long i = 0; i < LOOKUPS; i++) {
+      projectIdents.push_back(tl.getProjects()[random() % tl.getProjects().size()].getIdent());
+    }
+    run.time("core/getProject", params, LOOKUPS, 20, [&]() {
+      for (const String &ident : projectIdents) {
+        Bench::keep(tl.getProject(ident));
+      }
+    });
+
+    // Tasks added and found 100 to a project, as the generated databases
+    // are laid out, since a project's tasks are searched one by one
+    std::vector<String> projectNames, taskNames;
+    for (unsigned long i = 0; i < tasks; i += 100) {
+      projectNames.push_back("Module " + std::to_string(i / 100));
+    }
+    for (unsigned long i = 0; i < 100; i++) {
+      taskNames.push_back("Lab Assignment " + std::to_string(i));
+    }
+    run.time("core/newTask", params, tasks, 3, [&]() {
+      TodoList built;
+      Project *project = nullptr;
+      for (unsigned long i = 0; i < tasks; i++) {
+        if (i % 100 == 0) {
+          project = &built.newProject(projectNames[i / 100]);
+        }
+        Bench::keep(project->newTask(taskNames[i % 100]));
+      }
+    });
+
+    std::vector<std::pair<Project *, String>> lookups;
+    for (unsigned long i = 0; i < LOOKUPS; i++) {
+      const unsigned long task = random() % tasks;
+      lookups.emplace_back(&tl.getProject(projectNames[task / 100]), taskNames[task % 100]);
+    }
+    run.time("core/getTask", params, LOOKUPS, 20, [&]() {
+      for (const auto &lookup : lookups) {
+        Bench::keep(lookup.first->getTask(lookup.second));
+      }
+    });
+
+    // Free-standing copies of the tasks, each given a new tag per repetition
+    std::vector<Task> copies;
+    copies.reserve(tasks);
+    for (const Project &p : tl.getProjects()) {
+      for (const Task &task : p.getTasks()) {
+        copies.push_back(task);
+      }
+    }
+    unsigned int repetition = 0;
+    run.time("core/addTag", params, tasks, 5, [&]() {
+      const String tag = "bench " + std::to_string(repetition++);
+      for (Task &task : copies) {
+        Bench::keep(task.addTag(tag));
+      }
+    });
+    run.time("core/containsTag", params, tasks, 5, [&]() {
+      for (const Task &task : copies) {
+        Bench::keep(task.containsTag("maths"));
+      }
+    });
+  }
+
+  for (const String suffix : {"", ".stats", ".lock", ".journal", ".tmp"}) {
+    std::remove((db + suffix).c_str());
+  }
+});
@@ -0,0 +1,78 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for reading and writing due dates as YYYY-MM-DD:
+ * one at a time with setDateFromString and str(), many at once with
+ * Date::parseMany and Date::formatMany, and, as a baseline, as they were
+ * read with substr and std::stoi and written with a std::stringstream.
+*/
+
+
+#include <iomanip>
+#include <sstream>
+
+#include "bench.h"
+
+// A date read as setDateFromString read it before it read eight digits at once
+static Date stoiDate(const String &text) {
+  Date date;
+  const unsigned int year = std::stoi(text.substr(0, 4));
+  const unsigned int month = std::stoi(text.substr(5, 2));
+  const unsigned int day = std::stoi(text.substr(8, 2));
+  if (!date.checkValidDate(year, month, day)) {
+    throw std::invalid_argument("Invalid date.");
+  }
+  date.setDate(year, month, day);
+  return date;
+}
+
+static Bench::Register date("date/codec", [](Bench::Run &run) {
+  for (unsigned long count : run.sizes()) {
+    std::vector<Date> dates(count);
+    for (unsigned long i = 0; i < count; i++) {
+      dates[i].setDate(1970 + i % 80, 1 + i % 12, 1 + i % 28);
+    }
+    std::vector<String> texts;
+    Date::formatMany(dates, texts);
+    const Json params = {{"dates", count}};
+
+    run.time("date/parse-stoi", params, count, 5, [&]() {
+      for (const String &text : texts) {
+        Bench::keep(stoiDate(text));
+      }
+    });
+
+    run.time("date/parse-string", params, count, 5, [&]() {
+      Date date;
+      for (const String &text : texts) {
+        date.setDateFromString(text);
+        Bench::keep(date);
+      }
+    });
+
+    std::vector<Date> parsed;
+    run.time("date/parse-many", params, count, 5,
+             [&]() { Bench::keep(Date::parseMany(texts, parsed)); });
+
+    run.time("date/format-stream", params, count, 5, [&]() {
+      for (const Date &date : dates) {
+        std::stringstream s;
+        s << std::setfill('0') << std::setw(4) << date.getYear() << '-' << std::setw(2)
+          << date.getMonth() << '-' << std::setw(2) << date.getDay();
+        Bench::keep(s.str().size());
+      }
+    });
+
+    run.time("date/format-str", params, count, 5, [&]() {
+      for (const Date &date : dates) {
+        Bench::keep(date.str().size());
+      }
+    });
+
+    std::vector<String> formatted;
+    run.time("date/format-many", params, count, 5, [&]() {
+      Date::formatMany(dates, formatted);
+      Bench::keep(formatted.size());
+    });
+  }
+});
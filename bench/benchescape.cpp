@@ -0,0 +1,68 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for escaping strings in JSON output with each
+ * escaper the CPU supports: printing a tag-heavy database with a
+ * JsonWriter and with str(), and escaping long strings on their own.
+*/
+
+
+#include <ostream>
+
+#include "bench.h"
+#include "../src/jsonwriter.h"
+
+static Bench::Register escape("json/escape", [](Bench::Run &run) {
+  Bench::DiscardBuffer discard;
+  std::ostream out(&discard);
+  const Simd::Level original = JsonWriter::getEscaper();
+
+  // Long strings, clean or with a quote every 64 bytes
+  String clean(1 << 20, 'x');
+  String quoted = clean;
+  for (std::size_t i = 63; i < quoted.size(); i += 64) {
+    quoted[i] = '"';
+  }
+
+  for (const Simd::Level escaper : {Simd::SCALAR, Simd::SSE2, Simd::AVX2}) {
+    if (!JsonWriter::setEscaper(escaper)) {
+      continue;
+    }
+    const char *name = Simd::name(escaper);
+
+    for (const String *s : {&clean, &quoted}) {
+      const Json params = {{"escaper", name}, {"quotes", s == &quoted}};
+      String escaped;
+      escaped.reserve(2 * s->size());
+      run.time("escape/string", params, s->size(), 20, [&]() {
+        escaped.clear();
+        JsonWriter::appendEscaped(escaped, *s);
+        Bench::keep(escaped.size());
+      });
+    }
+
+    for (unsigned long tasks : run.sizes()) {
+      // 12 tags per task, one in ten of them with a quote
+      TodoList tl = Bench::generate(tasks, 100, 12);
+      unsigned long i = 0;
+      for (const Project &project : tl.getProjects()) {
+        Project &changed = tl.getProject(project.getIdent());
+        for (const Task &task : project.getTasks()) {
+          if (i++ % 10 == 0) {
+            changed.getTask(task.getIdent()).addTag("a \"quoted\" tag");
+          }
+        }
+      }
+      const Json params = {{"escaper", name}, {"tasks", tasks}};
+
+      run.time("escape/writer-tags", params, tasks, 5, [&]() {
+        JsonWriter writer(out, JsonWriter::COMPACT);
+        tl.write(writer);
+      });
+
+      run.time("escape/str-tags", params, tasks, 5, [&]() { out << tl.str(); });
+    }
+  }
+
+  JsonWriter::setEscaper(original);
+});
@@ -0,0 +1,69 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for the export action: exporting a database as
+ * NDJSON straight from the file, against loading it first, and how long
+ * the first line takes to appear, and exporting it as an Arrow file.
+*/
+
+
+#include <cstdio>
+#include <ostream>
+
+#include "bench.h"
+#include "../src/exporter.h"
+
+// Remembers when the first task was handed to it
+class FirstTask : public Exporter {
+public:
+  Bench::Clock::time_point at;
+  bool seen = false;
+
+  void task(const String &, const Task &) override {
+    if (!seen) {
+      at = Bench::Clock::now();
+      seen = true;
+    }
+  }
+};
+
+static Bench::Register exportNdjson("export/ndjson", [](Bench::Run &run) {
+  const String db = "bench-export.json";
+  Bench::DiscardBuffer discard;
+  std::ostream out(&discard);
+
+  for (unsigned long tasks : run.sizes()) {
+    Bench::generate(tasks).save(db);
+    const Json params = {{"tasks", tasks}};
+
+    run.time("export/ndjson-file", params, tasks, 5, [&]() {
+      NdjsonExporter exporter(out);
+      exporter.exportFile(db);
+      exporter.finish();
+    });
+
+    run.time("export/ndjson-loaded", params, tasks, 5, [&]() {
+      TodoList tl;
+      tl.load(db);
+      NdjsonExporter exporter(out);
+      exporter.exportTodoList(tl);
+      exporter.finish();
+    });
+
+    run.time("export/arrow-file", params, tasks, 5, [&]() {
+      ArrowExporter exporter(out);
+      exporter.exportFile(db);
+      exporter.finish();
+    });
+
+    FirstTask first;
+    const Bench::Clock::time_point start = Bench::Clock::now();
+    first.exportFile(db);
+    run.record("export/first-task", params,
+               {{"file_ns", std::chrono::duration<double, std::nano>(first.at - start).count()}});
+  }
+
+  for (const String suffix : {"", ".stats", ".lock"}) {
+    std::remove((db + suffix).c_str());
+  }
+});
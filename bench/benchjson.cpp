@@ -0,0 +1,128 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for printing a whole database as JSON: streamed
+ * with a JsonWriter, compact and pretty, against building the Json
+ * representation and dumping it, and against the str() functions.
+ * Compact output reuses the JSON each project kept from the last print,
+ * so it is also timed after changing one task, and one task in every
+ * project, between prints.
+ * The json action prints a database that is not in memory as it is read,
+ * so printing one from its file is timed against loading it first, along
+ * with how long the first bytes take to be printed.
+*/
+
+
+#include <cstdio>
+#include <ostream>
+
+#include "bench.h"
+#include "../src/exporter.h"
+#include "../src/jsonwriter.h"
+
+// Throws away what is written to it, remembering when it was first written to
+class FirstByteBuffer : public Bench::DiscardBuffer {
+public:
+  Bench::Clock::time_point at;
+  bool written = false;
+
+protected:
+  std::streamsize xsputn(const char *s, std::streamsize count) override {
+    if (!written) {
+      at = Bench::Clock::now();
+      written = true;
+    }
+    return Bench::DiscardBuffer::xsputn(s, count);
+  }
+};
+
+static Bench::Register json("json/print", [](Bench::Run &run) {
+  Bench::DiscardBuffer discard;
+  std::ostream out(&discard);
+
+  for (unsigned long tasks : run.sizes()) {
+    TodoList tl = Bench::generate(tasks);
+    const Json params = {{"tasks", tasks}};
+
+    run.time("json/writer-compact", params, tasks, 5, [&]() {
+      JsonWriter writer(out, JsonWriter::COMPACT);
+      tl.write(writer);
+    });
+
+    // A task in the first project, or in every project, changes between prints
+    bool completed = false;
+    run.time("json/writer-compact-one-changed", params, tasks, 5, [&]() {
+      Project &project = tl.getProject(tl.getProjects().front().getIdent());
+      project.begin()->setComplete(completed = !completed);
+      JsonWriter writer(out, JsonWriter::COMPACT);
+      tl.write(writer);
+    });
+
+    run.time("json/writer-compact-all-changed", params, tasks, 5, [&]() {
+      completed = !completed;
+      for (const Project &p : tl.getProjects()) {
+        tl.getProject(p.getIdent()).begin()->setComplete(completed);
+      }
+      JsonWriter writer(out, JsonWriter::COMPACT);
+      tl.write(writer);
+    });
+
+    run.time("json/writer-pretty", params, tasks, 5, [&]() {
+      JsonWriter writer(out, JsonWriter::PRETTY);
+      tl.write(writer);
+    });
+
+    run.time("json/dump", params, tasks, 5, [&]() { out << tl.json().dump(); });
+
+    run.time("json/str", params, tasks, 5, [&]() { out << tl.str(); });
+  }
+});
+
+static Bench::Register jsonFile("json/file", [](Bench::Run &run) {
+  const String db = "bench-json.json";
+  Bench::DiscardBuffer discard;
+  std::ostream out(&discard);
+
+  for (unsigned long tasks : run.sizes()) {
+    Bench::generate(tasks).save(db);
+    const Json params = {{"tasks", tasks}};
+
+    run.time("json/file-stream", params, tasks, 5, [&]() {
+      JsonExporter exporter(out, JsonWriter::COMPACT);
+      exporter.exportFileInOrder(db);
+      exporter.finish();
+    });
+
+    run.time("json/file-loaded", params, tasks, 5, [&]() {
+      TodoList tl;
+      tl.load(db);
+      JsonWriter writer(out, JsonWriter::COMPACT);
+      tl.write(writer);
+    });
+
+    // How long until the first buffer of output is printed
+    Json firstByte = Json::object();
+    for (const bool stream : {true, false}) {
+      FirstByteBuffer buffer;
+      std::ostream timed(&buffer);
+      const Bench::Clock::time_point start = Bench::Clock::now();
+      if (stream) {
+        JsonExporter exporter(timed, JsonWriter::COMPACT);
+        exporter.exportFileInOrder(db);
+        exporter.finish();
+      } else {
+        TodoList tl;
+        tl.load(db);
+        JsonWriter writer(timed, JsonWriter::COMPACT);
+        tl.write(writer);
+      }
+      firstByte[stream ? "stream_ns" : "loaded_ns"] =
+          std::chrono::duration<double, std::nano>(buffer.at - start).count();
+    }
+    run.record("json/first-byte", params, firstByte);
+  }
+
+  for (const String suffix : {"", ".stats", ".lock"}) {
+    std::remove((db + suffix).c_str());
+  }
+});
@@ -0,0 +1,98 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for reading a database: parsing its text with
+ * nlohmann::json against the TodoParser (and its first stage on its own)
+ * with each indexer the CPU supports, and loading it from a file. Reading
+ * the file and then parsing it is compared with parsing it as a FileReader
+ * reads it, which should take about as long as the slower of the two. The
+ * throughput of each is recorded in GB/s under parse/throughput.
+*/
+
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "bench.h"
+#include "../src/filereader.h"
+#include "../src/todoparser.h"
+
+static Bench::Register parse("parse/database", [](Bench::Run &run) {
+  const String db = "bench-parse.json";
+  const Simd::Level original = TodoParser::getIndexer();
+
+  for (unsigned long tasks : run.sizes()) {
+    Bench::generate(tasks).save(db);
+    std::stringstream buffer;
+    buffer << std::ifstream(db, std::ios::binary).rdbuf();
+    const String text = buffer.str();
+    const unsigned long bytes = text.size();
+    Json throughput = Json::object();
+
+    // GB/s from the median time of a case over the whole text
+    auto gbPerSecond = [bytes](double ns) { return bytes / ns; };
+
+    throughput["nlohmann"] = gbPerSecond(
+        run.time("parse/nlohmann", {{"tasks", tasks}}, bytes, 5,
+                 [&]() { Bench::keep(Json::parse(text).size()); }));
+
+    for (const Simd::Level level : {Simd::SCALAR, Simd::SSE2, Simd::AVX2}) {
+      if (!TodoParser::setIndexer(level)) {
+        continue;
+      }
+      const Json params = {{"tasks", tasks}, {"indexer", Simd::name(level)}};
+      std::vector<std::uint32_t> indexes;
+      throughput[String("index-") + Simd::name(level)] = gbPerSecond(
+          run.time("parse/index", params, bytes, 5,
+                   [&]() { Bench::keep(TodoParser::index(text, indexes)); }));
+
+      std::vector<TodoParser::ParsedProject> projects;
+      throughput[String("todoparser-") + Simd::name(level)] = gbPerSecond(
+          run.time("parse/todoparser", params, bytes, 5,
+                   [&]() { Bench::keep(TodoParser::parse(text, projects)); }));
+    }
+    TodoParser::setIndexer(original);
+
+    // The file on its own, then read and parsed one after the other, and
+    // parsed as it is read
+    const char *data;
+    std::size_t length;
+    throughput["read"] = gbPerSecond(run.time("parse/read", {{"tasks", tasks}}, bytes, 5, [&]() {
+      FileReader reader(db);
+      while (reader.next(data, length)) {
+        Bench::keep(data[0]);
+      }
+    }));
+    throughput["read-then-parse"] = gbPerSecond(
+        run.time("parse/read-then-parse", {{"tasks", tasks}}, bytes, 5, [&]() {
+          std::ifstream file(db, std::ios::binary);
+          String whole(bytes, '\0');
+          file.read(&whole[0], whole.size());
+          std::vector<TodoParser::ParsedProject> projects;
+          Bench::keep(TodoParser::parse(whole, projects));
+        }));
+    throughput["pipelined"] = gbPerSecond(
+        run.time("parse/pipelined", {{"tasks", tasks}}, bytes, 5, [&]() {
+          FileReader reader(db);
+          TodoParser parser(reader.size());
+          while (reader.next(data, length)) {
+            parser.feed(data, length);
+          }
+          std::vector<TodoParser::ParsedProject> projects;
+          Bench::keep(parser.finish(projects));
+        }));
+
+    throughput["load"] = gbPerSecond(run.time("parse/load", {{"tasks", tasks}}, bytes, 5, [&]() {
+      TodoList tl;
+      tl.load(db);
+      Bench::keep(tl.getProjects().size());
+    }));
+
+    run.record("parse/throughput", {{"tasks", tasks}, {"bytes", bytes}}, throughput);
+  }
+
+  for (const String suffix : {"", ".stats", ".lock", ".journal"}) {
+    std::remove((db + suffix).c_str());
+  }
+});
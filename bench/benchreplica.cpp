@@ -0,0 +1,59 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for keeping a copy of a database up to date:
+ * applying a save's worth of changes from the journal with a Replica,
+ * against loading the whole database again.
+*/
+
+
+#include <algorithm>
+#include <cstdio>
+
+#include "bench.h"
+#include "../src/replica.h"
+
+static Bench::Register replica("replica/catch-up", [](Bench::Run &run) {
+  const String db = "bench-replica.json";
+  const unsigned int changes = 100;
+  const unsigned int rounds = 5;
+
+  for (unsigned long tasks : run.sizes()) {
+    std::remove(ChangeFeed::journalPath(db).c_str());
+    Bench::generate(tasks).save(db);
+    const Json params = {{"tasks", tasks}, {"changes", changes}};
+
+    run.time("replica/reload", params, tasks, 5, [&]() {
+      TodoList tl;
+      tl.load(db);
+      Bench::keep(tl);
+    });
+
+    TodoList primary, copy;
+    primary.load(db);
+    copy.load(db);
+    Replica follower(db);
+
+    // Each round saves a batch of changes, then times applying it
+    std::vector<double> times;
+    for (unsigned int round = 0; round < rounds; round++) {
+      Project &project = primary.newProject("Round " + std::to_string(round));
+      for (unsigned int i = 0; i < changes - 1; i++) {
+        project.newTask("Task " + std::to_string(i));
+      }
+      primary.save(db);
+
+      const Bench::Clock::time_point start = Bench::Clock::now();
+      follower.poll(copy);
+      times.push_back(std::chrono::duration<double, std::nano>(Bench::Clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    run.record("replica/apply", params,
+               {{"median_ns", times[times.size() / 2]},
+                {"reloads", follower.status(copy)["reloads"]}});
+  }
+
+  for (const String suffix : {"", ".stats", ".journal", ".lock"}) {
+    std::remove((db + suffix).c_str());
+  }
+});
@@ -0,0 +1,36 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for searching identifiers with the trigram index,
+ * against a scan over every task.
+*/
+
+
+#include "bench.h"
+
+static Bench::Register searchIndex("search/index", [](Bench::Run &run) {
+  for (unsigned long tasks : run.sizes()) {
+    TodoList tl = Bench::generate(tasks);
+
+    run.time("search/build", {{"tasks", tasks}}, tasks, 3, [&]() {
+      TodoList copy = tl;
+      Bench::keep(copy.search("x"));
+    });
+
+    tl.search("warm up");
+    for (const String word : {"Assignment 42", "Module 7", "no such task"}) {
+      run.time("search/index", {{"tasks", tasks}, {"word", word}}, 0, 25,
+               [&]() { Bench::keep(tl.search(word)); });
+
+      run.time("search/scan", {{"tasks", tasks}, {"word", word}}, tasks, 5, [&]() {
+        unsigned long found = 0;
+        for (const Project &project : tl.getProjects()) {
+          for (const Task &task : project.getTasks()) {
+            found += task.getIdent().find(word) != String::npos;
+          }
+        }
+        Bench::keep(found);
+      });
+    }
+  }
+});
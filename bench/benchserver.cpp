@@ -0,0 +1,68 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for the commands answered by a Server: one at a
+ * time on a connection each (as the todo command sends them), one at a
+ * time on a single connection, and many in flight on a single connection.
+*/
+
+
+#include <cstdio>
+#include <thread>
+
+#include "bench.h"
+#include "../src/server.h"
+
+#ifndef _WIN32
+
+static Bench::Register server("server/requests", [](Bench::Run &run) {
+  const String db = "bench-server.json";
+  Bench::generate(10000).save(db);
+  const std::vector<String> command = {"todo", "--db", db, "--action", "json",
+                                       "--project", "Module 7", "--task",
+                                       "Lab Assignment 3"};
+  const unsigned int requests = 1000;
+
+  {
+    Server server(db);
+    std::thread thread([&]() { server.run(); });
+
+    run.time("server/connection-per-request", {{"requests", requests}}, requests, 5, [&]() {
+      std::vector<const char *> argv;
+      for (const String &argument : command) {
+        argv.push_back(argument.c_str());
+      }
+      std::ostringstream out, err;
+      int status;
+      for (unsigned int i = 0; i < requests; i++) {
+        Server::forward(db, argv.size(), argv.data(), out, err, status);
+      }
+    });
+
+    for (unsigned int inFlight : {1u, 10u, 100u}) {
+      run.time("server/pipelined", {{"requests", requests}, {"in_flight", inFlight}},
+               requests, 5, [&]() {
+        Server::Client client(db);
+        int status;
+        String out, err;
+        for (unsigned int i = 0; i < requests; i += inFlight) {
+          for (unsigned int j = 0; j < inFlight; j++) {
+            client.send(command);
+          }
+          for (unsigned int j = 0; j < inFlight; j++) {
+            client.receive(status, out, err);
+          }
+        }
+      });
+    }
+
+    server.stop();
+    thread.join();
+  }
+
+  for (const String suffix : {"", ".stats", ".lock"}) {
+    std::remove((db + suffix).c_str());
+  }
+});
+
+#endif // _WIN32
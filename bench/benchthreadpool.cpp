@@ -0,0 +1,56 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for loading and saving a database with the shared
+ * ThreadPool, recording how busy each worker was so that the scaling can be
+ * checked against the number of cores.
+*/
+
+
+#include <cstdio>
+
+#include "bench.h"
+#include "../src/threadpool.h"
+
+// Record the share of a run each worker spent running tasks
+static void recordUtilisation(Bench::Run &run, const String &name, const Json &params,
+                              Bench::Clock::duration elapsed) {
+  const double total = std::chrono::duration<double, std::nano>(elapsed).count();
+  Json workers = Json::array();
+  for (const WorkerStats &worker : ThreadPool::shared().stats()) {
+    workers.push_back({{"tasks", worker.tasks},
+                       {"steals", worker.steals},
+                       {"busy", total > 0 ? worker.busyNanoseconds / total : 0}});
+  }
+  run.record(name, params, {{"workers", workers}});
+}
+
+static Bench::Register threadPool("threadpool/load-save", [](Bench::Run &run) {
+  const String db = "bench-threadpool.json";
+  ThreadPool &pool = ThreadPool::shared();
+
+  for (unsigned long tasks : run.sizes()) {
+    Bench::generate(tasks).save(db);
+    const Json params = {{"tasks", tasks}, {"threads", pool.size()}};
+
+    pool.resetStats();
+    Bench::Clock::time_point start = Bench::Clock::now();
+    run.time("threadpool/load", params, tasks, 5, [&]() {
+      TodoList tl;
+      tl.load(db);
+      Bench::keep(tl);
+    });
+    recordUtilisation(run, "threadpool/load-utilisation", params, Bench::Clock::now() - start);
+
+    TodoList tl;
+    tl.load(db);
+    pool.resetStats();
+    start = Bench::Clock::now();
+    run.time("threadpool/save", params, tasks, 5, [&]() { tl.save(db); });
+    recordUtilisation(run, "threadpool/save-utilisation", params, Bench::Clock::now() - start);
+  }
+
+  for (const String suffix : {"", ".stats", ".lock"}) {
+    std::remove((db + suffix).c_str());
+  }
+});
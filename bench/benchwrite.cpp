@@ -0,0 +1,62 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: Benchmarks for the WriteQueue backends: the time a caller is
+ * held up queueing a write, and the time until the write is on disk, for
+ * whole databases and for journal-sized appends.
+*/
+
+
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "../src/writequeue.h"
+
+static Bench::Register writeQueue("write/backends", [](Bench::Run &run) {
+  const String path = "bench-write.json";
+
+  std::vector<std::pair<String, WriteQueue::Backend>> backends = {
+      {"blocking", WriteQueue::BLOCKING}};
+  if (WriteQueue().getBackend() == WriteQueue::URING) {
+    backends.emplace_back("io_uring", WriteQueue::URING);
+  }
+
+  for (const auto &backend : backends) {
+    WriteQueue queue(backend.second);
+
+    for (unsigned long tasks : run.sizes()) {
+      const String data = Bench::generate(tasks).json().dump() + "\n";
+      const Json params = {{"backend", backend.first}, {"tasks", tasks}};
+      const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+      run.time("write/database", params, tasks, 10, [&]() {
+        queue.wait(queue.write(fd, data, 0, true));
+      });
+
+      // The part of a save the caller waits for when it does not need the
+      // data on disk before going on
+      WriteQueue::Ticket ticket = 0;
+      run.time("write/database-submit", params, tasks, 10, [&]() {
+        ticket = queue.write(fd, data, 0, true);
+      });
+      queue.drain();
+      Bench::keep(ticket);
+      close(fd);
+    }
+
+    const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    const String line = "{\"sequence\":1,\"action\":\"create\",\"project\":\"Module 1\"}\n";
+    run.time("write/append-sync", {{"backend", backend.first}}, 1, 200, [&]() {
+      queue.wait(queue.write(fd, line, -1, true));
+    });
+    run.time("write/append-submit", {{"backend", backend.first}}, 1, 200, [&]() {
+      queue.write(fd, line, -1, true);
+    });
+    queue.drain();
+    close(fd);
+  }
+
+  std::remove(path.c_str());
+});
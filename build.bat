@@ -3,9 +3,11 @@
 SET bin_dir=bin
 SET src_dir=src
 SET tests_dir=tests
-SET source_files=%src_dir%\todo.cpp %src_dir%\todolist.cpp %src_dir%\project.cpp %src_dir%\task.cpp %src_dir%\date.cpp
+SET bench_dir=bench
+SET source_files=%src_dir%\todo.cpp %src_dir%\todolist.cpp %src_dir%\project.cpp %src_dir%\task.cpp %src_dir%\date.cpp %src_dir%\stats.cpp %src_dir%\aggregation.cpp %src_dir%\searchindex.cpp %src_dir%\prefixindex.cpp %src_dir%\session.cpp %src_dir%\server.cpp %src_dir%\filelock.cpp %src_dir%\threadpool.cpp %src_dir%\writequeue.cpp %src_dir%\changefeed.cpp %src_dir%\replica.cpp %src_dir%\jsonwriter.cpp %src_dir%\exporter.cpp %src_dir%\flatbuffer.cpp %src_dir%\simd.cpp %src_dir%\todoparser.cpp %src_dir%\filereader.cpp %src_dir%\snapshot.cpp
 SET main_file=%src_dir%\main.cpp
 SET executable=%bin_dir%\todo.exe
+SET cxxflags=--std=c++14 -pedantic -Wall -pthread
 
 IF "%1"=="" GOTO compile
 
@@ -21,9 +23,20 @@ IF %testStr%==test (
   )
 )
 
+SET benchStr=%1%
+SET benchStr=%benchStr:~0,5%
+SET benchName=%1%
+IF "%1"=="bench" SET benchName=benchall
+IF %benchStr%==bench (
+  SET source_files=%source_files% %bench_dir%\%benchName%.cpp
+  SET main_file=%bench_dir%\bench.cpp
+  SET executable=%bin_dir%\todo-bench.exe
+  SET cxxflags=%cxxflags% -O2
+)
+
 :compile
 IF NOT EXIST %bin_dir% MKDIR %bin_dir%
 IF EXIST %executable% DEL %executable%
-g++ --std=c++14 -pedantic -Wall %source_files% %main_file% -o %executable%
+g++ %cxxflags% %source_files% %main_file% -o %executable%
 
 :end
@@ -5,15 +5,17 @@
 BIN_DIR="bin"
 SRC_DIR="src"
 TESTS_DIR="tests"
-SOURCE_FILES="${SRC_DIR}/todo.cpp ${SRC_DIR}/todolist.cpp ${SRC_DIR}/project.cpp ${SRC_DIR}/task.cpp ${SRC_DIR}/date.cpp"
+BENCH_DIR="bench"
+SOURCE_FILES="${SRC_DIR}/todo.cpp ${SRC_DIR}/todolist.cpp ${SRC_DIR}/project.cpp ${SRC_DIR}/task.cpp ${SRC_DIR}/date.cpp ${SRC_DIR}/stats.cpp ${SRC_DIR}/aggregation.cpp ${SRC_DIR}/searchindex.cpp ${SRC_DIR}/prefixindex.cpp ${SRC_DIR}/session.cpp ${SRC_DIR}/server.cpp ${SRC_DIR}/filelock.cpp ${SRC_DIR}/threadpool.cpp ${SRC_DIR}/writequeue.cpp ${SRC_DIR}/changefeed.cpp ${SRC_DIR}/replica.cpp ${SRC_DIR}/jsonwriter.cpp ${SRC_DIR}/exporter.cpp ${SRC_DIR}/flatbuffer.cpp ${SRC_DIR}/simd.cpp ${SRC_DIR}/todoparser.cpp ${SRC_DIR}/filereader.cpp ${SRC_DIR}/snapshot.cpp"
 MAIN_FILE="${SRC_DIR}/main.cpp"
 EXECUTABLE="./${BIN_DIR}/todo"
+CXXFLAGS="--std=c++14 -pedantic -Wall -pthread"
 
 set -x
 cd "${0%/*}"
 
 if [ $# -gt 1 ]; then
-  echo "Unknown arguments!" "Only one argument accepted, and must begin with test"
+  echo "Unknown arguments!" "Only one argument accepted, and must begin with test or bench"
   exit
 elif [ $# -eq 1 ]; then
   if [[ $1 == test* ]]; then
@@ -25,9 +27,18 @@ elif [ $# -eq 1 ]; then
     if [ ! -f ./${BIN_DIR}/catch.o ]; then
       g++ --std=c++14 -c ./src/lib_catch_main.cpp -o ${MAIN_FILE}
     fi
+  elif [[ $1 == bench* ]]; then
+    BENCH_NAME=$1
+    if [ "$1" == "bench" ]; then
+      BENCH_NAME="benchall"
+    fi
+    SOURCE_FILES="${SOURCE_FILES} ./${BENCH_DIR}/${BENCH_NAME}.cpp"
+    MAIN_FILE="./${BENCH_DIR}/bench.cpp"
+    EXECUTABLE="./${BIN_DIR}/todo-bench"
+    CXXFLAGS="${CXXFLAGS} -O2"
   fi
 fi
 
 mkdir -p ${BIN_DIR}
 rm ${EXECUTABLE} 2> /dev/null
-g++ --std=c++14 -pedantic -Wall  ${SOURCE_FILES} ${MAIN_FILE} -o ${EXECUTABLE}
\ No newline at end of file
+g++ ${CXXFLAGS} ${SOURCE_FILES} ${MAIN_FILE} -o ${EXECUTABLE}
\ No newline at end of file
@@ -0,0 +1,263 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the Aggregation class.
+*/
+
+
+#include "aggregation.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <sstream>
+
+
+// The most characters a project identifier can be cut to
+static const std::size_t MAX_PREFIX_LENGTH = 999999999;
+
+// Smallest number of tasks handed to a thread in one go
+static const std::size_t MIN_CHUNK_SIZE = 1024;
+
+
+/*
+    * Constructor to create an Aggregation from a comma separated list of
+    * dimensions: 'project', 'project:N' (the first N characters of the
+    * project identifier, N from 1 to 999999999), 'tag', 'year', 'month' and
+    * 'completed'.
+    * @param spec: The list of dimensions
+    * @throws std::invalid_argument: If a dimension is not recognised, or N is
+    * out of range
+*/
+Aggregation::Aggregation(const String &spec) {
+    std::stringstream stringStream(spec);
+    String name;
+    while (std::getline(stringStream, name, ',')) {
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        if (name == "project") {
+            dimensions.emplace_back(PROJECT, 0);
+        } else if (name.compare(0, 8, "project:") == 0 && name.size() > 8 && name.size() <= 17 &&
+                   name.find_first_not_of("0123456789", 8) == String::npos) {
+            const std::size_t length = std::stoul(name.substr(8));
+            if (length == 0 || length > MAX_PREFIX_LENGTH) {
+                throw std::invalid_argument("by");
+            }
+            dimensions.emplace_back(PROJECT_PREFIX, static_cast<unsigned int>(length));
+        } else if (name == "tag") {
+            dimensions.emplace_back(TAG, 0);
+        } else if (name == "year") {
+            dimensions.emplace_back(YEAR, 0);
+        } else if (name == "month") {
+            dimensions.emplace_back(MONTH, 0);
+        } else if (name == "completed") {
+            dimensions.emplace_back(COMPLETED, 0);
+        } else {
+            throw std::invalid_argument("by");
+        }
+    }
+    if (dimensions.empty()) {
+        throw std::invalid_argument("by");
+    }
+}
+
+// Function to combine the hashes of the values of a group
+std::size_t Aggregation::KeyHash::operator()(const Key &key) const noexcept {
+    std::size_t hash = key.size();
+    for (const Value &value : key) {
+        const std::size_t h = value.first ? std::hash<String>()(value.second) : 0x9e3779b9;
+        hash ^= h + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+// Returns the first characters of a UTF-8 string, never splitting a
+// character in two
+static String prefix(const String &s, std::size_t characters) {
+    std::size_t end = 0;
+    for (; end < s.size(); end++) {
+        // Each character starts with a byte that is not 10xxxxxx
+        if ((static_cast<unsigned char>(s[end]) & 0xc0) != 0x80) {
+            if (characters == 0) {
+                break;
+            }
+            characters--;
+        }
+    }
+    return s.substr(0, end);
+}
+
+/*
+    * Function to count a task in every group it belongs to
+    * @param project: The project containing the task
+    * @param task: The task to count
+    * @param key: The values of the dimensions before the next one
+    * @param counts: The counts to add the task to
+*/
+void Aggregation::count(const Project &project, const Task &task, Key &key,
+                        Counts &counts) const {
+    const std::size_t dimension = key.size();
+    if (dimension == dimensions.size()) {
+        counts[key]++;
+        return;
+    }
+
+    const Date dueDate = task.getDueDate();
+    char buffer[8];
+
+    switch (dimensions[dimension].first) {
+        case PROJECT:
+            key.emplace_back(true, project.getIdent());
+            break;
+        case PROJECT_PREFIX:
+            key.emplace_back(true, prefix(project.getIdent(), dimensions[dimension].second));
+            break;
+        case TAG: {
+            const TagContainer &tags = task.getTags();
+            if (tags.empty()) {
+                key.emplace_back(false, String());
+                break;
+            }
+            // Count the task once for each of its tags
+            for (const String &tag : tags) {
+                key.emplace_back(true, tag);
+                count(project, task, key, counts);
+                key.pop_back();
+            }
+            return;
+        }
+        case YEAR:
+            if (dueDate.isInitialised()) {
+                std::snprintf(buffer, sizeof(buffer), "%04u", dueDate.getYear() % 10000);
+                key.emplace_back(true, buffer);
+            } else {
+                key.emplace_back(false, String());
+            }
+            break;
+        case MONTH:
+            if (dueDate.isInitialised()) {
+                std::snprintf(buffer, sizeof(buffer), "%04u-%02u",
+                              dueDate.getYear() % 10000, dueDate.getMonth() % 100);
+                key.emplace_back(true, buffer);
+            } else {
+                key.emplace_back(false, String());
+            }
+            break;
+        case COMPLETED:
+            key.emplace_back(true, task.completeStr());
+            break;
+    }
+    count(project, task, key, counts);
+    key.pop_back();
+}
+
+/*
+    * Function to turn a group back into a row of the result
+    * @param key: The group
+    * @param count: The number of tasks in the group
+    * @return Json: An object with a member for each dimension and the count
+*/
+Json Aggregation::row(const Key &key, unsigned long count) const {
+    Json j;
+    for (std::size_t i = 0; i < dimensions.size(); i++) {
+        const Value &value = key[i];
+
+        String name;
+        switch (dimensions[i].first) {
+            case PROJECT:
+            case PROJECT_PREFIX:
+                name = "project";
+                break;
+            case TAG:
+                name = "tag";
+                break;
+            case YEAR:
+                name = "year";
+                break;
+            case MONTH:
+                name = "month";
+                break;
+            case COMPLETED:
+                name = "completed";
+                break;
+        }
+        if (!value.first) {
+            j[name] = nullptr;
+        } else if (dimensions[i].first == YEAR) {
+            j[name] = std::stoi(value.second);
+        } else if (dimensions[i].first == COMPLETED) {
+            j[name] = value.second == "true";
+        } else {
+            j[name] = value.second;
+        }
+    }
+    j["count"] = count;
+    return j;
+}
+
+/*
+    * Function to count the tasks of a TodoList in each group. The tasks are
+    * split into chunks that are counted in parallel, each worker of a
+    * ThreadPool into its own hash table, and the tables are merged at the end.
+    * @param tl: The TodoList to aggregate
+    * @param threads: The number of threads to use, 0 to use the shared
+    * ThreadPool (one thread per core)
+    * @return Json: An array with one object per group, sorted by group
+*/
+Json Aggregation::run(const TodoList &tl, unsigned int threads) const {
+    std::unique_ptr<ThreadPool> ownPool;
+    if (threads != 0) {
+        ownPool.reset(new ThreadPool(threads));
+    }
+    ThreadPool &pool = ownPool ? *ownPool : ThreadPool::shared();
+    return run(tl, pool);
+}
+
+/*
+    * Function to count the tasks of a TodoList in each group, using a
+    * ThreadPool
+    * @param tl: The TodoList to aggregate
+    * @param pool: The ThreadPool to count with
+    * @return Json: An array with one object per group, sorted by group
+*/
+Json Aggregation::run(const TodoList &tl, ThreadPool &pool) const {
+    struct Chunk {
+        const Project *project;
+        std::size_t begin, end;
+    };
+
+    std::size_t total = tl.getStats().numTasks();
+    std::size_t chunkSize = std::max(MIN_CHUNK_SIZE, total / (pool.size() * 8) + 1);
+    std::vector<Chunk> chunks;
+    for (const Project &project : tl.getProjects()) {
+        for (std::size_t begin = 0; begin < project.size(); begin += chunkSize) {
+            chunks.push_back({&project, begin, std::min<std::size_t>(begin + chunkSize, project.size())});
+        }
+    }
+
+    std::vector<Counts> counts(pool.size());
+    pool.parallelForEach(chunks, [&](const Chunk &chunk) {
+        Key key;
+        key.reserve(dimensions.size());
+        Counts &workerCounts = counts[pool.currentWorker()];
+        const TaskContainer &tasks = chunk.project->getTasks();
+        for (std::size_t t = chunk.begin; t < chunk.end; t++) {
+            count(*chunk.project, tasks[t], key, workerCounts);
+        }
+    });
+
+    for (std::size_t id = 1; id < counts.size(); id++) {
+        for (const auto &entry : counts[id]) {
+            counts[0][entry.first] += entry.second;
+        }
+    }
+
+    std::vector<std::pair<Key, unsigned long>> groups(counts[0].begin(), counts[0].end());
+    std::sort(groups.begin(), groups.end());
+
+    Json j = Json::array();
+    for (const auto &group : groups) {
+        j.push_back(row(group.first, group.second));
+    }
+    return j;
+}
@@ -0,0 +1,53 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the Aggregation class.
+ * An Aggregation counts the tasks of a TodoList grouped along one or more
+ * dimensions, e.g. by tag and completed state, or by project and due month.
+ * A task with several tags is counted once for each of its tags.
+*/
+
+
+#ifndef AGGREGATION_H
+#define AGGREGATION_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "threadpool.h"
+#include "todolist.h"
+
+class Aggregation {
+
+    public:
+    // The dimensions tasks can be grouped by
+    enum Dimension { PROJECT, PROJECT_PREFIX, TAG, YEAR, MONTH, COMPLETED };
+
+    explicit Aggregation(const String &spec);
+    ~Aggregation() = default;
+
+    Json run(const TodoList &tl, unsigned int threads = 0) const;
+    Json run(const TodoList &tl, ThreadPool &pool) const;
+
+    private:
+    // The value of one dimension of a group: whether there is one (a task
+    // may have no tags or due date), and what it is
+    using Value = std::pair<bool, String>;
+    // A group, with the value of each dimension in order
+    using Key = std::vector<Value>;
+
+    struct KeyHash {
+        std::size_t operator()(const Key &key) const noexcept;
+    };
+    using Counts = std::unordered_map<Key, unsigned long, KeyHash>;
+
+    // Each dimension, with the prefix length for PROJECT_PREFIX
+    std::vector<std::pair<Dimension, unsigned int>> dimensions;
+
+    void count(const Project &project, const Task &task, Key &key,
+               Counts &counts) const;
+    Json row(const Key &key, unsigned long count) const;
+};
+
+#endif // AGGREGATION_H
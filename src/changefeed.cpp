@@ -0,0 +1,490 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the ChangeFeed class.
+*/
+
+
+#include "changefeed.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+
+#include "filelock.h"
+#include "jsonwriter.h"
+#include "project.h"
+#include "writequeue.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+
+// How much of the end of a journal is read to find its last line
+static const std::streamoff TAIL_SIZE = 4096;
+
+// How close together the bisection of a journal by sequence number stops,
+// and the rest is read line by line
+static const std::streamoff BISECT_SIZE = 64 * 1024;
+
+const std::streamoff ChangeFeed::MAX_JOURNAL_SIZE;
+
+// Returns the sequence number of one line of a journal, 0 if it is not a
+// whole change
+static unsigned long long sequenceOf(const Json &change) {
+    if (!change.is_object() || !change.contains("seq") || !change["seq"].is_number()) {
+        return 0;
+    }
+    return change["seq"];
+}
+
+// Write a value held in a change: an object, array, string, boolean or
+// integer, the same as Json::dump prints it
+static void writeValue(JsonWriter &writer, const Json &value) {
+    if (value.is_object()) {
+        writer.beginObject();
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            writer.key(it.key());
+            writeValue(writer, it.value());
+        }
+        writer.endObject();
+    } else if (value.is_array()) {
+        writer.beginArray();
+        for (const Json &element : value) {
+            writeValue(writer, element);
+        }
+        writer.endArray();
+    } else if (value.is_string()) {
+        writer.value(value.get_ref<const String &>());
+    } else if (value.is_boolean()) {
+        writer.value(value.get<bool>());
+    } else if (value.is_number_unsigned()) {
+        writer.number(value.get<unsigned long long>());
+    } else if (value.is_number_integer()) {
+        writer.number(value.get<long long>());
+    } else {
+        writer.null();
+    }
+}
+
+// Record a change to a project, or to a task in it
+void ChangeFeed::record(const char *op, const String &project, Json &&fields) {
+    fields["op"] = op;
+    fields["project"] = project;
+    changes.push_back(std::move(fields));
+}
+
+// Function to record that a project was added, with its tasks
+void ChangeFeed::projectCreated(const Project &project) {
+    Json value = project.json();
+    if (value.is_null()) {
+        value = Json::object();
+    }
+    record("project.created", project.getIdent(), {{"value", std::move(value)}});
+}
+
+// Function to record that a project was renamed
+void ChangeFeed::projectRenamed(const String &project, const String &to) {
+    record("project.renamed", project, {{"to", to}});
+}
+
+// Function to record that a project was deleted
+void ChangeFeed::projectDeleted(const String &project) {
+    record("project.deleted", project, Json::object());
+}
+
+// Function to record that a task was added to a project
+void ChangeFeed::taskCreated(const String &project, const Task &task) {
+    record("task.created", project, {{"task", task.getIdent()}, {"value", task.json()}});
+}
+
+// Function to record that a task was renamed
+void ChangeFeed::taskRenamed(const String &project, const String &task, const String &to) {
+    record("task.renamed", project, {{"task", task}, {"to", to}});
+}
+
+// Function to record that a task was deleted
+void ChangeFeed::taskDeleted(const String &project, const String &task) {
+    record("task.deleted", project, {{"task", task}});
+}
+
+// Function to record that a tag was added to a task
+void ChangeFeed::tagAdded(const String &project, const String &task, const String &tag) {
+    record("tag.added", project, {{"task", task}, {"tag", tag}});
+}
+
+// Function to record that a tag was removed from a task
+void ChangeFeed::tagRemoved(const String &project, const String &task, const String &tag) {
+    record("tag.removed", project, {{"task", task}, {"tag", tag}});
+}
+
+// Function to record that a task was marked completed or incomplete
+void ChangeFeed::completed(const String &project, const String &task, bool completed) {
+    record("task.completed", project, {{"task", task}, {"completed", completed}});
+}
+
+// Function to record that the due date of a task changed
+void ChangeFeed::dueDate(const String &project, const String &task, const Date &date) {
+    record("task.due", project, {{"task", task}, {"due", date.str()}});
+}
+
+// Function to replace the recorded changes with one saying that the whole
+// database has changed
+void ChangeFeed::reset() {
+    changes.clear();
+    changes.push_back({{"op", "reset"}});
+}
+
+// Function to check if no changes have been recorded
+bool ChangeFeed::empty() const noexcept {
+    return changes.empty();
+}
+
+// Function to return the number of changes recorded
+unsigned int ChangeFeed::size() const noexcept {
+    return changes.size();
+}
+
+// Function to return the changes recorded, in the order they were made
+const std::vector<Json> &ChangeFeed::recorded() const noexcept {
+    return changes;
+}
+
+// Function to forget the recorded changes, once they are in the journal
+void ChangeFeed::clear() noexcept {
+    changes.clear();
+}
+
+// Function to forget the changes recorded after the first size of them
+void ChangeFeed::truncate(unsigned int size) noexcept {
+    if (size < changes.size()) {
+        changes.resize(size);
+    }
+}
+
+// Function to forget the first size changes recorded, once they are in the
+// journal, keeping those recorded since
+void ChangeFeed::drop(unsigned int size) noexcept {
+    changes.erase(changes.begin(), changes.begin() + std::min<std::size_t>(size, changes.size()));
+}
+
+// Returns the sequence number of the last whole line of a journal, 0 if it
+// has none, and whether the journal ends with a whole line
+unsigned long long ChangeFeed::scanTail(const String &path, bool &complete) {
+    complete = true;
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return 0;
+    }
+    const std::streamoff size = file.tellg();
+    if (size <= 0) {
+        return 0;
+    }
+
+    // Read back from the end until the window holds a whole line
+    for (std::streamoff window = TAIL_SIZE;; window *= 2) {
+        const std::streamoff start = std::max<std::streamoff>(0, size - window);
+        String tail(size - start, '\0');
+        file.seekg(start);
+        file.read(&tail[0], tail.size());
+        complete = tail.back() == '\n';
+
+        // Each line ends where the next newline is; an unfinished last
+        // line is skipped
+        String::size_type end = complete ? tail.size() - 1 : tail.rfind('\n');
+        while (end != String::npos) {
+            const String::size_type newline = end == 0 ? String::npos : tail.rfind('\n', end - 1);
+            if (newline == String::npos && start > 0) {
+                break;
+            }
+            const String::size_type from = newline == String::npos ? 0 : newline + 1;
+            const unsigned long long sequence =
+                sequenceOf(Json::parse(tail.begin() + from, tail.begin() + end, nullptr, false));
+            if (sequence > 0) {
+                return sequence;
+            }
+            end = newline;
+        }
+        if (start == 0) {
+            return 0;
+        }
+    }
+}
+
+// Returns the sequence number of the first whole line of a journal, 0 if it
+// has none
+unsigned long long ChangeFeed::firstSequence(const String &path) {
+    std::ifstream file(path, std::ios::binary);
+    String line;
+    while (std::getline(file, line)) {
+        const unsigned long long sequence = sequenceOf(Json::parse(line, nullptr, false));
+        if (sequence > 0) {
+            return sequence;
+        }
+    }
+    return 0;
+}
+
+/*
+    * Function to return the sequence number of the last change in the
+    * journal of a database, or in the one moved aside if nothing has been
+    * appended since
+    * @param fileName: The filename of the database
+    * @return unsigned long long: The number, 0 if there is no journal
+*/
+unsigned long long ChangeFeed::lastSequence(const String &fileName) {
+    bool complete;
+    const unsigned long long last = scanTail(journalPath(fileName), complete);
+    return last > 0 ? last : scanTail(oldJournalPath(fileName), complete);
+}
+
+/*
+    * Function to number the recorded changes after the last change in the
+    * journal of a database, as the lines to append to it, each with the
+    * current time. Must be called while the database is locked, so no other
+    * process appends meanwhile.
+    * @param fileName: The filename of the database
+    * @param last: Set to the sequence number of the last change
+    * @return String: The lines to append
+*/
+String ChangeFeed::entries(const String &fileName, unsigned long long &last) const {
+    bool complete;
+    last = scanTail(journalPath(fileName), complete);
+    if (last == 0) {
+        last = lastSequence(fileName);
+    }
+    // A line left unfinished by a crash is ended, and skipped when read
+    std::ostringstream data;
+    if (!complete) {
+        data << '\n';
+    }
+    const long long time = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    JsonWriter writer(data);
+    for (const Json &change : changes) {
+        // the number and time go in among the keys of the change, which are
+        // written sorted
+        bool numbered = false;
+        bool timed = false;
+        writer.beginObject();
+        for (auto it = change.begin(); it != change.end(); ++it) {
+            if (!numbered && it.key() > "seq") {
+                writer.key("seq");
+                writer.number(++last);
+                numbered = true;
+            }
+            if (!timed && it.key() > "time") {
+                writer.key("time");
+                writer.number(time);
+                timed = true;
+            }
+            writer.key(it.key());
+            writeValue(writer, it.value());
+        }
+        if (!numbered) {
+            writer.key("seq");
+            writer.number(++last);
+        }
+        if (!timed) {
+            writer.key("time");
+            writer.number(time);
+        }
+        writer.endObject();
+        writer.endLine();
+    }
+    writer.flush();
+    return data.str();
+}
+
+/*
+    * Function to append the recorded changes to the journal of a database,
+    * numbered after its last change, and flush them to disk. Must be called
+    * while the database is locked, so no other process appends meanwhile.
+    * @param fileName: The filename of the database
+    * @return unsigned long long: The sequence number of the last change
+    * @throws std::runtime_error: If the changes cannot be written, in which
+    * case the journal is cut back to what it was
+*/
+unsigned long long ChangeFeed::append(const String &fileName) const {
+    unsigned long long last;
+    appendEntries(fileName, entries(fileName, last));
+    return last;
+}
+
+/*
+    * Function to append lines made by entries to the journal of a database,
+    * and flush them to disk. A journal that has grown past MAX_JOURNAL_SIZE
+    * is moved aside first. The database must have stayed locked since the
+    * lines were made.
+    * @param fileName: The filename of the database
+    * @param data: The lines to append
+    * @throws std::runtime_error: If the lines cannot be written, in which
+    * case the journal is cut back to what it was
+*/
+void ChangeFeed::appendEntries(const String &fileName, String data) {
+    const String path = journalPath(fileName);
+
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0 && info.st_size >= MAX_JOURNAL_SIZE) {
+        const String old = oldJournalPath(fileName);
+#ifdef _WIN32
+        std::remove(old.c_str());
+#endif
+        if (std::rename(path.c_str(), old.c_str()) != 0) {
+            throw std::runtime_error("Failed to replace " + old);
+        }
+        if (!data.empty() && data[0] == '\n') {
+            data.erase(0, 1);
+        }
+    }
+
+#ifdef _WIN32
+    const int fd = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_BINARY | _O_APPEND,
+                         _S_IREAD | _S_IWRITE);
+    const long long size = fd < 0 ? 0 : _lseeki64(fd, 0, SEEK_END);
+#else
+    const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | O_APPEND, 0644);
+    const long long size = fd < 0 ? 0 : lseek(fd, 0, SEEK_END);
+#endif
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path);
+    }
+    WriteQueue &queue = WriteQueue::shared();
+    try {
+        queue.wait(queue.write(fd, data, -1, true));
+    } catch (const std::runtime_error &) {
+        // Part of a change left behind would be read as a torn line
+#ifdef _WIN32
+        _chsize_s(fd, size);
+#else
+        if (ftruncate(fd, size) != 0) {
+            // The torn line is skipped when read
+        }
+#endif
+        close(fd);
+        throw std::runtime_error("Failed to write " + path);
+    }
+    close(fd);
+}
+
+/*
+    * Function to start keeping the journal of a database, if it is not
+    * kept already. Every save from then on appends its changes to it.
+    * @param fileName: The filename of the database
+    * @throws std::runtime_error: If the journal cannot be created
+*/
+void ChangeFeed::start(const String &fileName) {
+    const String path = journalPath(fileName);
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to create " + path);
+    }
+}
+
+// Function to return the name of the journal of a database
+String ChangeFeed::journalPath(const String &fileName) {
+    return fileName + ".journal";
+}
+
+// Function to return the name of the journal of a database once moved aside
+String ChangeFeed::oldJournalPath(const String &fileName) {
+    return journalPath(fileName) + ".old";
+}
+
+// Prints the changes in a journal after a given one, returning the sequence
+// number of the last one printed, since if there were none. The lines are
+// in order, so the journal is bisected to near the first one to print,
+// then read line by line from there.
+unsigned long long ChangeFeed::copy(const String &path, unsigned long long since,
+                                    std::ostream &out) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return since;
+    }
+
+    // A line starting at low is never after the first one to print, and
+    // the first one to print starts before high
+    std::streamoff low = 0;
+    std::streamoff high = file.tellg();
+    String line;
+    while (high - low > BISECT_SIZE) {
+        const std::streamoff middle = low + (high - low) / 2;
+        file.clear();
+        file.seekg(middle);
+        std::getline(file, line);
+        std::streamoff start = file.tellg();
+        unsigned long long sequence = 0;
+        while (start >= 0 && start < high && std::getline(file, line) &&
+               (sequence = sequenceOf(Json::parse(line, nullptr, false))) == 0) {
+            start = file.tellg();
+        }
+        if (sequence > 0 && sequence <= since) {
+            low = start;
+        } else {
+            high = middle;
+        }
+    }
+
+    file.clear();
+    file.seekg(low);
+    unsigned long long last = since;
+    while (std::getline(file, line)) {
+        const unsigned long long sequence = sequenceOf(Json::parse(line, nullptr, false));
+        if (sequence > since) {
+            out << line << '\n';
+            last = sequence;
+        }
+    }
+    return last;
+}
+
+/*
+    * Function to print the changes in the journal of a database after a
+    * given one, one per line. If they start in the journal moved aside,
+    * the rest of it is printed first. If they are in neither, a reset with
+    * the sequence number of the last change is printed instead, after which
+    * the whole database has to be read again. Nothing is printed for a
+    * database no journal is kept for (see start). The database is locked
+    * while the journals are read, so a save cannot move one aside meanwhile.
+    * @param fileName: The filename of the database
+    * @param since: The sequence number of the last change already seen
+    * @param out: The stream to print the changes to
+    * @return unsigned long long: The sequence number of the last change
+    * printed, since if there were none
+*/
+unsigned long long ChangeFeed::read(const String &fileName, unsigned long long since,
+                                    std::ostream &out) {
+    FileLock lock(fileName, FileLock::SHARED);
+    unsigned long long last = since;
+    const unsigned long long first = firstSequence(journalPath(fileName));
+    if (first == 0 || first > since + 1) {
+        const unsigned long long older = firstSequence(oldJournalPath(fileName));
+        if (older != 0 && older <= since + 1) {
+            last = copy(oldJournalPath(fileName), since, out);
+        } else if (older != 0 || first != 0) {
+            last = lastSequence(fileName);
+            JsonWriter writer(out);
+            writer.beginObject();
+            writer.key("op");
+            writer.value("reset");
+            writer.key("seq");
+            writer.number(last);
+            writer.endObject();
+            writer.endLine();
+            writer.flush();
+            out << std::flush;
+            return last;
+        }
+    }
+    last = copy(journalPath(fileName), last, out);
+    out << std::flush;
+    return last;
+}
@@ -0,0 +1,92 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the ChangeFeed class.
+ * A ChangeFeed records the changes made to a TodoList, as they are made, so
+ * that saving the TodoList can append them to the journal next to the
+ * database (the database filename with '.journal' appended). Each change is
+ * one line of JSON with a sequence number one more than the line before,
+ * e.g.
+ *   {"op":"tag.added","project":"M02","seq":12,"tag":"uni","task":"Lab 1"}
+ * so a program watching the database can ask for the changes after the
+ * last one it saw and apply them, rather than read the whole database again.
+ * Each line also has the time it was saved, in milliseconds since the
+ * epoch, as "time".
+ * The operations are: project.created (with the project as "value"),
+ * project.renamed (with the new identifier as "to"), project.deleted,
+ * task.created (with the task as "value"), task.renamed, task.deleted,
+ * tag.added, tag.removed, task.completed (with "completed"), task.due (with
+ * "due", empty for none) and reset, which means the whole database was
+ * replaced and has to be read again.
+ * Keeping a journal is opt-in: it is only kept for a database once something
+ * follows it. start creates the journal (the feed action without --since,
+ * and a Replica, call it), and from then on every save appends to it.
+ * Until then saves skip it, and read prints nothing. A journal
+ * that has grown past MAX_JOURNAL_SIZE is moved aside (with '.old' appended,
+ * replacing the one before) by the next save, so the changes of the last
+ * two journals can be read and older ones are only in the database.
+*/
+
+
+#ifndef CHANGEFEED_H
+#define CHANGEFEED_H
+
+#include <ios>
+#include <ostream>
+#include <vector>
+
+#include "date.h"
+#include "lib_json.hpp"
+
+using Json = nlohmann::json;
+
+class Project;
+class Task;
+
+class ChangeFeed {
+  std::vector<Json> changes;
+
+  void record(const char *op, const String &project, Json &&fields);
+  static unsigned long long scanTail(const String &path, bool &complete);
+  static unsigned long long firstSequence(const String &path);
+  static unsigned long long copy(const String &path, unsigned long long since,
+                                 std::ostream &out);
+
+public:
+  // The size past which a journal is moved aside by the next save
+  static const std::streamoff MAX_JOURNAL_SIZE = 4 << 20;
+
+  ChangeFeed() = default;
+  ~ChangeFeed() = default;
+
+  void projectCreated(const Project &project);
+  void projectRenamed(const String &project, const String &to);
+  void projectDeleted(const String &project);
+  void taskCreated(const String &project, const Task &task);
+  void taskRenamed(const String &project, const String &task, const String &to);
+  void taskDeleted(const String &project, const String &task);
+  void tagAdded(const String &project, const String &task, const String &tag);
+  void tagRemoved(const String &project, const String &task, const String &tag);
+  void completed(const String &project, const String &task, bool completed);
+  void dueDate(const String &project, const String &task, const Date &date);
+  void reset();
+
+  bool empty() const noexcept;
+  unsigned int size() const noexcept;
+  const std::vector<Json> &recorded() const noexcept;
+  void clear() noexcept;
+  void truncate(unsigned int size) noexcept;
+  void drop(unsigned int size) noexcept;
+  String entries(const String &fileName, unsigned long long &last) const;
+  unsigned long long append(const String &fileName) const;
+
+  static void start(const String &fileName);
+  static void appendEntries(const String &fileName, String data);
+  static String journalPath(const String &fileName);
+  static String oldJournalPath(const String &fileName);
+  static unsigned long long lastSequence(const String &fileName);
+  static unsigned long long read(const String &fileName, unsigned long long since,
+                                 std::ostream &out);
+};
+
+#endif // CHANGEFEED_H
@@ -6,13 +6,98 @@
 
 
 #include "date.h"
+#include <cstdint>
+#include <ctime>
 #include <string>
-#include <sstream>
+
+
+// The number of days in each month of a year that is not a leap year
+static const unsigned char daysInMonth[13] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+// Function to tell whether a date is valid, looking the month up in the table
+static bool validDate(unsigned int year, unsigned int month, unsigned int day) noexcept {
+    if (month < 1 || month > 12 || day < 1) {
+        return false;
+    }
+    return day <= daysInMonth[month] + (month == 2 && year % 4 == 0 ? 1u : 0u);
+}
+
+// Function to read eight bytes as a number, the first the least significant
+static std::uint64_t loadLittleEndian(const char *bytes) noexcept {
+    std::uint64_t value = 0;
+    for (unsigned int i = 0; i < 8; i++) {
+        value |= std::uint64_t(static_cast<unsigned char>(bytes[i])) << (8 * i);
+    }
+    return value;
+}
+
+/*
+    * Function to read the digits of YYYYMMDD, packed one to a byte. Each byte
+    * is checked to be a digit by adding and subtracting so that any other
+    * byte sets its top bit, then each pair of digits is turned into a number
+    * in its 16 bits: ten times the first (in the low byte) plus the second.
+    * @param chunk: The eight characters
+    * @param year, month, day: Set to the numbers read
+    * @return bool: False if a character is not a digit
+*/
+static bool readDigits(std::uint64_t chunk, unsigned int &year, unsigned int &month,
+                       unsigned int &day) noexcept {
+    if ((((chunk + 0x4646464646464646) | (chunk - 0x3030303030303030)) &
+         0x8080808080808080) != 0) {
+        return false;
+    }
+    const std::uint64_t digits = chunk - 0x3030303030303030;
+    const std::uint64_t pairs = (digits * 10 + (digits >> 8)) & 0x00ff00ff00ff00ff;
+    year = static_cast<unsigned int>(pairs & 0xff) * 100 + static_cast<unsigned int>((pairs >> 16) & 0xff);
+    month = static_cast<unsigned int>((pairs >> 32) & 0xff);
+    day = static_cast<unsigned int>(pairs >> 48);
+    return true;
+}
+
+/*
+    * Function to write a date with a year below 10000 as YYYY-MM-DD. The
+    * four pairs of digits are put in 16 bits each; the tens of each are
+    * found by multiplying by 103 and dividing by 1024, exact below 179, and
+    * the units are what is left, so that all eight characters are made at
+    * once.
+    * @param year, month, day: The date
+    * @param out: Where to write the ten characters
+*/
+static void writeDigits(unsigned int year, unsigned int month, unsigned int day, char *out) noexcept {
+    const std::uint64_t pairs = std::uint64_t(year / 100) | std::uint64_t(year % 100) << 16 |
+                                std::uint64_t(month) << 32 | std::uint64_t(day) << 48;
+    const std::uint64_t tens = ((pairs * 103) >> 10) & 0x000f000f000f000f;
+    const std::uint64_t units = pairs - tens * 10;
+    const std::uint64_t chunk = tens | units << 8 | 0x3030303030303030;
+    char digits[8];
+    for (unsigned int i = 0; i < 8; i++) {
+        digits[i] = static_cast<char>(chunk >> (8 * i));
+    }
+    out[0] = digits[0];
+    out[1] = digits[1];
+    out[2] = digits[2];
+    out[3] = digits[3];
+    out[4] = '-';
+    out[5] = digits[4];
+    out[6] = digits[5];
+    out[7] = '-';
+    out[8] = digits[6];
+    out[9] = digits[7];
+}
 
 
 // Default constructor to create an unitialised date.
 Date::Date() : year(0), month(0), day(0), initialized(false) {}
 
+// Function to return the current local date.
+Date Date::today() {
+    std::time_t now = std::time(nullptr);
+    std::tm local = *std::localtime(&now);
+    Date date;
+    date.setDate(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+    return date;
+}
+
 
 /*
     * Function to set the date from a string
@@ -30,16 +115,63 @@ void Date::setDateFromString(const String& dateString) {
         if (dateString.size() != 10 || dateString[4] != '-' || dateString[7] != '-') {
             throw std::invalid_argument("Invalid date format. Valid format is YYYY-MM-DD.");
         }
-        unsigned int rYear = std::stoi(dateString.substr(0, 4));
-        unsigned int rMonth = std::stoi(dateString.substr(5, 2));
-        unsigned int rDay = std::stoi(dateString.substr(8, 2));
-        if (!checkValidDate(rYear, rMonth, rDay)) {
+        if (!parse(dateString.data(), dateString.size(), *this)) {
             this->initialized = false;
             throw std::invalid_argument("Invalid date.");
         }
-        else {
-            setDate(rYear, rMonth, rDay);
-        }
+    }
+}
+
+/*
+    * Function to read a date written as YYYY-MM-DD
+    * @param text: The text, which need not end in a NUL
+    * @param length: The length of the text
+    * @param date: Set to the date read, uninitialised if the text is empty
+    * @return bool: False if the text is not a valid date, leaving date as it was
+*/
+bool Date::parse(const char *text, std::size_t length, Date &date) noexcept {
+    if (length == 0) {
+        date = Date();
+        return true;
+    }
+    if (length != 10 || text[4] != '-' || text[7] != '-') {
+        return false;
+    }
+    const char chunk[8] = {text[0], text[1], text[2], text[3], text[5], text[6], text[8], text[9]};
+    unsigned int rYear, rMonth, rDay;
+    if (!readDigits(loadLittleEndian(chunk), rYear, rMonth, rDay) ||
+        !validDate(rYear, rMonth, rDay)) {
+        return false;
+    }
+    date.setDate(rYear, rMonth, rDay);
+    return true;
+}
+
+/*
+    * Function to read many dates written as YYYY-MM-DD
+    * @param texts: The texts, any of which may be empty
+    * @param dates: Set to the dates read, one for each text
+    * @return bool: False if any text is not a valid date
+*/
+bool Date::parseMany(const std::vector<String> &texts, std::vector<Date> &dates) {
+    dates.assign(texts.size(), Date());
+    bool valid = true;
+    for (std::size_t i = 0; i < texts.size(); i++) {
+        valid &= parse(texts[i].data(), texts[i].size(), dates[i]);
+    }
+    return valid;
+}
+
+/*
+    * Function to write many dates as str() writes each
+    * @param dates: The dates
+    * @param texts: Set to the dates written, one for each date
+*/
+void Date::formatMany(const std::vector<Date> &dates, std::vector<String> &texts) {
+    texts.resize(dates.size());
+    for (std::size_t i = 0; i < dates.size(); i++) {
+        texts[i].clear();
+        dates[i].appendStr(texts[i]);
     }
 }
 
@@ -51,37 +183,7 @@ void Date::setDateFromString(const String& dateString) {
     * @return bool: True if the date is valid, false otherwise
 */
 bool Date::checkValidDate(unsigned int year, unsigned int month, unsigned int day) {
-    if (year < 0 || month < 1 || month > 12 || day < 1) {
-        return false;
-    }
-    switch (month) {
-        case 1:
-            return day <= 31;
-        case 2:
-            return day <= ((year % 4 == 0 || year % 400 == 0) ? 29 : 28);
-        case 3:
-            return day <= 31;
-        case 4:
-            return day <= 30;
-        case 5:
-            return day <= 31;
-        case 6:
-            return day <= 30;
-        case 7:
-            return day <= 31;
-        case 8:
-            return day <= 31;
-        case 9:
-            return day <= 30;
-        case 10:
-            return day <= 31;
-        case 11:
-            return day <= 30;
-        case 12:
-            return day <= 31;
-        default:
-            return false;
-    }
+    return validDate(year, month, day);
 }
 
 // Function to set iniialized state.
@@ -97,12 +199,47 @@ const bool Date::isInitialised() const noexcept {
 
 // Function to return the date as a string.
 String Date::str() const {
+    String s;
+    appendStr(s);
+    return s;
+}
+
+// Function to return the length of str(), without building it.
+unsigned int Date::strLength() const noexcept {
     if (!initialized) {
-        return "";
+        return 0;
+    }
+    unsigned int digits = 4;
+    for (unsigned int y = year; y >= 10000; y /= 10) {
+        digits++;
+    }
+    return digits + 6;
+}
+
+// Function to append the date to a string, zero-padded so that it can be
+// parsed back, without allocating anything beyond the string's capacity.
+void Date::appendStr(String &s) const {
+    if (!initialized) {
+        return;
+    }
+    if (year < 10000 && month < 100 && day < 100) {
+        char text[10];
+        writeDigits(year, month, day, text);
+        s.append(text, sizeof(text));
+        return;
     }
-    std::stringstream ss;
-    ss << year << "-" << month << "-" << day;
-    return ss.str();
+    char digits[16];
+    char *end = digits + sizeof(digits);
+    char *cursor = end;
+    unsigned int y = year;
+    do {
+        *--cursor = '0' + y % 10;
+        y /= 10;
+    } while (y > 0 || end - cursor < 4);
+    s.append(cursor, end);
+    const char rest[] = {'-', static_cast<char>('0' + month / 10), static_cast<char>('0' + month % 10),
+                         '-', static_cast<char>('0' + day / 10), static_cast<char>('0' + day % 10)};
+    s.append(rest, sizeof(rest));
 }
 
 // Function to set the date.
@@ -8,6 +8,9 @@
 #ifndef DATE_H
 #define DATE_H
 
+#include <cstddef>
+#include <vector>
+
 #include "lib_json.hpp"
 
 using String = std::string;
@@ -21,12 +24,22 @@ public:
   Date();
   ~Date() = default;
 
+  static Date today();
+
+  // Dates written as YYYY-MM-DD are read and written eight digits at a
+  // time, without exceptions; an empty text is an uninitialised date
+  static bool parse(const char *text, std::size_t length, Date &date) noexcept;
+  static bool parseMany(const std::vector<String> &texts, std::vector<Date> &dates);
+  static void formatMany(const std::vector<Date> &dates, std::vector<String> &texts);
+
   void setDateFromString(const String& string);
   bool checkValidDate(unsigned int year, unsigned int month, unsigned int day);
   void setInitialised(bool initialised);
 
   const bool isInitialised() const noexcept;
   String str() const;
+  unsigned int strLength() const noexcept;
+  void appendStr(String &s) const;
 
   void setDate(unsigned int year, unsigned int month, unsigned int day) noexcept;
 
@@ -0,0 +1,652 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the Exporter class
+ * and the exporters for each format of the export action.
+*/
+
+
+#include "exporter.h"
+
+#include <fstream>
+#include <stdexcept>
+
+
+// Hands the tasks of a database to an Exporter as the parser reads them.
+// The database is an object of projects, each an object of tasks, each an
+// object with "completed", "dueDate" and "tags"; other members of a task
+// are skipped, as load skips them.
+class TaskReader : public nlohmann::json_sax<Json> {
+  Exporter &exporter;
+
+  // How many objects and arrays are open: 1 in the database, 2 in a
+  // project, 3 in a task and 4 in its tags
+  unsigned int depth;
+  // How many objects and arrays are open inside a member being skipped
+  unsigned int skipping;
+
+  String project;
+  String member;
+  String ident;
+  bool completed;
+  Date due;
+  TagContainer tags;
+
+  bool known() const {
+    return member == "completed" || member == "dueDate" || member == "tags";
+  }
+
+  bool fail(const String &reason) {
+    error = reason;
+    return false;
+  }
+
+  // A number or null is only allowed for a member that is skipped
+  bool other() {
+    return skipping > 0 || (depth == 3 && !known()) || fail("unexpected value");
+  }
+
+public:
+  String error;
+
+  explicit TaskReader(Exporter &exporter)
+      : exporter(exporter), depth(0), skipping(0), completed(false) {}
+
+  bool null() override {
+    // A project without tasks used to be saved as null
+    if (depth == 1) {
+      exporter.project(project);
+      return true;
+    }
+    return other();
+  }
+
+  bool boolean(bool value) override {
+    if (skipping > 0 || (depth == 3 && !known())) {
+      return true;
+    }
+    if (depth == 3 && member == "completed") {
+      completed = value;
+      return true;
+    }
+    return fail("unexpected boolean");
+  }
+
+  bool number_integer(number_integer_t) override { return other(); }
+  bool number_unsigned(number_unsigned_t) override { return other(); }
+  bool number_float(number_float_t, const string_t &) override { return other(); }
+  bool binary(binary_t &) override { return fail("unexpected binary value"); }
+
+  bool string(string_t &value) override {
+    if (skipping > 0 || (depth == 3 && !known())) {
+      return true;
+    }
+    if (depth == 4) {
+      tags.push_back(value);
+      return true;
+    }
+    if (depth == 3 && member == "dueDate") {
+      try {
+        due.setDateFromString(value);
+      } catch (const std::invalid_argument &e) {
+        return fail(e.what());
+      }
+      return true;
+    }
+    return fail("unexpected string");
+  }
+
+  bool start_object(std::size_t) override {
+    if (skipping > 0 || (depth == 3 && !known())) {
+      skipping++;
+      return true;
+    }
+    if (depth == 1) {
+      exporter.project(project);
+    } else if (depth == 2) {
+      completed = false;
+      due = Date();
+      tags.clear();
+    } else if (depth > 2) {
+      return fail("unexpected object");
+    }
+    depth++;
+    return true;
+  }
+
+  bool key(string_t &value) override {
+    if (skipping > 0) {
+      return true;
+    }
+    if (depth == 1) {
+      project = value;
+    } else if (depth == 2) {
+      ident = value;
+    } else {
+      member = value;
+    }
+    return true;
+  }
+
+  bool end_object() override {
+    if (skipping > 0) {
+      skipping--;
+      return true;
+    }
+    if (depth == 3) {
+      Task task(ident);
+      task.setComplete(completed);
+      task.setDueDate(due);
+      task.mergeTags(tags);
+      exporter.task(project, task);
+    }
+    depth--;
+    return true;
+  }
+
+  bool start_array(std::size_t) override {
+    if (skipping > 0 || (depth == 3 && !known())) {
+      skipping++;
+      return true;
+    }
+    if (depth == 3 && member == "tags") {
+      depth++;
+      return true;
+    }
+    return fail("unexpected array");
+  }
+
+  bool end_array() override {
+    if (skipping > 0) {
+      skipping--;
+      return true;
+    }
+    depth--;
+    return true;
+  }
+
+  bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &e) override {
+    return fail(e.what());
+  }
+};
+
+// Checks that the projects of a database, and the tasks of each, are
+// sorted by identifier with none twice, as loading the database leaves them
+class OrderChecker : public Exporter {
+  String previousProject;
+  String previousTask;
+  bool anyProject;
+  bool anyTask;
+
+public:
+  bool sorted;
+
+  OrderChecker() : anyProject(false), anyTask(false), sorted(true) {}
+
+  void project(const String &ident) override {
+    if (anyProject && !(previousProject < ident)) {
+      sorted = false;
+    }
+    previousProject = ident;
+    anyProject = true;
+    anyTask = false;
+  }
+
+  void task(const String &, const Task &task) override {
+    if (anyTask && !(previousTask < task.getIdent())) {
+      sorted = false;
+    }
+    previousTask = task.getIdent();
+    anyTask = true;
+  }
+};
+
+// Function called with the identifier of each project, before its tasks
+void Exporter::project(const String &) {}
+
+// Function called once every task has been handed over
+void Exporter::finish() {}
+
+/*
+    * Function to hand over every task of a TodoList, project by project
+    * @param tl: The TodoList
+*/
+void Exporter::exportTodoList(const TodoList &tl) {
+    for (const Project &project : tl.getProjects()) {
+        this->project(project.getIdent());
+        for (const Task &task : project.getTasks()) {
+            this->task(project.getIdent(), task);
+        }
+    }
+}
+
+/*
+    * Function to hand over every task of a database as it is read, without
+    * loading it. The database is only locked while it is opened: a save
+    * replaces the file rather than changing it, so the version opened is
+    * read to the end.
+    * @param fileName: The filename of the database
+    * @throws std::runtime_error: If the database cannot be opened or is not
+    * a valid database, in which case the tasks before the error have
+    * already been handed over
+*/
+void Exporter::exportFile(const String &fileName) {
+    std::ifstream file;
+    {
+        FileLock lock(fileName, FileLock::SHARED);
+        file.open(fileName, std::ios::binary);
+    }
+    if (!file.is_open()) {
+        throw std::runtime_error("File failed to open.");
+    }
+    TaskReader reader(*this);
+    if (!Json::sax_parse(file, &reader)) {
+        throw std::runtime_error("Invalid database " + fileName + ": " + reader.error);
+    }
+}
+
+/*
+    * Function to hand over every task of a database as it is read, without
+    * loading it, once the whole file has been read through to check it is
+    * valid and in the order loading it would give: projects and the tasks of
+    * each sorted by identifier, with none twice. The database is only locked
+    * while it is opened, and both readings are of the version opened.
+    * @param fileName: The filename of the database
+    * @return bool: True if the tasks were handed over, false if nothing was
+    * because the database is not in that order, and has to be loaded to be
+    * read as loading it would
+    * @throws std::runtime_error: If the database cannot be opened or is not
+    * a valid database, in which case nothing has been handed over
+*/
+bool Exporter::exportFileInOrder(const String &fileName) {
+    std::ifstream file;
+    {
+        FileLock lock(fileName, FileLock::SHARED);
+        file.open(fileName, std::ios::binary);
+    }
+    if (!file.is_open()) {
+        throw std::runtime_error("File failed to open.");
+    }
+    OrderChecker checker;
+    TaskReader checking(checker);
+    if (!Json::sax_parse(file, &checking)) {
+        throw std::runtime_error("Invalid database " + fileName + ": " + checking.error);
+    }
+    if (!checker.sorted) {
+        return false;
+    }
+
+    file.clear();
+    file.seekg(0);
+    TaskReader reader(*this);
+    if (!Json::sax_parse(file, &reader)) {
+        throw std::runtime_error("Invalid database " + fileName + ": " + reader.error);
+    }
+    return true;
+}
+
+/*
+    * Constructor to create an NdjsonExporter printing to a stream
+    * @param out: The stream to print to
+*/
+NdjsonExporter::NdjsonExporter(std::ostream &out) : writer(out) {}
+
+// Function to print a task on a line of its own
+void NdjsonExporter::task(const String &project, const Task &task) {
+    writer.beginObject();
+    writer.key("project");
+    writer.value(project);
+    writer.key("task");
+    writer.value(task.getIdent());
+    writer.key("completed");
+    writer.value(task.isComplete());
+    writer.key("dueDate");
+    writer.value(task.getDueDate().str());
+    writer.key("tags");
+    writer.beginArray();
+    for (const String &tag : task.getTags()) {
+        writer.value(tag);
+    }
+    writer.endArray();
+    writer.endObject();
+    writer.endLine();
+}
+
+// Function to print the tasks still held
+void NdjsonExporter::finish() {
+    writer.flush();
+}
+
+/*
+    * Constructor to create a JsonExporter printing to a stream
+    * @param out: The stream to print to
+    * @param style: Whether to print compact or indented JSON
+*/
+JsonExporter::JsonExporter(std::ostream &out, JsonWriter::Style style)
+    : writer(out, style), started(false), inProject(false) {}
+
+// Function to start the project's object, ending the one before
+void JsonExporter::project(const String &ident) {
+    if (!started) {
+        writer.beginObject();
+        started = true;
+    }
+    if (inProject) {
+        writer.endObject();
+    }
+    writer.key(ident);
+    writer.beginObject();
+    inProject = true;
+}
+
+// Function to print a task in the object of the project started last
+void JsonExporter::task(const String &, const Task &task) {
+    writer.key(task.getIdent());
+    task.write(writer);
+}
+
+// Function to end the database's object and print what is still held
+void JsonExporter::finish() {
+    if (!started) {
+        writer.beginObject();
+        started = true;
+    }
+    if (inProject) {
+        writer.endObject();
+        inProject = false;
+    }
+    writer.endObject();
+    writer.flush();
+}
+
+// The values Arrow's metadata gives the parts of it that are used
+static const unsigned int METADATA_V5 = 4;
+static const unsigned int TYPE_UTF8 = 5;
+static const unsigned int TYPE_BOOL = 6;
+static const unsigned int TYPE_DATE = 8;
+static const unsigned int TYPE_LIST = 12;
+static const unsigned int HEADER_SCHEMA = 1;
+static const unsigned int HEADER_DICTIONARY_BATCH = 2;
+static const unsigned int HEADER_RECORD_BATCH = 3;
+
+// The dictionaries of the project and tag columns
+static const std::int64_t PROJECT_DICTIONARY = 0;
+static const std::int64_t TAG_DICTIONARY = 1;
+
+// Returns the number of bytes a buffer takes up in a message, padded to 8
+static std::uint64_t padded(std::uint64_t length) {
+    return (length + 7) & ~std::uint64_t(7);
+}
+
+// Returns whether the host stores numbers most significant byte first
+static bool bigEndian() {
+    const std::uint16_t one = 1;
+    return *reinterpret_cast<const unsigned char *>(&one) == 0;
+}
+
+/*
+    * Function to append two 64-bit numbers, a FieldNode (length and number
+    * of nulls) or a Buffer (offset and length) in Arrow's metadata
+    * @param s: The bytes of a vector of structs
+    * @param first: The first number
+    * @param second: The second number
+*/
+static void appendPair(String &s, std::uint64_t first, std::uint64_t second) {
+    FlatObject::appendLittleEndian(s, first, 8);
+    FlatObject::appendLittleEndian(s, second, 8);
+}
+
+/*
+    * Function to count the days from 1970-01-01 to a date, as date32 does
+    * @param date: The date
+    * @return The number of days, negative before 1970
+*/
+static std::int32_t daysSinceEpoch(const Date &date) {
+    const std::int64_t month = date.getMonth();
+    const std::int64_t year = static_cast<std::int64_t>(date.getYear()) - (month <= 2);
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const std::int64_t yearOfEra = year - era * 400;
+    const std::int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + date.getDay() - 1;
+    const std::int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return static_cast<std::int32_t>(era * 146097 + dayOfEra - 719468);
+}
+
+// Function to describe a dictionary-encoded column, with int32 indexes
+static FlatRef dictionaryEncoding(std::int64_t id) {
+    std::shared_ptr<FlatObject> indexType = FlatObject::table();
+    indexType->scalar(0, 32, 4).scalar(1, true, 1);
+    std::shared_ptr<FlatObject> encoding = FlatObject::table();
+    encoding->scalar(0, id, 8).offset(1, indexType);
+    return encoding;
+}
+
+/*
+    * Function to describe a column
+    * @param name: The column's name
+    * @param nullable: Whether it can hold nulls
+    * @param type: Its type (or, if dictionary-encoded, the dictionary's)
+    * @param typeTable: The parameters of its type
+    * @param dictionary: How it is dictionary-encoded, or null
+    * @param children: The columns of its values, for a list
+*/
+static FlatRef field(const String &name, bool nullable, unsigned int type, const FlatRef &typeTable,
+                     const FlatRef &dictionary, const std::vector<FlatRef> &children = {}) {
+    std::shared_ptr<FlatObject> f = FlatObject::table();
+    f->offset(0, FlatObject::string(name)).scalar(1, nullable, 1).scalar(2, type, 1);
+    f->offset(3, typeTable).offset(5, FlatObject::vector(children));
+    if (dictionary) {
+        f->offset(4, dictionary);
+    }
+    return f;
+}
+
+// Function to describe the columns of the file
+static FlatRef schema() {
+    const FlatRef empty = FlatObject::table();
+    std::shared_ptr<FlatObject> date = FlatObject::table();
+    date->scalar(0, 0, 2); // DateUnit DAY
+
+    const FlatRef tag = field("item", false, TYPE_UTF8, empty, dictionaryEncoding(TAG_DICTIONARY));
+    std::shared_ptr<FlatObject> s = FlatObject::table();
+    s->scalar(0, bigEndian(), 2);
+    s->offset(1, FlatObject::vector({
+        field("project", false, TYPE_UTF8, empty, dictionaryEncoding(PROJECT_DICTIONARY)),
+        field("task", false, TYPE_UTF8, empty, nullptr),
+        field("completed", false, TYPE_BOOL, empty, nullptr),
+        field("dueDate", true, TYPE_DATE, date, nullptr),
+        field("tags", false, TYPE_LIST, empty, nullptr, {tag}),
+    }));
+    return s;
+}
+
+/*
+    * Function to describe a record batch
+    * @param length: The number of rows
+    * @param nodes: The length and number of nulls of each column, as structs
+    * @param nodeCount: The number of columns
+    * @param body: The buffers of the columns, one after another
+*/
+static FlatRef recordBatch(std::int64_t length, const String &nodes, std::uint32_t nodeCount,
+                           const std::vector<std::pair<const void *, std::uint64_t>> &body) {
+    String buffers;
+    std::uint64_t offset = 0;
+    for (const auto &buffer : body) {
+        appendPair(buffers, offset, buffer.second);
+        offset += padded(buffer.second);
+    }
+    std::shared_ptr<FlatObject> batch = FlatObject::table();
+    batch->scalar(0, length, 8);
+    batch->offset(1, FlatObject::structs(nodes, nodeCount, 8));
+    batch->offset(2, FlatObject::structs(buffers, static_cast<std::uint32_t>(body.size()), 8));
+    return batch;
+}
+
+/*
+    * Function to add a string to the end of the column
+    * @param s: The string
+    * @throws std::runtime_error: If the column would hold more than 2 GiB
+*/
+void ArrowExporter::Utf8Column::push(const String &s) {
+    if (data.size() + s.size() > 0x7fffffff) {
+        throw std::runtime_error("Too much text to export in the arrow format.");
+    }
+    data += s;
+    offsets.push_back(static_cast<std::int32_t>(data.size()));
+}
+
+/*
+    * Function to get the index of a string, adding it if it is new
+    * @param s: The string
+    * @return Its index in the dictionary
+*/
+std::int32_t ArrowExporter::Dictionary::index(const String &s) {
+    const auto found = indexes.find(s);
+    if (found != indexes.end()) {
+        return found->second;
+    }
+    const std::int32_t i = static_cast<std::int32_t>(indexes.size());
+    values.push(s);
+    indexes.emplace(s, i);
+    return i;
+}
+
+/*
+    * Constructor to create an ArrowExporter writing to a stream
+    * @param out: The stream, which should be binary
+*/
+ArrowExporter::ArrowExporter(std::ostream &out)
+    : out(out), written(0), rows(0), dueNulls(0) {}
+
+// Function to write bytes to the stream, counting them
+void ArrowExporter::write(const String &bytes) {
+    out.write(bytes.data(), bytes.size());
+    written += bytes.size();
+}
+
+/*
+    * Function to write a message: its metadata, then its body
+    * @param headerType: Whether it holds a schema, dictionary or record batch
+    * @param header: The schema, dictionary or record batch
+    * @param body: The buffers of the columns, which are padded to 8 bytes
+    * @param blocks: Where the message is added, as a Block of the footer
+*/
+void ArrowExporter::writeMessage(unsigned int headerType, const FlatRef &header,
+                                 const std::vector<std::pair<const void *, std::uint64_t>> &body,
+                                 String &blocks) {
+    static const char ZEROS[8] = {};
+    std::uint64_t bodyLength = 0;
+    for (const auto &buffer : body) {
+        bodyLength += padded(buffer.second);
+    }
+    std::shared_ptr<FlatObject> message = FlatObject::table();
+    message->scalar(0, METADATA_V5, 2).scalar(1, headerType, 1).offset(2, header);
+    message->scalar(3, bodyLength, 8);
+    const String metadata = FlatObject::build(message);
+
+    const std::uint64_t start = written;
+    String prefix;
+    FlatObject::appendLittleEndian(prefix, 0xffffffff, 4);
+    FlatObject::appendLittleEndian(prefix, metadata.size(), 4);
+    write(prefix);
+    write(metadata);
+    for (const auto &buffer : body) {
+        out.write(static_cast<const char *>(buffer.first), buffer.second);
+        out.write(ZEROS, padded(buffer.second) - buffer.second);
+    }
+    written += bodyLength;
+
+    FlatObject::appendLittleEndian(blocks, start, 8);
+    FlatObject::appendLittleEndian(blocks, prefix.size() + metadata.size(), 4);
+    FlatObject::appendLittleEndian(blocks, 0, 4);
+    FlatObject::appendLittleEndian(blocks, bodyLength, 8);
+}
+
+// Function to add a task to the end of each column
+void ArrowExporter::task(const String &project, const Task &task) {
+    projects.push_back(projectDictionary.index(project));
+    tasks.push(task.getIdent());
+
+    const char bit = static_cast<char>(1 << (rows % 8));
+    if (rows % 8 == 0) {
+        completed += '\0';
+        dueValidity += '\0';
+    }
+    if (task.isComplete()) {
+        completed.back() |= bit;
+    }
+    if (task.getDueDate().isInitialised()) {
+        dueValidity.back() |= bit;
+        dueDates.push_back(daysSinceEpoch(task.getDueDate()));
+    } else {
+        dueDates.push_back(0);
+        dueNulls++;
+    }
+
+    for (const String &tag : task.getTags()) {
+        tags.push_back(tagDictionary.index(tag));
+    }
+    tagOffsets.push_back(static_cast<std::int32_t>(tags.size()));
+    rows++;
+}
+
+// Function to write the file: the schema, the dictionaries, the columns
+// and then the footer, which says where each is
+void ArrowExporter::finish() {
+    static const String MAGIC("ARROW1", 6);
+    using Body = std::vector<std::pair<const void *, std::uint64_t>>;
+
+    const FlatRef fileSchema = schema();
+    write(MAGIC + String(2, '\0'));
+    String schemaBlock;
+    writeMessage(HEADER_SCHEMA, fileSchema, {}, schemaBlock);
+
+    String dictionaryBlocks;
+    for (const std::int64_t id : {PROJECT_DICTIONARY, TAG_DICTIONARY}) {
+        const Utf8Column &values = (id == PROJECT_DICTIONARY ? projectDictionary : tagDictionary).values;
+        const std::int64_t length = values.offsets.size() - 1;
+        String nodes;
+        appendPair(nodes, length, 0);
+        const Body body = {{nullptr, 0},
+                           {values.offsets.data(), values.offsets.size() * 4},
+                           {values.data.data(), values.data.size()}};
+        std::shared_ptr<FlatObject> dictionary = FlatObject::table();
+        dictionary->scalar(0, id, 8).offset(1, recordBatch(length, nodes, 1, body));
+        writeMessage(HEADER_DICTIONARY_BATCH, dictionary, body, dictionaryBlocks);
+    }
+
+    String nodes;
+    for (int column = 0; column < 5; column++) {
+        appendPair(nodes, rows, column == 3 ? dueNulls : 0);
+    }
+    appendPair(nodes, tags.size(), 0);
+    const Body body = {{nullptr, 0},
+                       {projects.data(), projects.size() * 4},
+                       {nullptr, 0},
+                       {tasks.offsets.data(), tasks.offsets.size() * 4},
+                       {tasks.data.data(), tasks.data.size()},
+                       {nullptr, 0},
+                       {completed.data(), completed.size()},
+                       {dueValidity.data(), dueNulls > 0 ? dueValidity.size() : 0},
+                       {dueDates.data(), dueDates.size() * 4},
+                       {nullptr, 0},
+                       {tagOffsets.data(), tagOffsets.size() * 4},
+                       {nullptr, 0},
+                       {tags.data(), tags.size() * 4}};
+    String recordBlocks;
+    writeMessage(HEADER_RECORD_BATCH, recordBatch(rows, nodes, 6, body), body, recordBlocks);
+
+    // The end of the stream of messages
+    String end;
+    FlatObject::appendLittleEndian(end, 0xffffffff, 4);
+    FlatObject::appendLittleEndian(end, 0, 4);
+    write(end);
+
+    std::shared_ptr<FlatObject> footer = FlatObject::table();
+    footer->scalar(0, METADATA_V5, 2).offset(1, fileSchema);
+    footer->offset(2, FlatObject::structs(dictionaryBlocks, 2, 8));
+    footer->offset(3, FlatObject::structs(recordBlocks, 1, 8));
+    String trailer = FlatObject::build(footer);
+    FlatObject::appendLittleEndian(trailer, trailer.size(), 4);
+    write(trailer + MAGIC);
+    out.flush();
+}
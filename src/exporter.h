@@ -0,0 +1,128 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the Exporter class and
+ * the exporters for each format of the export action.
+ * An Exporter is handed every task of a database in turn, with the
+ * identifier of its project, either from a TodoList already in memory or
+ * straight from the database file, which is parsed as it is read (with
+ * nlohmann::json's SAX interface) without building a TodoList, so that
+ * exporting a database takes memory for one task at a time. Each project is
+ * announced before its tasks, so that one without tasks is seen too.
+ * A JsonExporter prints the database as JSON, as the json action prints a
+ * TodoList, in the order the projects and tasks are in the file; the json
+ * action uses it to print a database that is not already in memory as it
+ * is read, without loading it. It does so with exportFileInOrder, which
+ * checks the whole file first, so that nothing is printed for a database
+ * that is not valid, and the database is only printed as it is read if it
+ * is in the order loading it would give (sorted, with no identifier twice).
+ * An NdjsonExporter prints each task as it is handed over, on a line of its
+ * own, e.g.
+ *   {"project":"M02","task":"Lab 1","completed":true,"dueDate":"2024-10-13","tags":["uni"]}
+ * An ArrowExporter gathers the tasks into columns and writes them, when
+ * finished, as an Arrow IPC file (https://arrow.apache.org/docs/format/
+ * Columnar.html), which analytics tools can memory-map and use without
+ * parsing. It has one record batch with the columns
+ *   project   dictionary<int32, utf8>
+ *   task      utf8
+ *   completed bool
+ *   dueDate   date32 (days since 1970-01-01), null where there is no date
+ *   tags      list<dictionary<int32, utf8>>
+ * The project and tag dictionaries each hold every distinct identifier
+ * once, in the order it was first seen. Columns are written in the byte
+ * order of the host, which the schema records.
+*/
+
+
+#ifndef EXPORTER_H
+#define EXPORTER_H
+
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "flatbuffer.h"
+#include "jsonwriter.h"
+#include "todolist.h"
+
+class Exporter {
+public:
+  virtual ~Exporter() = default;
+
+  virtual void project(const String &ident);
+  virtual void task(const String &project, const Task &task) = 0;
+  virtual void finish();
+
+  void exportTodoList(const TodoList &tl);
+  void exportFile(const String &fileName);
+  bool exportFileInOrder(const String &fileName);
+};
+
+class NdjsonExporter : public Exporter {
+  JsonWriter writer;
+
+public:
+  explicit NdjsonExporter(std::ostream &out);
+
+  void task(const String &project, const Task &task) override;
+  void finish() override;
+};
+
+class JsonExporter : public Exporter {
+  JsonWriter writer;
+  bool started;
+  bool inProject;
+
+public:
+  JsonExporter(std::ostream &out, JsonWriter::Style style);
+
+  void project(const String &ident) override;
+  void task(const String &project, const Task &task) override;
+  void finish() override;
+};
+
+class ArrowExporter : public Exporter {
+  // A utf8 column: where each string starts in data, then where the last ends
+  struct Utf8Column {
+    std::vector<std::int32_t> offsets{0};
+    String data;
+
+    void push(const String &s);
+  };
+
+  // The distinct strings of a dictionary-encoded column
+  struct Dictionary {
+    Utf8Column values;
+    std::unordered_map<String, std::int32_t> indexes;
+
+    std::int32_t index(const String &s);
+  };
+
+  std::ostream &out;
+  std::uint64_t written;
+
+  std::int64_t rows;
+  Dictionary projectDictionary, tagDictionary;
+  std::vector<std::int32_t> projects;
+  Utf8Column tasks;
+  String completed;
+  std::vector<std::int32_t> dueDates;
+  String dueValidity;
+  std::int64_t dueNulls;
+  std::vector<std::int32_t> tagOffsets{0};
+  std::vector<std::int32_t> tags;
+
+  void write(const String &bytes);
+  void writeMessage(unsigned int headerType, const FlatRef &header,
+                    const std::vector<std::pair<const void *, std::uint64_t>> &body,
+                    String &block);
+
+public:
+  explicit ArrowExporter(std::ostream &out);
+
+  void task(const String &project, const Task &task) override;
+  void finish() override;
+};
+
+#endif // EXPORTER_H
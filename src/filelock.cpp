@@ -0,0 +1,88 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the FileLock class,
+ * FileGeneration struct and ConflictError exception.
+*/
+
+
+#include "filelock.h"
+
+#include <cerrno>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+
+/*
+    * Constructor to lock a database, waiting for any conflicting lock held
+    * by another process to be released. If the lock file cannot be created
+    * (e.g. in a read only directory) the database is used without a lock.
+    * @param fileName: The filename of the database
+    * @param mode: SHARED to read the database, EXCLUSIVE to write it
+*/
+FileLock::FileLock(const std::string &fileName, Mode mode) : fd(-1) {
+#ifndef _WIN32
+    fd = open((fileName + ".lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return;
+    }
+    while (flock(fd, mode == EXCLUSIVE ? LOCK_EX : LOCK_SH) != 0) {
+        if (errno != EINTR) {
+            close(fd);
+            fd = -1;
+            return;
+        }
+    }
+#endif
+}
+
+// Destructor, releases the lock
+FileLock::~FileLock() {
+#ifndef _WIN32
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+}
+
+/*
+    * Function to return the generation of a file, which changes whenever the
+    * file is replaced or written
+    * @param fileName: The name of the file
+    * @return FileGeneration: The generation, all zero if the file is missing
+*/
+FileGeneration FileGeneration::of(const std::string &fileName) {
+    FileGeneration generation = {0, 0, 0, 0, 0};
+    struct stat info;
+    if (stat(fileName.c_str(), &info) != 0) {
+        return generation;
+    }
+    generation.device = info.st_dev;
+    generation.inode = info.st_ino;
+    generation.size = info.st_size;
+    generation.mtime = info.st_mtime;
+#if defined(__linux__)
+    generation.mtimeNanoseconds = info.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+    generation.mtimeNanoseconds = info.st_mtimespec.tv_nsec;
+#endif
+    return generation;
+}
+
+// Operator to compare two FileGenerations
+bool operator==(const FileGeneration &g1, const FileGeneration &g2) {
+    return g1.device == g2.device && g1.inode == g2.inode && g1.size == g2.size &&
+           g1.mtime == g2.mtime && g1.mtimeNanoseconds == g2.mtimeNanoseconds;
+}
+
+bool operator!=(const FileGeneration &g1, const FileGeneration &g2) {
+    return !(g1 == g2);
+}
+
+ConflictError::ConflictError(const std::string &fileName)
+    : std::runtime_error("Database changed by another process: " + fileName) {}
@@ -0,0 +1,54 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the FileLock class,
+ * FileGeneration struct and ConflictError exception, which coordinate
+ * several processes using the same database.
+ * A FileLock locks the file named after the database with '.lock' appended
+ * (the database itself is replaced on every save, so cannot hold the lock):
+ * shared while the database is read, so readers never wait for each other,
+ * and exclusive while it is written.
+ * A FileGeneration identifies one version of the database. A TodoList
+ * remembers the generation it loaded, and save refuses, with a
+ * ConflictError, to overwrite a database another process has saved since.
+ * Locks are not taken on Windows.
+*/
+
+
+#ifndef FILELOCK_H
+#define FILELOCK_H
+
+#include <stdexcept>
+#include <string>
+
+class FileLock {
+  int fd;
+
+public:
+  enum Mode { SHARED, EXCLUSIVE };
+
+  FileLock(const std::string &fileName, Mode mode);
+  FileLock(const FileLock &other) = delete;
+  FileLock &operator=(const FileLock &other) = delete;
+  ~FileLock();
+};
+
+struct FileGeneration {
+  unsigned long long device;
+  unsigned long long inode;
+  long long size;
+  long long mtime;
+  long long mtimeNanoseconds;
+
+  static FileGeneration of(const std::string &fileName);
+
+  friend bool operator==(const FileGeneration &g1, const FileGeneration &g2);
+  friend bool operator!=(const FileGeneration &g1, const FileGeneration &g2);
+};
+
+class ConflictError : public std::runtime_error {
+public:
+  explicit ConflictError(const std::string &fileName);
+};
+
+#endif // FILELOCK_H
@@ -0,0 +1,194 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the FileReader class.
+*/
+
+
+#include "filereader.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+
+const std::size_t FileReader::BUFFER_SIZE;
+const unsigned int FileReader::BUFFER_COUNT;
+
+
+// Open a file to read, returning -1 on failure
+static int openForReading(const std::string &fileName) {
+#ifdef _WIN32
+    return _open(fileName.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    return open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+// Read up to length bytes at an offset of a file, returning how many were
+// read, 0 at the end of the file or -1 on failure
+static long long readAt(int fd, char *data, std::size_t length, long long offset) {
+#ifdef _WIN32
+    // Only this thread reads the file, from start to end, so the file's own
+    // position is always at the offset
+    (void) offset;
+    return _read(fd, data, static_cast<unsigned int>(length));
+#else
+    return pread(fd, data, length, offset);
+#endif
+}
+
+/*
+    * Constructor to open a file and start reading it
+    * @param fileName: The file
+    * @param bufferSize: How many bytes each buffer holds
+    * @param bufferCount: How many buffers there are, at least 2 so that one
+    * can be filled while another is taken
+*/
+FileReader::FileReader(const std::string &fileName, std::size_t bufferSize,
+                       unsigned int bufferCount)
+    : fd(openForReading(fileName)), fileSize(0), bufferSize(bufferSize > 0 ? bufferSize : 1),
+      taken(-1), ended(false), error(0), stopping(false) {
+    if (fd < 0) {
+        return;
+    }
+    struct stat status;
+    if (fstat(fd, &status) == 0) {
+        fileSize = static_cast<std::size_t>(status.st_size);
+    }
+#ifdef __linux__
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    // No more buffers than the file fills, and one more to find its end
+    if (bufferCount < 2) {
+        bufferCount = 2;
+    }
+    const std::size_t needed = fileSize / this->bufferSize + 1;
+    if (needed < bufferCount) {
+        bufferCount = static_cast<unsigned int>(needed < 2 ? 2 : needed);
+    }
+    for (unsigned int i = 0; i < bufferCount; i++) {
+        buffers.emplace_back(new char[this->bufferSize]);
+        freeBuffers.push_back(bufferCount - 1 - i);
+    }
+    thread = std::thread(&FileReader::run, this);
+}
+
+// Destructor to stop reading, if the file has not all been taken, and close it
+FileReader::~FileReader() {
+    if (thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        thread.join();
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+// Function run by the reading thread, filling free buffers until the end
+void FileReader::run() {
+    long long offset = 0;
+    while (true) {
+        unsigned int buffer;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return stopping || !freeBuffers.empty(); });
+            if (stopping) {
+                return;
+            }
+            buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+        }
+
+        // A buffer is filled before it is handed over, unless the file ends
+        char *data = buffers[buffer].get();
+        std::size_t length = 0;
+        int failure = 0;
+        while (length < bufferSize) {
+            const long long count = readAt(fd, data + length, bufferSize - length, offset);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                failure = errno;
+                break;
+            }
+            if (count == 0) {
+                break;
+            }
+            length += static_cast<std::size_t>(count);
+            offset += count;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (length > 0) {
+                filled.push_back({buffer, length});
+            } else {
+                freeBuffers.push_back(buffer);
+            }
+            error = failure;
+            ended = failure != 0 || length < bufferSize;
+        }
+        changed.notify_all();
+        if (ended) {
+            return;
+        }
+    }
+}
+
+// Returns whether the file could be opened
+bool FileReader::isOpen() const noexcept {
+    return fd >= 0;
+}
+
+// Returns the size of the file when it was opened
+std::size_t FileReader::size() const noexcept {
+    return fileSize;
+}
+
+/*
+    * Function to take the next piece of the file, handing back the last
+    * piece taken, which must no longer be used
+    * @param data: Set to the piece
+    * @param length: Set to its length
+    * @return bool: False once the whole file has been taken
+    * @throws std::runtime_error: If the file could not be read
+*/
+bool FileReader::next(const char *&data, std::size_t &length) {
+    if (fd < 0) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    if (taken >= 0) {
+        freeBuffers.push_back(static_cast<unsigned int>(taken));
+        taken = -1;
+        changed.notify_all();
+    }
+    changed.wait(lock, [this] { return !filled.empty() || ended; });
+    if (filled.empty()) {
+        if (error != 0) {
+            throw std::runtime_error(std::string("Failed to read file: ") + std::strerror(error));
+        }
+        return false;
+    }
+    const Filled piece = filled.front();
+    filled.pop_front();
+    taken = static_cast<int>(piece.buffer);
+    data = buffers[piece.buffer].get();
+    length = piece.length;
+    return true;
+}
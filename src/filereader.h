@@ -0,0 +1,77 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the FileReader class.
+ * A FileReader reads a file from start to end on a thread of its own, into
+ * a fixed number of fixed-size buffers, while the thread that created it
+ * takes the buffers filled in turn (see next). A buffer is handed back to
+ * the reading thread when the next one is taken, so that at most
+ * bufferCount buffers are ever allocated and the reading thread only waits
+ * when every one is full and not yet taken. Reading a file from disk then
+ * overlaps with whatever is done with it, such as parsing it.
+ * On Linux the kernel is told the file will be read sequentially, so that
+ * it reads further ahead.
+*/
+
+
+#ifndef FILEREADER_H
+#define FILEREADER_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FileReader {
+public:
+  // The default size and number of the buffers
+  static const std::size_t BUFFER_SIZE = 1024 * 1024;
+  static const unsigned int BUFFER_COUNT = 4;
+
+private:
+  // A buffer the reading thread has filled, and how much of it
+  struct Filled {
+    unsigned int buffer;
+    std::size_t length;
+  };
+
+  int fd;
+  std::size_t fileSize;
+  std::size_t bufferSize;
+  std::vector<std::unique_ptr<char[]>> buffers;
+
+  // Buffers filled and not yet taken, in the order they were read, the
+  // buffers free to be filled, and the buffer last taken, if any
+  std::deque<Filled> filled;
+  std::vector<unsigned int> freeBuffers;
+  int taken;
+
+  // Whether the reading thread has reached the end of the file, the error
+  // it stopped on, if any, and whether it has been asked to stop
+  bool ended;
+  int error;
+  bool stopping;
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::thread thread;
+
+  void run();
+
+public:
+  explicit FileReader(const std::string &fileName, std::size_t bufferSize = BUFFER_SIZE,
+                      unsigned int bufferCount = BUFFER_COUNT);
+  FileReader(const FileReader &other) = delete;
+  FileReader &operator=(const FileReader &other) = delete;
+  ~FileReader();
+
+  bool isOpen() const noexcept;
+  std::size_t size() const noexcept;
+
+  bool next(const char *&data, std::size_t &length);
+};
+
+#endif // FILEREADER_H
@@ -0,0 +1,219 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the FlatObject class.
+*/
+
+
+#include "flatbuffer.h"
+
+#include <algorithm>
+
+
+// Function to add zero bytes until extra more would end on a multiple of align
+static void pad(String &buffer, std::size_t align, std::size_t extra = 0) {
+    while ((buffer.size() + extra) % align != 0) {
+        buffer += '\0';
+    }
+}
+
+// Function to overwrite four bytes of a buffer with a little-endian number
+static void put(String &buffer, std::size_t position, std::uint32_t value) {
+    for (unsigned int i = 0; i < 4; i++) {
+        buffer[position + i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+/*
+    * Constructor to create an empty object
+    * @param kind: Whether it is a table, vector, string or vector of structs
+*/
+FlatObject::FlatObject(Kind kind) : kind(kind), count(0), align(1) {}
+
+// Function to create a table with no fields set
+std::shared_ptr<FlatObject> FlatObject::table() {
+    return std::shared_ptr<FlatObject>(new FlatObject(TABLE));
+}
+
+/*
+    * Function to create a vector of tables
+    * @param elements: The tables
+*/
+FlatRef FlatObject::vector(const std::vector<FlatRef> &elements) {
+    std::shared_ptr<FlatObject> object(new FlatObject(VECTOR));
+    object->elements = elements;
+    return object;
+}
+
+/*
+    * Function to create a string
+    * @param s: The string, which is written followed by a NUL
+*/
+FlatRef FlatObject::string(const String &s) {
+    std::shared_ptr<FlatObject> object(new FlatObject(STRING));
+    object->bytes = s;
+    return object;
+}
+
+/*
+    * Function to create a vector of structs
+    * @param bytes: The structs, one after another, little-endian
+    * @param count: The number of structs
+    * @param align: The alignment of a struct
+*/
+FlatRef FlatObject::structs(const String &bytes, std::uint32_t count, unsigned int align) {
+    std::shared_ptr<FlatObject> object(new FlatObject(STRUCTS));
+    object->bytes = bytes;
+    object->count = count;
+    object->align = align;
+    return object;
+}
+
+// Function to get a field of a table, adding the slots up to it
+FlatObject::Field &FlatObject::field(unsigned int slot) {
+    if (fields.size() <= slot) {
+        fields.resize(slot + 1);
+    }
+    return fields[slot];
+}
+
+/*
+    * Function to set a scalar field of a table
+    * @param slot: The field's id in the schema
+    * @param bits: The value, as an unsigned number of size bytes
+    * @param size: 1, 2, 4 or 8
+    * @return The table, to set more fields
+*/
+FlatObject &FlatObject::scalar(unsigned int slot, std::uint64_t bits, unsigned int size) {
+    Field &f = field(slot);
+    f.size = size;
+    f.bits = bits;
+    return *this;
+}
+
+/*
+    * Function to set a field of a table to a table, vector or string
+    * @param slot: The field's id in the schema
+    * @param child: The object
+    * @return The table, to set more fields
+*/
+FlatObject &FlatObject::offset(unsigned int slot, const FlatRef &child) {
+    Field &f = field(slot);
+    f.size = 4;
+    f.child = child;
+    return *this;
+}
+
+/*
+    * Function to append a number to a string, least significant byte first
+    * @param s: The string
+    * @param bits: The number
+    * @param size: How many of its bytes to append
+*/
+void FlatObject::appendLittleEndian(String &s, std::uint64_t bits, unsigned int size) {
+    for (unsigned int i = 0; i < size; i++) {
+        s += static_cast<char>(bits >> (8 * i));
+    }
+}
+
+/*
+    * Function to write the object, and then its children, at the end of a
+    * buffer
+    * @param buffer: The buffer
+    * @return The position the object starts at, where offsets to it point
+*/
+std::size_t FlatObject::write(String &buffer) const {
+    std::vector<std::pair<std::size_t, const FlatObject *>> children;
+    std::size_t position = 0;
+
+    switch (kind) {
+        case TABLE: {
+            // Fields are laid out largest first, after the offset to the
+            // vtable, so none needs padding
+            std::vector<unsigned int> order;
+            for (unsigned int slot = 0; slot < fields.size(); slot++) {
+                if (fields[slot].size > 0) {
+                    order.push_back(slot);
+                }
+            }
+            std::stable_sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+                return fields[a].size > fields[b].size;
+            });
+            std::vector<std::uint16_t> offsets(fields.size(), 0);
+            std::size_t tableSize = 4;
+            std::size_t tableAlign = 4;
+            for (const unsigned int slot : order) {
+                offsets[slot] = static_cast<std::uint16_t>(tableSize);
+                tableSize += fields[slot].size;
+                tableAlign = std::max<std::size_t>(tableAlign, fields[slot].size);
+            }
+
+            const std::size_t vtableSize = 4 + 2 * fields.size();
+            pad(buffer, 2);
+            pad(buffer, tableAlign, vtableSize + 4);
+            const std::size_t vtable = buffer.size();
+            appendLittleEndian(buffer, vtableSize, 2);
+            appendLittleEndian(buffer, tableSize, 2);
+            for (const std::uint16_t offset : offsets) {
+                appendLittleEndian(buffer, offset, 2);
+            }
+
+            position = buffer.size();
+            appendLittleEndian(buffer, position - vtable, 4);
+            for (const unsigned int slot : order) {
+                const Field &f = fields[slot];
+                if (f.child) {
+                    children.emplace_back(buffer.size(), f.child.get());
+                    appendLittleEndian(buffer, 0, 4);
+                } else {
+                    appendLittleEndian(buffer, f.bits, f.size);
+                }
+            }
+            break;
+        }
+
+        case VECTOR:
+            pad(buffer, 4);
+            position = buffer.size();
+            appendLittleEndian(buffer, elements.size(), 4);
+            for (const FlatRef &element : elements) {
+                children.emplace_back(buffer.size(), element.get());
+                appendLittleEndian(buffer, 0, 4);
+            }
+            break;
+
+        case STRING:
+            pad(buffer, 4);
+            position = buffer.size();
+            appendLittleEndian(buffer, bytes.size(), 4);
+            buffer += bytes;
+            buffer += '\0';
+            break;
+
+        case STRUCTS:
+            pad(buffer, 4);
+            pad(buffer, align, 4);
+            position = buffer.size();
+            appendLittleEndian(buffer, count, 4);
+            buffer += bytes;
+            break;
+    }
+
+    for (const auto &child : children) {
+        const std::size_t target = child.second->write(buffer);
+        put(buffer, child.first, static_cast<std::uint32_t>(target - child.first));
+    }
+    return position;
+}
+
+/*
+    * Function to write a FlatBuffer with an object at its root
+    * @param root: The root table
+    * @return The buffer, padded to a multiple of 8 bytes
+*/
+String FlatObject::build(const FlatRef &root) {
+    String buffer(4, '\0');
+    put(buffer, 0, static_cast<std::uint32_t>(root->write(buffer)));
+    pad(buffer, 8);
+    return buffer;
+}
@@ -0,0 +1,66 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the FlatObject class.
+ * A FlatObject is a table, vector or string to be written in the
+ * FlatBuffers format (https://flatbuffers.dev), which Arrow uses for the
+ * metadata of its files. Only what the Arrow exporter needs is supported:
+ * tables of scalars and offsets, vectors of tables, strings and vectors of
+ * structs (given as their bytes).
+ * Objects are built up in memory and then written by build, which lays
+ * each table out with its vtable just before it and its children after it,
+ * so that every offset points forward as the format requires. Scalars are
+ * written little-endian whatever the host.
+*/
+
+
+#ifndef FLATBUFFER_H
+#define FLATBUFFER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "date.h"
+
+class FlatObject;
+using FlatRef = std::shared_ptr<const FlatObject>;
+
+class FlatObject {
+public:
+  static std::shared_ptr<FlatObject> table();
+  static FlatRef vector(const std::vector<FlatRef> &elements);
+  static FlatRef string(const String &s);
+  static FlatRef structs(const String &bytes, std::uint32_t count, unsigned int align);
+
+  FlatObject &scalar(unsigned int slot, std::uint64_t bits, unsigned int size);
+  FlatObject &offset(unsigned int slot, const FlatRef &child);
+
+  static void appendLittleEndian(String &s, std::uint64_t bits, unsigned int size);
+  static String build(const FlatRef &root);
+
+private:
+  enum Kind { TABLE, VECTOR, STRING, STRUCTS };
+
+  // A field of a table: a scalar of size bytes, or an offset to child. A
+  // field of size 0 is left out.
+  struct Field {
+    unsigned int size = 0;
+    std::uint64_t bits = 0;
+    FlatRef child;
+  };
+
+  Kind kind;
+  std::vector<Field> fields;
+  std::vector<FlatRef> elements;
+  String bytes;
+  std::uint32_t count;
+  unsigned int align;
+
+  explicit FlatObject(Kind kind);
+
+  Field &field(unsigned int slot);
+  std::size_t write(String &buffer) const;
+};
+
+#endif // FLATBUFFER_H
@@ -0,0 +1,442 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the JsonWriter class.
+*/
+
+
+#include "jsonwriter.h"
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+using Json = nlohmann::json;
+
+
+const std::size_t JsonWriter::BUFFER_SIZE;
+
+/*
+    * Constructor to create a JsonWriter printing to a stream
+    * @param out: The stream to print to
+    * @param style: COMPACT for no whitespace, PRETTY for one value per line
+*/
+JsonWriter::JsonWriter(std::ostream &out, Style style)
+    : out(out), style(style), afterKey(false) {
+    buffer.reserve(BUFFER_SIZE + BUFFER_SIZE / 4);
+}
+
+// Destructor, printing whatever is still held
+JsonWriter::~JsonWriter() {
+    flush();
+}
+
+// Function to print what is held to the stream
+void JsonWriter::flush() {
+    if (!buffer.empty()) {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+
+// Function to return the style the JSON is written in
+JsonWriter::Style JsonWriter::getStyle() const noexcept {
+    return style;
+}
+
+// Function to print what is held once there is a buffer's worth
+void JsonWriter::flushIfFull() {
+    if (buffer.size() >= BUFFER_SIZE) {
+        flush();
+    }
+}
+
+// Function to start a new line at the depth being written, when pretty
+void JsonWriter::indent() {
+    if (style == PRETTY) {
+        buffer += '\n';
+        buffer.append(4 * empty.size(), ' ');
+    }
+}
+
+// Function to separate a key, or a value in an array, from the one before
+void JsonWriter::separate() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (empty.empty()) {
+        return;
+    }
+    if (!empty.back()) {
+        buffer += ',';
+    }
+    empty.back() = false;
+    indent();
+}
+
+// Function to write a string in quotes, escaping it as nlohmann::json does
+void JsonWriter::string(const String &s) {
+    buffer += '"';
+    appendEscaped(buffer, s);
+    buffer += '"';
+}
+
+// Function to start an object, ended by endObject
+void JsonWriter::beginObject() {
+    separate();
+    buffer += '{';
+    empty.push_back(true);
+}
+
+// Function to end the object started last
+void JsonWriter::endObject() {
+    const bool wasEmpty = empty.back();
+    empty.pop_back();
+    if (!wasEmpty) {
+        indent();
+    }
+    buffer += '}';
+    flushIfFull();
+}
+
+// Function to start an array, ended by endArray
+void JsonWriter::beginArray() {
+    separate();
+    buffer += '[';
+    empty.push_back(true);
+}
+
+// Function to end the array started last
+void JsonWriter::endArray() {
+    const bool wasEmpty = empty.back();
+    empty.pop_back();
+    if (!wasEmpty) {
+        indent();
+    }
+    buffer += ']';
+    flushIfFull();
+}
+
+/*
+    * Function to write the key of the next value in an object
+    * @param name: The key
+*/
+void JsonWriter::key(const String &name) {
+    separate();
+    string(name);
+    buffer += style == PRETTY ? ": " : ":";
+    afterKey = true;
+}
+
+/*
+    * Function to write a string value
+    * @param s: The value
+*/
+void JsonWriter::value(const String &s) {
+    separate();
+    string(s);
+    flushIfFull();
+}
+
+// Function to write a string value, rather than taking it as a boolean
+void JsonWriter::value(const char *s) {
+    value(String(s));
+}
+
+/*
+    * Function to write a boolean value
+    * @param b: The value
+*/
+void JsonWriter::value(bool b) {
+    separate();
+    buffer += b ? "true" : "false";
+}
+
+/*
+    * Function to write an integer value
+    * @param n: The value
+*/
+void JsonWriter::number(long long n) {
+    separate();
+    buffer += std::to_string(n);
+}
+
+// Function to write an unsigned integer value
+void JsonWriter::number(unsigned long long n) {
+    separate();
+    buffer += std::to_string(n);
+}
+
+// Function to write a null value
+void JsonWriter::null() {
+    separate();
+    buffer += "null";
+}
+
+/*
+    * Function to write a value that is already compact JSON. A value of more
+    * than a quarter of the buffer is printed straight from where it is,
+    * after what is held, rather than copied into the buffer.
+    * @param json: The JSON of the value
+*/
+void JsonWriter::fragment(const String &json) {
+    separate();
+    if (json.size() < BUFFER_SIZE / 4) {
+        buffer += json;
+        flushIfFull();
+    } else {
+        flush();
+        out.write(json.data(), json.size());
+    }
+}
+
+// Function to end a line, after each of several values written one per line
+void JsonWriter::endLine() {
+    buffer += '\n';
+    flushIfFull();
+}
+
+// A function returning the first byte from begin that needs escaping or
+// starts a multibyte character, or end
+using FindFunction = const char *(*)(const char *begin, const char *end);
+
+// Returns whether a byte has to be escaped in a JSON string, or checked to
+// be part of valid UTF-8
+static inline bool needsEscape(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\' || c >= 0x80;
+}
+
+// Function to find the next byte to escape a byte at a time
+static const char *findScalar(const char *p, const char *end) {
+    while (p < end && !needsEscape(static_cast<unsigned char>(*p))) {
+        p++;
+    }
+    return p;
+}
+
+#ifdef SIMD_X86
+// Function to find the next byte to escape 16 bytes at a time
+__attribute__((target("sse2"))) static const char *findSse2(const char *p, const char *end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1f);
+    for (; end - p >= 16; p += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        // a byte is a control character if it is its minimum with 0x1f, and
+        // part of a multibyte character if its top bit is set
+        const __m128i found = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)),
+            _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(bytes, control), bytes), bytes));
+        const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(found));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return findScalar(p, end);
+}
+
+// Function to find the next byte to escape 32 bytes at a time
+__attribute__((target("avx2"))) static const char *findAvx2(const char *p, const char *end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1f);
+    for (; end - p >= 32; p += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        const __m256i found = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, quote), _mm256_cmpeq_epi8(bytes, backslash)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(bytes, control), bytes), bytes));
+        const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(found));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return findSse2(p, end);
+}
+#endif
+
+// Returns the escaper in use, the fastest the CPU supports unless set
+static std::atomic<Simd::Level> &escaperInUse() noexcept {
+    static std::atomic<Simd::Level> level(Simd::best());
+    return level;
+}
+
+// Returns the function finding the next byte to escape with the escaper in use
+static FindFunction findFunction() noexcept {
+#ifdef SIMD_X86
+    switch (escaperInUse().load(std::memory_order_relaxed)) {
+        case Simd::AVX2:
+            return findAvx2;
+        case Simd::SSE2:
+            return findSse2;
+        default:
+            break;
+    }
+#endif
+    return findScalar;
+}
+
+// Returns the escaper in use
+Simd::Level JsonWriter::getEscaper() noexcept {
+    return escaperInUse();
+}
+
+/*
+    * Function to choose the escaper to use, e.g. to compare them
+    * @param level: The escaper
+    * @return Whether the CPU supports it; if not, the escaper is unchanged
+*/
+bool JsonWriter::setEscaper(Simd::Level level) noexcept {
+    if (!Simd::supported(level)) {
+        return false;
+    }
+    escaperInUse() = level;
+    return true;
+}
+
+/*
+    * Function to check the UTF-8 character starting at a byte, as
+    * nlohmann::json checks strings before it dumps them
+    * @param s: The string
+    * @param p: The first byte of the character, 0x80 or more
+    * @return The byte after the character
+    * @throws Json::type_error: 316 if the character is not valid UTF-8,
+    * with the same message as Json::dump
+*/
+static const char *checkUtf8(const String &s, const char *p) {
+    const unsigned char *const bytes = reinterpret_cast<const unsigned char *>(s.data());
+    const std::size_t start = p - s.data();
+    const unsigned char c = bytes[start];
+    std::size_t size = 0;
+    unsigned char low = 0x80;
+    unsigned char high = 0xbf;
+    if (c >= 0xc2 && c <= 0xdf) {
+        size = 2;
+    } else if (c >= 0xe0 && c <= 0xef) {
+        // no overlong encodings or surrogates
+        size = 3;
+        low = c == 0xe0 ? 0xa0 : 0x80;
+        high = c == 0xed ? 0x9f : 0xbf;
+    } else if (c >= 0xf0 && c <= 0xf4) {
+        size = 4;
+        low = c == 0xf0 ? 0x90 : 0x80;
+        high = c == 0xf4 ? 0x8f : 0xbf;
+    }
+    std::size_t i = start + 1;
+    for (; size > 0 && i < start + size && i < s.size(); i++) {
+        if (bytes[i] < low || bytes[i] > high) {
+            break;
+        }
+        low = 0x80;
+        high = 0xbf;
+    }
+    if (size > 0 && i == start + size) {
+        return s.data() + i;
+    }
+
+    char hex[3];
+    if (size > 0 && i == s.size()) {
+        std::snprintf(hex, sizeof(hex), "%.2X", bytes[i - 1]);
+        throw Json::type_error::create(316, std::string("incomplete UTF-8 string; last byte: 0x") + hex,
+                                       Json());
+    }
+    if (size == 0) {
+        i = start;
+    }
+    std::snprintf(hex, sizeof(hex), "%.2X", bytes[i]);
+    throw Json::type_error::create(316, "invalid UTF-8 byte at index " + std::to_string(i) +
+                                   ": 0x" + hex, Json());
+}
+
+/*
+    * Function to work out the length of a string once escaped, without quotes
+    * @param s: The string
+    * @return The number of bytes appendEscaped appends
+*/
+std::size_t JsonWriter::escapedLength(const String &s) noexcept {
+    const FindFunction find = findFunction();
+    const char *p = s.data();
+    const char *const end = p + s.size();
+    std::size_t length = s.size();
+    while ((p = find(p, end)) != end) {
+        if (static_cast<unsigned char>(*p) >= 0x80) {
+            // copied as it is
+            p++;
+            continue;
+        }
+        switch (*p) {
+            case '"':
+            case '\\':
+            case '\b':
+            case '\f':
+            case '\n':
+            case '\r':
+            case '\t':
+                length += 1;
+                break;
+            default:
+                length += 5;
+        }
+        p++;
+    }
+    return length;
+}
+
+/*
+    * Function to append a string, escaped as nlohmann::json escapes it, but
+    * without quotes
+    * @param out: The string to append to
+    * @param s: The string to escape
+    * @throws Json::type_error: 316 if the string is not valid UTF-8, as
+    * Json::dump throws, in which case some of it may have been appended
+*/
+void JsonWriter::appendEscaped(String &out, const String &s) {
+    static const char HEX[] = "0123456789abcdef";
+    const FindFunction find = findFunction();
+    const char *p = s.data();
+    const char *const end = p + s.size();
+    while (p < end) {
+        const char *const next = find(p, end);
+        out.append(p, next - p);
+        if (next == end) {
+            break;
+        }
+        if (static_cast<unsigned char>(*next) >= 0x80) {
+            p = checkUtf8(s, next);
+            out.append(next, p - next);
+            continue;
+        }
+        switch (*next) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                out += "\\u00";
+                out += HEX[*next >> 4];
+                out += HEX[*next & 0xf];
+        }
+        p = next + 1;
+    }
+}
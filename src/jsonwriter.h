@@ -0,0 +1,84 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the JsonWriter class.
+ * A JsonWriter prints JSON to a stream as it is produced, without building
+ * a Json or String of the whole document first, so that printing a large
+ * TodoList takes no more memory than its buffer. Tasks, projects and
+ * TodoLists write themselves to one (see their write functions).
+ * Strings are escaped as nlohmann::json escapes them, and the PRETTY style
+ * indents by four spaces like Json::dump(4), so the output is the same as
+ * dumping the Json representation, except that keys are in the order they
+ * are written rather than sorted.
+ * Escaping is shared with the str() functions of tasks and projects. It
+ * looks for the bytes that need escaping (quotes, backslashes and control
+ * characters) or checking (those of multibyte characters, which have to be
+ * valid UTF-8 as Json::dump requires) 32 bytes at a time with AVX2, or 16 at
+ * a time with SSE2, and copies the runs between them whole. The fastest the CPU supports is used
+ * (see Simd), falling back to a byte at a time elsewhere.
+ * JSON that has already been written, such as a Project's (see
+ * Project::compactJson), can be printed as a value with fragment. A large
+ * one is handed to the stream as it is, without being copied into the
+ * buffer first.
+*/
+
+
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <ostream>
+#include <vector>
+
+#include "date.h"
+#include "simd.h"
+
+class JsonWriter {
+public:
+  enum Style { COMPACT, PRETTY };
+
+  // How much is held before it is written to the stream
+  static const std::size_t BUFFER_SIZE = 1 << 16;
+
+  explicit JsonWriter(std::ostream &out, Style style = COMPACT);
+  JsonWriter(const JsonWriter &other) = delete;
+  JsonWriter &operator=(const JsonWriter &other) = delete;
+  ~JsonWriter();
+
+  void beginObject();
+  void endObject();
+  void beginArray();
+  void endArray();
+  void key(const String &name);
+  void value(const String &s);
+  void value(const char *s);
+  void value(bool b);
+  void number(long long n);
+  void number(unsigned long long n);
+  void null();
+  void fragment(const String &json);
+  void endLine();
+  void flush();
+  Style getStyle() const noexcept;
+
+  static std::size_t escapedLength(const String &s) noexcept;
+  static void appendEscaped(String &out, const String &s);
+  static Simd::Level getEscaper() noexcept;
+  static bool setEscaper(Simd::Level level) noexcept;
+
+private:
+  std::ostream &out;
+  Style style;
+  String buffer;
+
+  // For each object or array being written, whether it is still empty
+  std::vector<bool> empty;
+  // Set after a key, whose value follows without a separator
+  bool afterKey;
+
+  void separate();
+  void indent();
+  void string(const String &s);
+  void flushIfFull();
+};
+
+#endif // JSONWRITER_H
@@ -0,0 +1,39 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the Owner class.
+ * An Owner is a non-owning back pointer from an object to the container it
+ * is stored in (e.g. from a Task to its Project). Copying or moving the object
+ * never carries the pointer across, so a copy taken out of a container is
+ * always detached. Containers rebind their members whenever they may have
+ * been relocated (see Project::bindTasks and TodoList::bindProjects).
+*/
+
+
+#ifndef OWNER_H
+#define OWNER_H
+
+template <typename T>
+class Owner {
+  T *ptr = nullptr;
+
+public:
+  Owner() = default;
+  ~Owner() = default;
+
+  // A copied or moved-to object starts detached...
+  Owner(const Owner &) noexcept {}
+  Owner(Owner &&) noexcept {}
+
+  // ...and an assigned-to object keeps the container it already lives in.
+  Owner &operator=(const Owner &) noexcept { return *this; }
+  Owner &operator=(Owner &&) noexcept { return *this; }
+
+  void bind(T *owner) noexcept { ptr = owner; }
+
+  T *get() const noexcept { return ptr; }
+  T *operator->() const noexcept { return ptr; }
+  explicit operator bool() const noexcept { return ptr != nullptr; }
+};
+
+#endif // OWNER_H
@@ -0,0 +1,425 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the PrefixIndex and
+ * Completions classes.
+*/
+
+
+#include "prefixindex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+// Number of strings in each front coded block
+static const std::uint32_t BLOCK_SIZE = 16;
+
+// Identifies a Completions file, and the version of its layout
+static const char COMPLETIONS_MAGIC[8] = {'T', 'O', 'D', 'O', 'C', 'M', 'P', 1};
+
+// Separates the project and task identifiers in the task index
+static const char TASK_SEPARATOR = '\x1f';
+
+
+// Append an unsigned integer to a string in 7 bit groups
+static void putVarint(String &out, std::uint32_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+// Read an unsigned integer written by putVarint
+static std::uint32_t getVarint(const char *&cursor) {
+    std::uint32_t value = 0;
+    unsigned int shift = 0;
+    unsigned char byte;
+    do {
+        byte = static_cast<unsigned char>(*cursor++);
+        value |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+// Append a fixed width unsigned integer to a string
+static void putFixed(String &out, std::uint32_t value) {
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+// Read a fixed width unsigned integer, which may not be aligned
+static std::uint32_t getFixed(const char *cursor) {
+    std::uint32_t value;
+    std::memcpy(&value, cursor, sizeof(value));
+    return value;
+}
+
+
+// Constructor to create an empty PrefixIndex
+PrefixIndex::PrefixIndex()
+    : bytes(nullptr), count(0), numBlocks(0), dataSize(0), offsets(nullptr),
+      data(nullptr) {}
+
+/*
+    * Constructor to build a PrefixIndex from a list of strings
+    * @param strings: The strings, in any order and possibly repeated
+*/
+PrefixIndex::PrefixIndex(std::vector<String> strings) : PrefixIndex() {
+    std::sort(strings.begin(), strings.end());
+    strings.erase(std::unique(strings.begin(), strings.end()), strings.end());
+
+    std::vector<std::uint32_t> blocks;
+    String encoded;
+    for (std::size_t i = 0; i < strings.size(); i++) {
+        const String &s = strings[i];
+        if (i % BLOCK_SIZE == 0) {
+            blocks.push_back(static_cast<std::uint32_t>(encoded.size()));
+            putVarint(encoded, s.size());
+            encoded += s;
+        } else {
+            const String &previous = strings[i - 1];
+            std::size_t shared = 0;
+            while (shared < s.size() && shared < previous.size() && s[shared] == previous[shared]) {
+                shared++;
+            }
+            putVarint(encoded, shared);
+            putVarint(encoded, s.size() - shared);
+            encoded.append(s, shared, String::npos);
+        }
+    }
+
+    putFixed(storage, strings.size());
+    putFixed(storage, blocks.size());
+    putFixed(storage, encoded.size());
+    for (std::uint32_t offset : blocks) {
+        putFixed(storage, offset);
+    }
+    storage += encoded;
+    attach(storage.data(), storage.size());
+}
+
+// Copy constructor
+PrefixIndex::PrefixIndex(const PrefixIndex &other) : PrefixIndex() {
+    *this = other;
+}
+
+// Copy assignment, an owned index is copied and a view is shared
+PrefixIndex &PrefixIndex::operator=(const PrefixIndex &other) {
+    if (this == &other) {
+        return *this;
+    }
+    storage = other.storage;
+    if (other.bytes != nullptr && other.bytes == other.storage.data()) {
+        attach(storage.data(), storage.size());
+    } else {
+        bytes = other.bytes;
+        count = other.count;
+        numBlocks = other.numBlocks;
+        dataSize = other.dataSize;
+        offsets = other.offsets;
+        data = other.data;
+    }
+    return *this;
+}
+
+/*
+    * Function to point the index at a serialised index
+    * @param begin: The start of the serialised index
+    * @param size: The number of bytes available
+    * @return bool: True if the bytes hold a complete index
+*/
+bool PrefixIndex::attach(const char *begin, std::size_t size) {
+    if (size < 3 * sizeof(std::uint32_t)) {
+        return false;
+    }
+    std::uint32_t c = getFixed(begin);
+    std::uint32_t b = getFixed(begin + 4);
+    std::uint32_t d = getFixed(begin + 8);
+    if (b != (c + BLOCK_SIZE - 1) / BLOCK_SIZE ||
+        size < 3 * sizeof(std::uint32_t) + std::size_t(b) * sizeof(std::uint32_t) + d) {
+        return false;
+    }
+    bytes = begin;
+    count = c;
+    numBlocks = b;
+    dataSize = d;
+    offsets = begin + 3 * sizeof(std::uint32_t);
+    data = offsets + std::size_t(b) * sizeof(std::uint32_t);
+    return true;
+}
+
+/*
+    * Function to read an index from serialised bytes without copying them;
+    * the bytes must outlive the index
+    * @param cursor: The start of the index, moved past it on success
+    * @param end: The end of the available bytes
+    * @param index: Set to the index read
+    * @return bool: True if a complete index was read
+*/
+bool PrefixIndex::view(const char *&cursor, const char *end, PrefixIndex &index) {
+    PrefixIndex result;
+    if (!result.attach(cursor, end - cursor)) {
+        return false;
+    }
+    cursor = result.data + result.dataSize;
+    index = result;
+    return true;
+}
+
+// Function to return the serialised form of the index
+String PrefixIndex::serialised() const {
+    if (bytes == nullptr) {
+        return PrefixIndex(std::vector<String>()).serialised();
+    }
+    return String(bytes, data + dataSize);
+}
+
+// Returns the position of a block in the encoded strings
+std::uint32_t PrefixIndex::blockOffset(std::uint32_t block) const {
+    return getFixed(offsets + std::size_t(block) * sizeof(std::uint32_t));
+}
+
+// Function to return the number of strings in the index
+unsigned int PrefixIndex::size() const noexcept {
+    return count;
+}
+
+/*
+    * Function to find the strings starting with a prefix
+    * @param prefix: The prefix
+    * @param limit: The largest number of strings to return
+    * @return std::vector<String>: The first strings starting with the prefix,
+    * in sorted order
+*/
+std::vector<String> PrefixIndex::complete(const String &prefix, unsigned int limit) const {
+    std::vector<String> result;
+    if (count == 0 || limit == 0) {
+        return result;
+    }
+
+    // Find the first block whose first string is not less than the prefix
+    std::uint32_t low = 0, high = numBlocks;
+    while (low < high) {
+        std::uint32_t mid = low + (high - low) / 2;
+        const char *cursor = data + blockOffset(mid);
+        std::uint32_t length = getVarint(cursor);
+        if (prefix.compare(0, String::npos, cursor, length) > 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    // The matches may start at the end of the block before it
+    std::uint32_t block = low > 0 ? low - 1 : 0;
+    const char *cursor = data + blockOffset(block);
+    String current;
+    for (std::uint32_t i = block * BLOCK_SIZE; i < count; i++) {
+        if (i % BLOCK_SIZE == 0) {
+            std::uint32_t length = getVarint(cursor);
+            current.assign(cursor, length);
+            cursor += length;
+        } else {
+            std::uint32_t shared = getVarint(cursor);
+            std::uint32_t length = getVarint(cursor);
+            current.resize(shared);
+            current.append(cursor, length);
+            cursor += length;
+        }
+
+        int order = current.compare(0, prefix.size(), prefix);
+        if (order == 0) {
+            result.push_back(current);
+            if (result.size() == limit) {
+                break;
+            }
+        } else if (order > 0) {
+            break;
+        }
+    }
+    return result;
+}
+
+
+// Constructor to create empty completions
+Completions::Completions() : mapping(nullptr), mappingSize(0) {}
+
+/*
+    * Function to build the completions for a TodoList
+    * @param tl: The TodoList
+*/
+void Completions::build(const TodoList &tl) {
+    std::vector<String> projectKeys, taskKeys, tagKeys;
+    projectKeys.reserve(tl.size());
+    taskKeys.reserve(tl.getStats().numTasks());
+    for (const Project &project : tl.getProjects()) {
+        projectKeys.push_back(project.getIdent());
+        for (const Task &task : project.getTasks()) {
+            taskKeys.push_back(project.getIdent() + TASK_SEPARATOR + task.getIdent());
+        }
+    }
+    for (const auto &tag : tl.getStats().getTagCounts()) {
+        tagKeys.push_back(tag.first);
+    }
+    unmap();
+    buffer.clear();
+    projects = PrefixIndex(std::move(projectKeys));
+    tasks = PrefixIndex(std::move(taskKeys));
+    tags = PrefixIndex(std::move(tagKeys));
+}
+
+// Destructor, releases the mapped file
+Completions::~Completions() {
+    unmap();
+}
+
+// Release the mapped file, if any
+void Completions::unmap() noexcept {
+#ifndef _WIN32
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+    }
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
+/*
+    * Function to load the completions saved next to a database file (as
+    * fileName + ".complete"). The file is mapped into memory rather than
+    * read, so only the parts needed by a lookup are touched. Saves replace
+    * the file rather than writing over it, so the mapping stays valid.
+    * @param fileName: The name of the database file
+    * @return bool: True if the completions were loaded, false if they are
+    * missing, unreadable or older than the database file
+*/
+bool Completions::load(const String &fileName) {
+    const String path = fileName + ".complete";
+    FileLock lock(fileName, FileLock::SHARED);
+    const String signature = TodoList::fileSignature(FileGeneration::of(fileName)).dump();
+    unmap();
+    buffer.clear();
+
+    const char *begin;
+    std::size_t size;
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    mappingSize = info.st_size;
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        mappingSize = 0;
+        return false;
+    }
+    begin = static_cast<const char *>(mapping);
+    size = mappingSize;
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    begin = buffer.data();
+    size = buffer.size();
+#endif
+
+    const char *end = begin + size;
+    const char *cursor = begin;
+    if (size < sizeof(COMPLETIONS_MAGIC) + sizeof(std::uint32_t) ||
+        std::memcmp(cursor, COMPLETIONS_MAGIC, sizeof(COMPLETIONS_MAGIC)) != 0) {
+        return false;
+    }
+    cursor += sizeof(COMPLETIONS_MAGIC);
+    std::uint32_t length = getFixed(cursor);
+    cursor += sizeof(std::uint32_t);
+    if (std::size_t(end - cursor) < length || signature.compare(0, String::npos, cursor, length) != 0) {
+        return false;
+    }
+    cursor += length;
+    return PrefixIndex::view(cursor, end, projects) &&
+           PrefixIndex::view(cursor, end, tasks) &&
+           PrefixIndex::view(cursor, end, tags);
+}
+
+/*
+    * Function to save the completions next to a database file (as
+    * fileName + ".complete"), labelled with the generation of the database
+    * they were built from. They are written to a temporary file that then
+    * replaces the old completions, with the database locked. Nothing is
+    * written if the database has been saved since.
+    * @param fileName: The name of the database file
+    * @param &generation: The generation of the database file when the
+    * TodoList the completions were built from was loaded or saved
+*/
+void Completions::save(const String &fileName, const FileGeneration &generation) const {
+    FileLock lock(fileName, FileLock::EXCLUSIVE);
+    if (FileGeneration::of(fileName) != generation) {
+        return;
+    }
+    const String signature = TodoList::fileSignature(generation).dump();
+    String header(COMPLETIONS_MAGIC, sizeof(COMPLETIONS_MAGIC));
+    putFixed(header, signature.size());
+    header += signature;
+
+    const String path = fileName + ".complete";
+    const String temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("File not found");
+        }
+        file << header << projects.serialised() << tasks.serialised() << tags.serialised();
+        if (!file) {
+            file.close();
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Failed to write " + temporary);
+        }
+    }
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Failed to replace " + path);
+    }
+}
+
+// Function to return the project identifiers starting with a prefix
+std::vector<String> Completions::projectIdents(const String &prefix, unsigned int limit) const {
+    return projects.complete(prefix, limit);
+}
+
+// Function to return the identifiers of the tasks in a project starting with a prefix
+std::vector<String> Completions::taskIdents(const String &pIdent, const String &prefix,
+                                            unsigned int limit) const {
+    const String key = pIdent + TASK_SEPARATOR;
+    std::vector<String> result = tasks.complete(key + prefix, limit);
+    for (String &tIdent : result) {
+        tIdent.erase(0, key.size());
+    }
+    return result;
+}
+
+// Function to return the tags in use starting with a prefix
+std::vector<String> Completions::tagNames(const String &prefix, unsigned int limit) const {
+    return tags.complete(prefix, limit);
+}
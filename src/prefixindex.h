@@ -0,0 +1,78 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the PrefixIndex and
+ * Completions classes.
+ * A PrefixIndex is a sorted array of strings stored with front coding: the
+ * strings are grouped in blocks of 16, the first string of each block is
+ * stored in full and every other string only as the length of the prefix it
+ * shares with the string before it plus the remaining characters. Finding
+ * the strings starting with a prefix is a binary search over the blocks
+ * followed by decoding at most a few blocks.
+ * Completions holds the prefix indexes used by the complete action (project
+ * identifiers, task identifiers within each project and tags), saved to a
+ * file next to the database that can be searched without being parsed.
+*/
+
+
+#ifndef PREFIXINDEX_H
+#define PREFIXINDEX_H
+
+#include <cstdint>
+
+#include "todolist.h"
+
+class PrefixIndex {
+  // The serialised index, either owned by 'storage' or inside a Completions
+  // file mapped into memory.
+  String storage;
+  const char *bytes;
+  std::uint32_t count, numBlocks, dataSize;
+  const char *offsets, *data;
+
+  std::uint32_t blockOffset(std::uint32_t block) const;
+  bool attach(const char *begin, std::size_t size);
+
+public:
+  PrefixIndex();
+  explicit PrefixIndex(std::vector<String> strings);
+  PrefixIndex(const PrefixIndex &other);
+  PrefixIndex &operator=(const PrefixIndex &other);
+  ~PrefixIndex() = default;
+
+  static bool view(const char *&cursor, const char *end, PrefixIndex &index);
+  String serialised() const;
+
+  unsigned int size() const noexcept;
+  std::vector<String> complete(const String &prefix, unsigned int limit) const;
+};
+
+class Completions {
+  PrefixIndex projects;
+  PrefixIndex tasks;
+  PrefixIndex tags;
+
+  // The mapped Completions file, if loaded from one
+  void *mapping;
+  std::size_t mappingSize;
+  String buffer;
+
+  void unmap() noexcept;
+
+public:
+  Completions();
+  Completions(const Completions &other) = delete;
+  Completions &operator=(const Completions &other) = delete;
+  ~Completions();
+
+  void build(const TodoList &tl);
+  bool load(const String &fileName);
+  void save(const String &fileName, const FileGeneration &generation) const;
+
+  std::vector<String> projectIdents(const String &prefix, unsigned int limit) const;
+  std::vector<String> taskIdents(const String &pIdent, const String &prefix,
+                                 unsigned int limit) const;
+  std::vector<String> tagNames(const String &prefix, unsigned int limit) const;
+};
+
+#endif // PREFIXINDEX_H
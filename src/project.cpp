@@ -6,9 +6,89 @@
 
 
 #include "project.h"
+#include "jsonwriter.h"
+#include "todolist.h"
+
+#include <algorithm>
+#include <sstream>
 
 // Constructor to create a Project object with an identifier
-Project::Project(String ident) : ident(ident) {}
+Project::Project(String ident) : ident(ident), generation(0) {}
+
+// Copy constructor, the copy is not part of any TodoList but keeps the JSON
+// already written for the tasks
+Project::Project(const Project &other)
+    : ident(other.ident), tasks(other.tasks), stats(other.stats),
+      generation(other.generation), fragment(std::atomic_load(&other.fragment)) {
+    bindTasks();
+}
+
+// Move constructor, the tasks now belong to this object
+Project::Project(Project &&other) noexcept
+    : ident(std::move(other.ident)), tasks(std::move(other.tasks)),
+      stats(std::move(other.stats)), generation(other.generation),
+      fragment(std::atomic_load(&other.fragment)), published(std::move(other.published)) {
+    bindTasks();
+}
+
+// Copy assignment, this object stays in the TodoList it already belongs to
+Project &Project::operator=(const Project &other) {
+    if (this != &other) {
+        ident = other.ident;
+        tasks = other.tasks;
+        stats = other.stats;
+        bindTasks();
+        generation = std::max(generation, other.generation);
+        changed();
+    }
+    return *this;
+}
+
+// Move assignment, this object stays in the TodoList it already belongs to
+Project &Project::operator=(Project &&other) noexcept {
+    if (this != &other) {
+        ident = std::move(other.ident);
+        tasks = std::move(other.tasks);
+        stats = std::move(other.stats);
+        bindTasks();
+        generation = std::max(generation, other.generation);
+        changed();
+    }
+    return *this;
+}
+
+// Function to mark the JSON written for the tasks as out of date, called
+// by every change to the Project or one of its tasks
+void Project::changed() noexcept {
+    generation++;
+}
+
+// Point every task back at this Project, after they may have been relocated
+void Project::bindTasks() noexcept {
+    for (Task &tObj : tasks) {
+        tObj.project.bind(this);
+    }
+}
+
+// Function to add a task to the end of the container and start counting it
+void Project::pushTask(const Task &task) {
+    changed();
+    auto capacity = tasks.capacity();
+    tasks.push_back(task);
+    if (tasks.capacity() != capacity) {
+        bindTasks();
+    } else {
+        tasks.back().project.bind(this);
+    }
+    stats.addTask(task);
+    if (list) {
+        list->stats.addTask(task);
+        list->changes.taskCreated(ident, task);
+        if (list->index) {
+            list->index->addTask(ident, task.getIdent());
+        }
+    }
+}
 
 // Function to return the number of tasks in the Project object
 unsigned int Project::size() const noexcept{
@@ -21,7 +101,14 @@ const String& Project::getIdent() const noexcept {
 }
 
 // Function to set the identifier of the Project object
-void Project::setIdent(String pIdent) noexcept {
+void Project::setIdent(String pIdent) {
+    if (list) {
+        list->changes.projectRenamed(ident, pIdent);
+        if (list->index) {
+            list->index->renameProject(*this, pIdent);
+        }
+    }
+    changed();
     ident = pIdent;
 }
 
@@ -35,7 +122,7 @@ Task &Project::newTask(const String &tIdent) {
     if (containsTask(tIdent)) {
         return getTask(tIdent);
     }
-    tasks.push_back(tObj);
+    pushTask(tObj);
     return tasks.back();
 }
 
@@ -57,7 +144,7 @@ bool Project::addTask(Task task) {
         tObj.setDueDate(task.getDueDate());
         return false;
     }
-    tasks.push_back(task);
+    pushTask(task);
     return true;
 }
 
@@ -85,6 +172,15 @@ Task &Project::getTask(const String &tIdent) {
 bool Project::deleteTask(const String &tIdent) {
     for (auto it = tasks.begin(); it != tasks.end(); ++it) {
         if (it->getIdent() == tIdent) {
+            stats.removeTask(*it);
+            if (list) {
+                list->stats.removeTask(*it);
+                list->changes.taskDeleted(ident, tIdent);
+                if (list->index) {
+                    list->index->removeTask(ident, tIdent);
+                }
+            }
+            changed();
             tasks.erase(it);
             return true;
         }
@@ -92,24 +188,152 @@ bool Project::deleteTask(const String &tIdent) {
     throw NoTaskError(tIdent);
 }
 
+// Function to return the counters over the tasks in the Project object
+const Stats &Project::getStats() const noexcept {
+    return stats;
+}
+
+// Function to return the number of changes made to the Project object and
+// its tasks, for telling whether JSON written from it is still current
+unsigned long Project::getGeneration() const noexcept {
+    return generation;
+}
+
+/*
+    * Function to return the compact JSON of the tasks, as write prints it,
+    * written again only if the Project or one of its tasks has changed
+    * since it was last written
+    * @return std::shared_ptr<const String>: The JSON, which stays valid
+    * while the pointer is held
+*/
+std::shared_ptr<const String> Project::compactJson() const {
+    std::shared_ptr<const Fragment> cached = std::atomic_load(&fragment);
+    if (!cached || cached->generation != generation) {
+        std::ostringstream out;
+        {
+            JsonWriter writer(out, JsonWriter::COMPACT);
+            writeTasks(writer);
+        }
+        cached = std::shared_ptr<const Fragment>(new Fragment{generation, out.str()});
+        std::atomic_store(&fragment, cached);
+    }
+    return std::shared_ptr<const String>(cached, &cached->json);
+}
+
+/*
+    * Function to return a copy of the Project as it is now, which never
+    * changes, for a Snapshot. The copy is only made again once the Project
+    * has changed since the last one, so Snapshots taken in between share it.
+    * Called by the thread that changes the Project.
+    * @return std::shared_ptr<const Project>: The copy, not part of any TodoList
+*/
+std::shared_ptr<const Project> Project::publish() const {
+    if (!published || published->generation != generation) {
+        published = std::make_shared<const Project>(*this);
+    }
+    return published;
+}
+
+// Called by a task in this Project before its completed state changes
+void Project::onComplete(const Task &task, bool completed) {
+    changed();
+    stats.setComplete(task, completed);
+    if (list) {
+        list->stats.setComplete(task, completed);
+        if (task.isComplete() != completed) {
+            list->changes.completed(ident, task.getIdent(), completed);
+        }
+    }
+}
+
+// Called by a task in this Project before its due date changes
+void Project::onDueDate(const Task &task, const Date &date) {
+    changed();
+    stats.setDueDate(task, date);
+    if (list) {
+        list->stats.setDueDate(task, date);
+        if (!(task.getDueDate() == date)) {
+            list->changes.dueDate(ident, task.getIdent(), date);
+        }
+    }
+}
+
+// Called by a task in this Project after a tag has been added to it
+void Project::onTagAdded(const Task &task, const String &tag) {
+    changed();
+    stats.addTag(tag);
+    if (list) {
+        list->stats.addTag(tag);
+        list->changes.tagAdded(ident, task.getIdent(), tag);
+    }
+}
+
+// Called by a task in this Project after a tag has been removed from it
+void Project::onTagRemoved(const Task &task, const String &tag) {
+    changed();
+    stats.removeTag(tag);
+    if (list) {
+        list->stats.removeTag(tag);
+        list->changes.tagRemoved(ident, task.getIdent(), tag);
+    }
+}
+
 // Function to compare two Project objects
 bool operator==(const Project &c1, const Project &c2) {
     return c1.getIdent() == c2.getIdent() && c1.getTasks() == c2.getTasks();
 }
 
+// The part of str() before the identifier of the Project object
+static const char STR_IDENT[] = "\"ident\":\"";
+
 /*
-    * Function to return the string representation of the Project object
+    * Function to return the string representation of the Project object. The
+    * length is worked out first, so the string is allocated once. The
+    * identifiers and tags are escaped as JSON strings.
     * @return String: The string representation of the Project object
 */
 String Project::str() const {
-    String s = "";
-    s += "\"ident\":\"" + ident + "\":{";
+    String s;
+    s.reserve(strLength());
+    appendStr(s);
+    return s;
+}
+
+// Function to return the length of str(), without building it
+std::size_t Project::strLength() const noexcept {
+    std::size_t length = sizeof(STR_IDENT) - 1 + JsonWriter::escapedLength(ident) + 4;
     for (const Task &tObj : tasks) {
-        s += tObj.str() + ",";
+        length += tObj.strLength() + 1;
     }
-    s.pop_back();
-    s += "}";
-    return s;
+    return tasks.empty() ? length : length - 1;
+}
+
+// Function to append str() to a string, each task straight after the last
+void Project::appendStr(String &s) const {
+    s.append(STR_IDENT, sizeof(STR_IDENT) - 1);
+    JsonWriter::appendEscaped(s, ident);
+    s += "\":{";
+    for (auto it = tasks.begin(); it != tasks.end(); it++) {
+        if (it != tasks.begin()) {
+            s += ',';
+        }
+        it->appendStr(s);
+    }
+    s += '}';
+}
+
+/*
+    * Function to find a task in the Project object
+    * @param tIdent: The identifier of the task to find
+    * @return const Task*: The task, or null if there is none
+*/
+const Task *Project::findTask(const String &tIdent) const noexcept {
+    for (const Task &tObj : tasks) {
+        if (tObj.getIdent() == tIdent) {
+            return &tObj;
+        }
+    }
+    return nullptr;
 }
 
 /*
@@ -131,9 +355,64 @@ bool Project::containsTask(const String &tIdent) const noexcept {
     * @return Json: The JSON representation of the Project object
 */
 Json Project::json() const {
-    Json j;
+    // The due dates are written together, then each task's JSON is built
+    std::vector<Date> dates;
+    dates.reserve(tasks.size());
     for (const Task& task : tasks) {
-        j[task.getIdent()] = task.json();
+        dates.push_back(task.dueDate);
+    }
+    std::vector<String> texts;
+    Date::formatMany(dates, texts);
+
+    Json j = Json::object();
+    for (std::size_t i = 0; i < tasks.size(); i++) {
+        j[tasks[i].getIdent()] = tasks[i].json(texts[i]);
     }
     return j;
 }
+
+/*
+    * Function to write the JSON representation of the Project object, with
+    * the tasks sorted by identifier, the same as json().dump() prints it.
+    * Compact JSON is kept between writes (see compactJson), so a Project
+    * that has not changed is copied out rather than written again.
+    * @param writer: The JsonWriter to write to
+*/
+void Project::write(JsonWriter &writer) const {
+    if (writer.getStyle() == JsonWriter::COMPACT) {
+        writer.fragment(*compactJson());
+    } else {
+        writeTasks(writer);
+    }
+}
+
+// Function to write the tasks of the Project object as a JSON object,
+// sorted by identifier
+void Project::writeTasks(JsonWriter &writer) const {
+    std::vector<const Task*> sorted;
+    sorted.reserve(tasks.size());
+    for (const Task &task : tasks) {
+        sorted.push_back(&task);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Task *a, const Task *b) {
+        return a->identifier < b->identifier;
+    });
+
+    writer.beginObject();
+    for (const Task *task : sorted) {
+        writer.key(task->identifier);
+        task->write(writer);
+    }
+    writer.endObject();
+}
+
+// Called by a task in this Project before it is renamed
+void Project::onRename(const Task &task, const String &tIdent) {
+    changed();
+    if (list) {
+        list->changes.taskRenamed(ident, task.getIdent(), tIdent);
+        if (list->index) {
+            list->index->renameTask(ident, task.getIdent(), tIdent);
+        }
+    }
+}
@@ -10,41 +10,90 @@
 #define PROJECT_H
 
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "lib_json.hpp"
+#include "owner.h"
+#include "stats.h"
 #include "task.h"
 
+class TodoList;
 
 using TaskContainer = std::vector<Task>;
 
 class Project {
   String ident;
   TaskContainer tasks;
+  Stats stats;
+
+  // The TodoList this Project is stored in, see Owner.
+  Owner<TodoList> list;
+  friend class TodoList;
+
+  // The compact JSON of the tasks, kept from when it was last written
+  // until the generation it was written at is out of date. The pointer is
+  // read and replaced atomically, so that a copy published in Snapshots
+  // (see publish) can be written by several threads at once.
+  struct Fragment {
+    unsigned long generation;
+    String json;
+  };
+  unsigned long generation;
+  mutable std::shared_ptr<const Fragment> fragment;
+
+  // The copy last published, kept until the Project changes
+  mutable std::shared_ptr<const Project> published;
+
+  void bindTasks() noexcept;
+  void pushTask(const Task &task);
+  void changed() noexcept;
+  void writeTasks(JsonWriter &writer) const;
+
+  // Notifications from the tasks in this Project, made before the change
+  // is applied to the task.
+  friend class Task;
+  void onComplete(const Task &task, bool completed);
+  void onDueDate(const Task &task, const Date &date);
+  void onTagAdded(const Task &task, const String &tag);
+  void onTagRemoved(const Task &task, const String &tag);
+  void onRename(const Task &task, const String &tIdent);
 
 public:
   explicit Project(String ident);
+  Project(const Project &other);
+  Project(Project &&other) noexcept;
+  Project &operator=(const Project &other);
+  Project &operator=(Project &&other) noexcept;
   ~Project() = default;
 
   unsigned int size() const noexcept;
   const String &getIdent() const noexcept;
 
-  void setIdent(String pIdent) noexcept;
+  void setIdent(String pIdent);
 
   const TaskContainer &getTasks() const noexcept;
   Task &newTask(const String &tIdent);
-  TaskContainer::iterator findTask(const String &tIdent);
+  const Task *findTask(const String &tIdent) const noexcept;
   bool containsTask(const String &tIdent) const noexcept;
 
   bool addTask(Task task);
   Task &getTask(const String &tIdent);
   bool deleteTask(const String &tIdent);
 
+  const Stats &getStats() const noexcept;
+  unsigned long getGeneration() const noexcept;
+  std::shared_ptr<const String> compactJson() const;
+  std::shared_ptr<const Project> publish() const;
+
   friend bool operator==(const Project &c1, const Project &c2);
 
   Json json() const;
   String str() const;
+  std::size_t strLength() const noexcept;
+  void appendStr(String &s) const;
+  void write(JsonWriter &writer) const;
 
   // Wrappers for iterating over the nested container
   inline TaskContainer::iterator begin() { return tasks.begin(); }
@@ -0,0 +1,165 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the Replica class.
+*/
+
+
+#include "replica.h"
+
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+
+
+// Returns the current time in milliseconds since the epoch, as in the journal
+static long long now() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Returns whether two generations are of the same file, however it has changed
+static bool sameFile(const FileGeneration &g1, const FileGeneration &g2) {
+    return g1.device == g2.device && g1.inode == g2.inode;
+}
+
+/*
+    * Constructor to create a Replica of a database, starting its journal.
+    * The TodoList to keep up to date has to be loaded afterwards, so that
+    * no change is saved in between without being in the journal.
+    * @param primary: The filename of the database
+    * @throws std::runtime_error: If the journal cannot be created
+*/
+Replica::Replica(const String &primary) : primary(primary), offset(0), lag(0), reloads(0) {
+    ChangeFeed::start(primary);
+    journal = FileGeneration::of(ChangeFeed::journalPath(primary));
+}
+
+// Function to return the filename of the database
+const String &Replica::getPrimary() const noexcept {
+    return primary;
+}
+
+// Function to load the database again, in place of the TodoList
+void Replica::reload(TodoList &tl) {
+    TodoList loaded;
+    loaded.load(primary);
+    tl = std::move(loaded);
+    reloads++;
+}
+
+/*
+    * Function to apply the changes saved to the journal of the database
+    * since the last poll. The TodoList is loaded from the database again if
+    * the changes cannot be applied to it.
+    * @param tl: The TodoList, already loaded from the database
+    * @return unsigned int: The number of changes applied, counting loading
+    * the database again as one
+    * @throws std::runtime_error: If the database has to be loaded and
+    * cannot be
+*/
+unsigned int Replica::poll(TodoList &tl) {
+    const String path = ChangeFeed::journalPath(primary);
+    const FileGeneration current = FileGeneration::of(path);
+    if (sameFile(current, journal)) {
+        return read(tl, path);
+    }
+
+    // The journal was moved aside by a save, so the rest of it comes first
+    unsigned int applied = 0;
+    const String old = ChangeFeed::oldJournalPath(primary);
+    if (sameFile(FileGeneration::of(old), journal)) {
+        applied = read(tl, old);
+    } else {
+        reload(tl);
+        applied = 1;
+    }
+    journal = current;
+    offset = 0;
+    return applied + read(tl, path);
+}
+
+// Apply the changes in a journal after what has been read of it
+unsigned int Replica::read(TodoList &tl, const String &path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return 0;
+    }
+    const std::streamoff size = file.tellg();
+    if (size < offset) {
+        // The journal was replaced, so what was read of it means nothing
+        offset = 0;
+        reload(tl);
+        return 1;
+    }
+    if (size == offset) {
+        return 0;
+    }
+
+    // Only whole lines are read, the rest is still being written
+    String data(size - offset, '\0');
+    file.seekg(offset);
+    file.read(&data[0], data.size());
+    const String::size_type end = data.rfind('\n');
+    if (end == String::npos) {
+        return 0;
+    }
+    offset += end + 1;
+
+    unsigned int applied = 0;
+    String::size_type from = 0;
+    while (from <= end) {
+        const String::size_type newline = data.find('\n', from);
+        Json change = Json::parse(data.begin() + from, data.begin() + newline, nullptr, false);
+        from = newline + 1;
+        if (!change.is_object() || !change.contains("seq") || !change["seq"].is_number()) {
+            // A line torn by a crash
+            continue;
+        }
+        const unsigned long long sequence = change["seq"];
+        if (sequence <= tl.getSequence()) {
+            // Already in the database when it was loaded
+            continue;
+        }
+
+        // A missing change or one that does not fit means the TodoList no
+        // longer matches the database, which is read again
+        bool fits = sequence == tl.getSequence() + 1;
+        if (fits) {
+            try {
+                tl.apply(change);
+            } catch (const std::exception &e) {
+                fits = false;
+            }
+        }
+        if (!fits) {
+            reload(tl);
+        }
+        if (change.contains("time") && change["time"].is_number()) {
+            lag = now() - change["time"].get<long long>();
+        }
+        applied++;
+    }
+    return applied;
+}
+
+/*
+    * Function to return how far the TodoList is behind the database
+    * @param tl: The TodoList kept up to date by poll
+    * @return Json: The database as "primary", the last change applied as
+    * "seq", the last change in the journal as "primary_seq", the number of
+    * changes not yet applied as "behind", how long after it was saved the
+    * last change was applied as "lag_ms" and how many times the database
+    * was loaded again as "reloads"
+*/
+Json Replica::status(const TodoList &tl) const {
+    const unsigned long long last = ChangeFeed::lastSequence(primary);
+    Json j;
+    j["primary"] = primary;
+    j["seq"] = tl.getSequence();
+    j["primary_seq"] = last;
+    j["behind"] = last > tl.getSequence() ? last - tl.getSequence() : 0;
+    j["lag_ms"] = lag;
+    j["reloads"] = reloads;
+    return j;
+}
@@ -0,0 +1,50 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the Replica class.
+ * A Replica keeps a TodoList loaded from a database (the primary) up to date
+ * by applying the changes saved to its journal (see ChangeFeed), rather than
+ * loading the whole database again after every save. Creating a Replica
+ * starts the journal, if it was not kept already. Only the part of the
+ * journal written since the last poll is read, and a journal moved aside by
+ * a save is read to its end before the new one. A reset, a change that
+ * cannot be applied or a journal that has been replaced makes the Replica
+ * load the database again.
+ * The primary and the Replica only share the database's directory, so the
+ * Replica can run in another process, or on another host that mounts it.
+*/
+
+
+#ifndef REPLICA_H
+#define REPLICA_H
+
+#include <ios>
+
+#include "todolist.h"
+
+class Replica {
+  String primary;
+
+  // The journal being read, and how much of it has been
+  FileGeneration journal;
+  std::streamoff offset;
+
+  // How long after it was saved the last change was applied, in milliseconds
+  long long lag;
+
+  // How many times the database was loaded again
+  unsigned int reloads;
+
+  void reload(TodoList &tl);
+  unsigned int read(TodoList &tl, const String &path);
+
+public:
+  explicit Replica(const String &primary);
+  ~Replica() = default;
+
+  const String &getPrimary() const noexcept;
+  unsigned int poll(TodoList &tl);
+  Json status(const TodoList &tl) const;
+};
+
+#endif // REPLICA_H
@@ -0,0 +1,278 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the SearchIndex class.
+*/
+
+
+#include "searchindex.h"
+
+#include <algorithm>
+#include <cctype>
+
+
+// Returns the key identifying a task in the index
+String SearchIndex::taskKey(const String &pIdent, const String &tIdent) {
+    String key;
+    key.reserve(pIdent.size() + tIdent.size() + 1);
+    key += pIdent;
+    key += '\x1f';
+    key += tIdent;
+    return key;
+}
+
+/*
+    * Function to split an identifier into its distinct trigrams, ignoring case
+    * @param ident: The identifier
+    * @return std::vector<Trigram>: The trigrams, sorted
+*/
+std::vector<SearchIndex::Trigram> SearchIndex::trigrams(const String &ident) {
+    std::vector<Trigram> result;
+    if (ident.size() < 3) {
+        return result;
+    }
+    result.reserve(ident.size() - 2);
+    Trigram t = 0;
+    for (std::size_t i = 0; i < ident.size(); i++) {
+        t = ((t << 8) | std::tolower(static_cast<unsigned char>(ident[i]))) & 0xffffff;
+        if (i >= 2) {
+            result.push_back(t);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+// Returns true if the identifier contains the word, ignoring case
+bool SearchIndex::contains(const String &ident, const String &word) {
+    auto equal = [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) ==
+               std::tolower(static_cast<unsigned char>(b));
+    };
+    return std::search(ident.begin(), ident.end(), word.begin(), word.end(), equal) != ident.end();
+}
+
+// Add an identifier to the posting list of each of its trigrams
+void SearchIndex::post(DocId id, const String &ident) {
+    for (Trigram t : trigrams(ident)) {
+        std::vector<DocId> &list = postings[t];
+        if (list.empty() || list.back() < id) {
+            list.push_back(id);
+        } else {
+            auto it = std::lower_bound(list.begin(), list.end(), id);
+            if (it == list.end() || *it != id) {
+                list.insert(it, id);
+            }
+        }
+    }
+}
+
+// Remove an identifier from the posting list of each of its trigrams
+void SearchIndex::unpost(DocId id, const String &ident) {
+    for (Trigram t : trigrams(ident)) {
+        auto entry = postings.find(t);
+        if (entry == postings.end()) {
+            continue;
+        }
+        std::vector<DocId> &list = entry->second;
+        auto it = std::lower_bound(list.begin(), list.end(), id);
+        if (it != list.end() && *it == id) {
+            list.erase(it);
+        }
+        if (list.empty()) {
+            postings.erase(entry);
+        }
+    }
+}
+
+// Add a project or task to the index, reusing a free identifier if possible
+SearchIndex::DocId SearchIndex::insert(const String &pIdent, const String &tIdent,
+                                       bool isProject) {
+    DocId id;
+    if (freeDocs.empty()) {
+        id = static_cast<DocId>(docs.size());
+        docs.push_back({pIdent, tIdent, isProject});
+        live.push_back(true);
+    } else {
+        id = freeDocs.back();
+        freeDocs.pop_back();
+        docs[id] = {pIdent, tIdent, isProject};
+        live[id] = true;
+    }
+    post(id, isProject ? pIdent : tIdent);
+    return id;
+}
+
+// Remove a project or task from the index
+void SearchIndex::remove(DocId id) {
+    SearchMatch &doc = docs[id];
+    unpost(id, doc.isProject ? doc.project : doc.task);
+    doc.project.clear();
+    doc.task.clear();
+    live[id] = false;
+    freeDocs.push_back(id);
+}
+
+// Function to add a project and all of its tasks to the index
+void SearchIndex::addProject(const Project &project) {
+    const String &pIdent = project.getIdent();
+    if (projectDocs.count(pIdent)) {
+        return;
+    }
+    projectDocs[pIdent] = insert(pIdent, "", true);
+    for (const Task &task : project.getTasks()) {
+        addTask(pIdent, task.getIdent());
+    }
+}
+
+// Function to remove a project and all of its tasks from the index
+void SearchIndex::removeProject(const Project &project) {
+    const String &pIdent = project.getIdent();
+    for (const Task &task : project.getTasks()) {
+        removeTask(pIdent, task.getIdent());
+    }
+    auto it = projectDocs.find(pIdent);
+    if (it != projectDocs.end()) {
+        remove(it->second);
+        projectDocs.erase(it);
+    }
+}
+
+/*
+    * Function to update the index before a project is renamed
+    * @param project: The project, still with its previous identifier
+    * @param newIdent: The new identifier of the project
+*/
+void SearchIndex::renameProject(const Project &project, const String &newIdent) {
+    const String &oldIdent = project.getIdent();
+    if (oldIdent == newIdent) {
+        return;
+    }
+    auto it = projectDocs.find(oldIdent);
+    if (it == projectDocs.end()) {
+        return;
+    }
+    DocId id = it->second;
+    projectDocs.erase(it);
+    unpost(id, oldIdent);
+    docs[id].project = newIdent;
+    post(id, newIdent);
+    projectDocs[newIdent] = id;
+
+    // The task identifiers are unchanged, only the project they belong to
+    for (const Task &task : project.getTasks()) {
+        auto t = taskDocs.find(taskKey(oldIdent, task.getIdent()));
+        if (t != taskDocs.end()) {
+            DocId taskId = t->second;
+            taskDocs.erase(t);
+            docs[taskId].project = newIdent;
+            taskDocs[taskKey(newIdent, task.getIdent())] = taskId;
+        }
+    }
+}
+
+// Function to add a task to the index
+void SearchIndex::addTask(const String &pIdent, const String &tIdent) {
+    String key = taskKey(pIdent, tIdent);
+    if (!taskDocs.count(key)) {
+        taskDocs[key] = insert(pIdent, tIdent, false);
+    }
+}
+
+// Function to remove a task from the index
+void SearchIndex::removeTask(const String &pIdent, const String &tIdent) {
+    auto it = taskDocs.find(taskKey(pIdent, tIdent));
+    if (it != taskDocs.end()) {
+        remove(it->second);
+        taskDocs.erase(it);
+    }
+}
+
+// Function to update the index when a task is renamed
+void SearchIndex::renameTask(const String &pIdent, const String &oldIdent,
+                             const String &newIdent) {
+    if (oldIdent != newIdent) {
+        removeTask(pIdent, oldIdent);
+        addTask(pIdent, newIdent);
+    }
+}
+
+// Function to return the number of projects and tasks in the index
+unsigned int SearchIndex::size() const noexcept {
+    return projectDocs.size() + taskDocs.size();
+}
+
+/*
+    * Function to find the projects and tasks whose identifier contains a word
+    * @param word: The word to search for, ignoring case
+    * @return MatchContainer: The projects and tasks found
+*/
+MatchContainer SearchIndex::search(const String &word) const {
+    MatchContainer result;
+    const std::vector<Trigram> wordTrigrams = trigrams(word);
+
+    if (wordTrigrams.empty()) {
+        // Too short to use the index, check every identifier
+        for (DocId id = 0; id < docs.size(); id++) {
+            const SearchMatch &doc = docs[id];
+            if (live[id] && contains(doc.isProject ? doc.project : doc.task, word)) {
+                result.push_back(doc);
+            }
+        }
+        return result;
+    }
+
+    std::vector<const std::vector<DocId> *> lists;
+    for (Trigram t : wordTrigrams) {
+        auto it = postings.find(t);
+        if (it == postings.end()) {
+            return result;
+        }
+        lists.push_back(&it->second);
+    }
+
+    // Intersect the posting lists, shortest first
+    std::sort(lists.begin(), lists.end(),
+              [](const std::vector<DocId> *a, const std::vector<DocId> *b) {
+                  return a->size() < b->size();
+              });
+    std::vector<DocId> candidates = *lists[0];
+    std::vector<DocId> next;
+    for (std::size_t i = 1; i < lists.size() && !candidates.empty(); i++) {
+        const std::vector<DocId> &list = *lists[i];
+        next.clear();
+        if (list.size() / 16 > candidates.size()) {
+            // Much longer list, gallop ahead to each candidate rather than
+            // stepping through every entry
+            auto it = list.begin();
+            for (DocId id : candidates) {
+                std::size_t step = 1;
+                auto bound = it;
+                while (bound != list.end() && *bound < id) {
+                    it = bound;
+                    bound = static_cast<std::size_t>(list.end() - bound) > step ? bound + step : list.end();
+                    step *= 2;
+                }
+                it = std::lower_bound(it, bound, id);
+                if (it != list.end() && *it == id) {
+                    next.push_back(id);
+                }
+            }
+        } else {
+            std::set_intersection(candidates.begin(), candidates.end(),
+                                  list.begin(), list.end(), std::back_inserter(next));
+        }
+        candidates.swap(next);
+    }
+
+    // Every trigram matching does not mean the word does, e.g. 'abcab' for
+    // 'cabc', so check each candidate
+    for (DocId id : candidates) {
+        const SearchMatch &doc = docs[id];
+        if (contains(doc.isProject ? doc.project : doc.task, word)) {
+            result.push_back(doc);
+        }
+    }
+    return result;
+}
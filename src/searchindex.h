@@ -0,0 +1,67 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the SearchIndex class.
+ * A SearchIndex finds the projects and tasks whose identifier contains a
+ * given word (ignoring case). Every identifier is split into trigrams (runs
+ * of three characters), and each trigram maps to the sorted list of the
+ * identifiers containing it. A search intersects the lists of the trigrams
+ * in the word and then checks each candidate against the word itself.
+*/
+
+
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "project.h"
+
+// A project (with an empty task identifier) or task found by a search
+struct SearchMatch {
+  String project;
+  String task;
+  bool isProject;
+};
+
+using MatchContainer = std::vector<SearchMatch>;
+
+class SearchIndex {
+  using DocId = std::uint32_t;
+  using Trigram = std::uint32_t;
+
+  std::vector<SearchMatch> docs;
+  std::vector<bool> live;
+  std::vector<DocId> freeDocs;
+  std::unordered_map<String, DocId> projectDocs;
+  std::unordered_map<String, DocId> taskDocs;
+  std::unordered_map<Trigram, std::vector<DocId>> postings;
+
+  static String taskKey(const String &pIdent, const String &tIdent);
+  static std::vector<Trigram> trigrams(const String &ident);
+  static bool contains(const String &ident, const String &word);
+
+  DocId insert(const String &pIdent, const String &tIdent, bool isProject);
+  void remove(DocId id);
+  void post(DocId id, const String &ident);
+  void unpost(DocId id, const String &ident);
+
+public:
+  SearchIndex() = default;
+  ~SearchIndex() = default;
+
+  void addProject(const Project &project);
+  void removeProject(const Project &project);
+  void renameProject(const Project &project, const String &newIdent);
+
+  void addTask(const String &pIdent, const String &tIdent);
+  void removeTask(const String &pIdent, const String &tIdent);
+  void renameTask(const String &pIdent, const String &oldIdent,
+                  const String &newIdent);
+
+  unsigned int size() const noexcept;
+  MatchContainer search(const String &word) const;
+};
+
+#endif // SEARCHINDEX_H
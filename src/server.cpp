@@ -0,0 +1,1025 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the Server class.
+*/
+
+
+#include "server.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "todo.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+
+// Largest number of arguments, and of bytes in one argument, in a request
+static const std::uint32_t MAX_ARGUMENTS = 1024;
+static const std::uint32_t MAX_ARGUMENT_SIZE = 1 << 20;
+
+// How long a Server waits for the rest of a request it has started to receive
+static const int REQUEST_TIMEOUT_S = 5;
+
+using Clock = std::chrono::steady_clock;
+
+const int Server::FLUSH_DELAY_MS;
+const int Server::FOLLOW_INTERVAL_MS;
+
+// Function to return the name of the socket a Server for a database listens on
+String Server::socketPath(const String &db) {
+    return db + ".sock";
+}
+
+#ifndef _WIN32
+
+// The write end of the wakeup pipe of the Server stopped by signals
+static int signalWakeup = -1;
+
+static void onSignal(int) {
+    if (signalWakeup >= 0) {
+        const char byte = 0;
+        ssize_t written = write(signalWakeup, &byte, 1);
+        (void)written;
+    }
+}
+
+// Write all of a buffer to a socket
+static bool writeAll(int fd, const void *data, std::size_t size) {
+    const char *cursor = static_cast<const char *>(data);
+    while (size > 0) {
+        ssize_t written = send(fd, cursor, size, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        cursor += written;
+        size -= written;
+    }
+    return true;
+}
+
+// Read a whole buffer from a socket
+static bool readAll(int fd, void *data, std::size_t size) {
+    char *cursor = static_cast<char *>(data);
+    while (size > 0) {
+        ssize_t received = recv(fd, cursor, size, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        cursor += received;
+        size -= received;
+    }
+    return true;
+}
+
+// Write a string to a socket, preceded by its length
+static bool writeString(int fd, const String &s) {
+    const std::uint32_t size = s.size();
+    return writeAll(fd, &size, sizeof(size)) && writeAll(fd, s.data(), s.size());
+}
+
+// Read a string written by writeString from a socket
+static bool readString(int fd, String &s, std::uint32_t maxSize) {
+    std::uint32_t size;
+    if (!readAll(fd, &size, sizeof(size)) || size > maxSize) {
+        return false;
+    }
+    s.resize(size);
+    return size == 0 || readAll(fd, &s[0], size);
+}
+
+// Read a number from a buffer, returning false if it does not hold one yet
+static bool parseNumber(const String &buffer, std::size_t &cursor, std::uint32_t &number) {
+    if (buffer.size() - cursor < sizeof(number)) {
+        return false;
+    }
+    std::memcpy(&number, buffer.data() + cursor, sizeof(number));
+    cursor += sizeof(number);
+    return true;
+}
+
+/*
+    * Function to take a request, as sent by Client::send, from the start of
+    * what a connection has received
+    * @param buffer: The data received
+    * @param position: Where the request starts, moved past it if it is whole
+    * @param arguments: Set to the arguments of the request
+    * @return int: 1 if a whole request was taken, 0 if more data is needed,
+    * -1 if the request is malformed or too large
+*/
+static int parseRequest(const String &buffer, std::size_t &position,
+                        std::vector<String> &arguments) {
+    std::size_t cursor = position;
+    std::uint32_t argc;
+    if (!parseNumber(buffer, cursor, argc)) {
+        return 0;
+    }
+    if (argc == 0 || argc > MAX_ARGUMENTS) {
+        return -1;
+    }
+    std::vector<String> result;
+    result.reserve(argc);
+    for (std::uint32_t i = 0; i < argc; i++) {
+        std::uint32_t size;
+        if (!parseNumber(buffer, cursor, size)) {
+            return 0;
+        }
+        if (size > MAX_ARGUMENT_SIZE) {
+            return -1;
+        }
+        if (buffer.size() - cursor < size) {
+            return 0;
+        }
+        result.emplace_back(buffer, cursor, size);
+        cursor += size;
+    }
+    arguments = std::move(result);
+    position = cursor;
+    return 1;
+}
+
+// Append a string to a response, preceded by its length
+static void appendString(String &response, const String &s) {
+    const std::uint32_t size = s.size();
+    response.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    response.append(s);
+}
+
+// Append the answer to a command to what a connection has to send
+static void appendResponse(String &output, std::int32_t status, const String &out,
+                           const String &err) {
+    output.append(reinterpret_cast<const char *>(&status), sizeof(status));
+    appendString(output, out);
+    appendString(output, err);
+}
+
+// Fill in the address of a socket, returning false if the name is too long
+static bool socketAddress(const String &path, sockaddr_un &address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+// Connect to the socket with the given name, returning -1 if nothing is
+// listening on it
+static int connectTo(const String &path) {
+    sockaddr_un address;
+    if (!socketAddress(path, address)) {
+        return -1;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Waits for any of a set of sockets to be ready: with epoll on Linux, where
+// the wait does not grow with the number of sockets, and poll elsewhere
+class Server::Poller {
+#ifdef __linux__
+    int fd;
+#else
+    std::map<int, short> watched;
+#endif
+
+public:
+    struct Event {
+        int fd;
+        bool readable;
+        bool writable;
+    };
+
+#ifdef __linux__
+    Poller() : fd(epoll_create1(EPOLL_CLOEXEC)) {
+        if (fd < 0) {
+            throw std::runtime_error(String("Failed to create epoll: ") + std::strerror(errno));
+        }
+    }
+
+    ~Poller() {
+        close(fd);
+    }
+
+    // Start or change watching a socket for being readable and/or writable
+    void watch(int socket, bool read, bool write, bool added) {
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = (read ? static_cast<std::uint32_t>(EPOLLIN) : 0u) |
+                       (write ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+        event.data.fd = socket;
+        epoll_ctl(fd, added ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, socket, &event);
+    }
+
+    void forget(int socket) {
+        epoll_ctl(fd, EPOLL_CTL_DEL, socket, nullptr);
+    }
+
+    // Wait up to timeout milliseconds (-1 for ever) for sockets to be ready
+    std::vector<Event> wait(int timeout) {
+        epoll_event events[64];
+        const int count = epoll_wait(fd, events, 64, timeout);
+        if (count < 0 && errno != EINTR) {
+            throw std::runtime_error(String("Failed to wait for commands: ") +
+                                     std::strerror(errno));
+        }
+        std::vector<Event> ready;
+        for (int i = 0; i < count; i++) {
+            const unsigned int flags = events[i].events;
+            ready.push_back({events[i].data.fd, (flags & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0,
+                             (flags & (EPOLLOUT | EPOLLHUP | EPOLLERR)) != 0});
+        }
+        return ready;
+    }
+#else
+    void watch(int socket, bool read, bool write, bool) {
+        watched[socket] = (read ? POLLIN : 0) | (write ? POLLOUT : 0);
+    }
+
+    void forget(int socket) {
+        watched.erase(socket);
+    }
+
+    std::vector<Event> wait(int timeout) {
+        std::vector<pollfd> fds;
+        for (const auto &socket : watched) {
+            fds.push_back({socket.first, socket.second, 0});
+        }
+        if (poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR) {
+            throw std::runtime_error(String("Failed to wait for commands: ") +
+                                     std::strerror(errno));
+        }
+        std::vector<Event> ready;
+        for (const pollfd &fd : fds) {
+            if (fd.revents) {
+                ready.push_back({fd.fd, (fd.revents & (POLLIN | POLLHUP | POLLERR)) != 0,
+                                 (fd.revents & (POLLOUT | POLLHUP | POLLERR)) != 0});
+            }
+        }
+        return ready;
+    }
+#endif
+};
+
+// Runs jobs on a thread of its own, one at a time in the order they are
+// posted. Jobs still queued when it is destroyed are run first.
+class Server::Worker {
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> jobs;
+    bool stopping;
+    std::thread thread;
+
+    void work() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                return;
+            }
+            std::function<void()> job = std::move(jobs.front());
+            jobs.pop_front();
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+    }
+
+public:
+    Worker() : stopping(false), thread(&Worker::work, this) {}
+
+    ~Worker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        thread.join();
+    }
+
+    void post(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(std::move(job));
+        }
+        wake.notify_one();
+    }
+};
+
+// What a Server is in the middle of on one connection
+struct Server::Connection {
+    int fd;
+    // Tells a connection from a later one given the same fd
+    unsigned long id;
+    // Received but not yet run, which is the start of a request
+    String input;
+    // When the first part of that request was received
+    Clock::time_point since;
+    // Answers not yet sent, and how much of them has been
+    String output;
+    std::size_t sent;
+    // The client has finished sending, or sent something malformed
+    bool closing;
+    // Whether the socket is being watched for being writable
+    bool writing;
+    // A read is being answered by the reader, and the requests after it
+    // wait until it has been
+    bool busy;
+};
+
+/*
+    * Constructor to create a Server for a database. The database is loaded
+    * and the socket created straight away, so that commands sent as soon as
+    * the Server exists are served.
+    * @param db: The filename of the database
+    * @param primary: If not empty, the database to serve a read-only copy
+    * of as db, instead of db itself
+    * @throws std::runtime_error: If the database cannot be loaded, another
+    * Server is already serving it or the socket cannot be created
+*/
+Server::Server(const String &db, const String &primary)
+    : session(primary.empty() ? db : primary), options(App::cxxoptsSetup()),
+      path(socketPath(db)), listener(-1), wakeup{-1, -1}, diverged(false),
+      poller(new Poller()), accepted(0), reader(new Worker()), saver(new Worker()),
+      ready{-1, -1} {
+    if (primary.empty()) {
+        session.getTodoList();
+    } else {
+        session.follow();
+    }
+
+    sockaddr_un address;
+    if (!socketAddress(path, address)) {
+        throw std::runtime_error("Socket name too long: " + path);
+    }
+
+    // A socket nobody is listening on was left behind by a Server that did
+    // not stop cleanly
+    int existing = connectTo(path);
+    if (existing >= 0) {
+        close(existing);
+        throw std::runtime_error("Database already being served: " + db);
+    }
+    unlink(path.c_str());
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 ||
+        bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 ||
+        chmod(path.c_str(), S_IRUSR | S_IWUSR) < 0 || listen(listener, 64) < 0 ||
+        pipe(wakeup) < 0 || pipe(ready) < 0) {
+        const String reason = std::strerror(errno);
+        if (listener >= 0) {
+            close(listener);
+            unlink(path.c_str());
+        }
+        if (wakeup[0] >= 0) {
+            close(wakeup[0]);
+            close(wakeup[1]);
+        }
+        throw std::runtime_error("Failed to create socket " + path + ": " + reason);
+    }
+    fcntl(listener, F_SETFD, FD_CLOEXEC);
+    fcntl(listener, F_SETFL, O_NONBLOCK);
+    for (int fd : {wakeup[0], wakeup[1], ready[0], ready[1]}) {
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    fcntl(wakeup[1], F_SETFL, O_NONBLOCK);
+    fcntl(ready[0], F_SETFL, O_NONBLOCK);
+    fcntl(ready[1], F_SETFL, O_NONBLOCK);
+    poller->watch(listener, true, false, false);
+    poller->watch(wakeup[0], true, false, false);
+    poller->watch(ready[0], true, false, false);
+}
+
+Server::~Server() {
+    // The Workers finish what they were given before anything they use goes
+    reader.reset();
+    saver.reset();
+    if (signalWakeup == wakeup[1]) {
+        signalWakeup = -1;
+    }
+    while (!connections.empty()) {
+        disconnect(connections.begin()->first);
+    }
+    close(listener);
+    unlink(path.c_str());
+    close(wakeup[0]);
+    close(wakeup[1]);
+    close(ready[0]);
+    close(ready[1]);
+}
+
+/*
+    * Function to run the commands sent to the Server until it is stopped,
+    * then save any changes
+    * @return int: The exit code, 1 if the changes could not be saved
+*/
+int Server::run() {
+    Clock::time_point followAt = Clock::now();
+    bool running = true;
+
+    while (running) {
+        // Wake up for the next save, the next read of the journal being
+        // followed, or the first request to time out
+        Clock::time_point wakeAt = Clock::time_point::max();
+        if (session.isModified() && !session.isSaving()) {
+            wakeAt = flushAt;
+        }
+        if (session.getReplica()) {
+            wakeAt = std::min(wakeAt, followAt);
+        }
+        for (const auto &connection : connections) {
+            if (!connection.second->input.empty() && !connection.second->busy) {
+                wakeAt = std::min(wakeAt, connection.second->since +
+                                              std::chrono::seconds(REQUEST_TIMEOUT_S));
+            }
+        }
+        int timeout = -1;
+        if (wakeAt != Clock::time_point::max()) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                wakeAt - Clock::now()).count();
+            timeout = remaining > 0 ? static_cast<int>(remaining) + 1 : 0;
+        }
+
+        const bool wasModified = session.isModified();
+        for (const Poller::Event &event : poller->wait(timeout)) {
+            if (event.fd == wakeup[0]) {
+                running = false;
+            } else if (event.fd == ready[0]) {
+                finish();
+            } else if (event.fd == listener) {
+                accept();
+            } else {
+                auto it = connections.find(event.fd);
+                if (it == connections.end()) {
+                    continue;
+                }
+                bool open = true;
+                if (event.readable) {
+                    open = receive(*it->second);
+                }
+                if (open && event.writable) {
+                    open = send(*it->second);
+                }
+                if (!open) {
+                    disconnect(event.fd);
+                }
+            }
+        }
+        if (!wasModified && session.isModified()) {
+            flushAt = Clock::now() + std::chrono::milliseconds(FLUSH_DELAY_MS);
+        }
+
+        // Drop clients that stopped half way through a request
+        const Clock::time_point now = Clock::now();
+        std::vector<int> expired;
+        for (const auto &connection : connections) {
+            if (!connection.second->input.empty() && !connection.second->busy &&
+                now - connection.second->since >= std::chrono::seconds(REQUEST_TIMEOUT_S)) {
+                expired.push_back(connection.first);
+            }
+        }
+        for (int fd : expired) {
+            disconnect(fd);
+        }
+
+        if (diverged) {
+            // The changes can never be saved
+            running = false;
+        } else if (session.isModified() && !session.isSaving() && now >= flushAt) {
+            save();
+        }
+
+        if (session.getReplica() && now >= followAt) {
+            try {
+                session.catchUp();
+            } catch (const std::runtime_error &e) {
+                // The copy is served as it is until the primary can be read
+                std::cerr << "Error: failed to load " << session.getDb() << ": " << e.what()
+                          << std::endl;
+            }
+            followAt = Clock::now() + std::chrono::milliseconds(FOLLOW_INTERVAL_MS);
+        }
+    }
+    return !diverged && flush() ? 0 : 1;
+}
+
+// Accept every waiting connection
+void Server::accept() {
+    while (true) {
+        int fd = ::accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        std::unique_ptr<Connection> connection(new Connection());
+        connection->fd = fd;
+        connection->id = ++accepted;
+        connection->sent = 0;
+        connection->closing = false;
+        connection->writing = false;
+        connection->busy = false;
+        connections[fd] = std::move(connection);
+        poller->watch(fd, true, false, false);
+    }
+}
+
+/*
+    * Function to read what a client has sent, then run and answer every
+    * whole request in it
+    * @param connection: The connection to read from
+    * @return bool: False if the connection should be closed
+*/
+bool Server::receive(Connection &connection) {
+    const bool waiting = !connection.input.empty();
+    char buffer[64 * 1024];
+    while (!connection.closing) {
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return false;
+        }
+        if (received == 0) {
+            connection.closing = true;
+        }
+        connection.input.append(buffer, received);
+    }
+    const std::size_t size = connection.input.size();
+    handle(connection);
+    // The timeout starts again with each request
+    if (!connection.input.empty() && (!waiting || connection.input.size() < size)) {
+        connection.since = Clock::now();
+    }
+    return send(connection);
+}
+
+/*
+    * Function to send as much of the answers to a connection as it takes
+    * without waiting
+    * @param connection: The connection to send to
+    * @return bool: False if the connection should be closed
+*/
+bool Server::send(Connection &connection) {
+    while (connection.sent < connection.output.size()) {
+        ssize_t written = ::send(connection.fd, connection.output.data() + connection.sent,
+                                 connection.output.size() - connection.sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return false;
+        }
+        connection.sent += written;
+    }
+    if (connection.sent == connection.output.size()) {
+        connection.output.clear();
+        connection.sent = 0;
+        // A client that has finished sending still waits for its last read
+        if (connection.closing && !connection.busy) {
+            return false;
+        }
+    }
+
+    // Only wait for the socket to be writable while there is something to send
+    const bool writing = !connection.output.empty();
+    if (writing != connection.writing || connection.closing) {
+        poller->watch(connection.fd, !connection.closing, writing, true);
+        connection.writing = writing;
+    }
+    return true;
+}
+
+// Function to run every whole request a connection has received, in order,
+// stopping at a read handed to the reader until it has been answered
+void Server::handle(Connection &connection) {
+    std::size_t position = 0;
+    std::vector<String> arguments;
+    int parsed = 0;
+    while (!connection.busy &&
+           (parsed = parseRequest(connection.input, position, arguments)) == 1) {
+        if (!read(connection, arguments)) {
+            std::ostringstream out, err;
+            const std::int32_t status = App::execute(session, options, arguments, out, err);
+            appendResponse(connection.output, status, out.str(), err.str());
+        }
+    }
+    if (parsed < 0) {
+        // Nothing after a malformed request can be understood
+        connection.closing = true;
+        connection.input.clear();
+    } else {
+        connection.input.erase(0, position);
+    }
+}
+
+/*
+    * Function to hand a request to the reader, if it only reads, to be
+    * answered from a Snapshot of the TodoList as it is now
+    * @param connection: The connection the request came from, busy until
+    * it is answered
+    * @param arguments: The arguments of the request
+    * @return bool: False if the request has to be run by execute instead
+*/
+bool Server::read(Connection &connection, const std::vector<String> &arguments) {
+    std::vector<const char *> argv;
+    for (const String &argument : arguments) {
+        argv.push_back(argument.c_str());
+    }
+    std::shared_ptr<cxxopts::ParseResult> args;
+    try {
+        args = std::make_shared<cxxopts::ParseResult>(
+            options.parse(static_cast<int>(argv.size()), argv.data()));
+    } catch (const std::exception &) {
+        // Reported by execute
+        return false;
+    }
+    if (!App::readsSnapshot(*args)) {
+        return false;
+    }
+
+    std::shared_ptr<const Snapshot> snapshot = session.getTodoList().snapshot();
+    const int fd = connection.fd;
+    const unsigned long id = connection.id;
+    connection.busy = true;
+    reader->post([this, snapshot, args, fd, id] {
+        std::ostringstream out, err;
+        const std::int32_t status = App::printJson(*snapshot, *args, out, err);
+        String response;
+        appendResponse(response, status, out.str(), err.str());
+        complete([this, fd, id, response] { answer(fd, id, response); });
+    });
+    return true;
+}
+
+/*
+    * Function to send the answer to a read to the connection it came from,
+    * if it is still open, and go on with the requests after it
+    * @param fd: The socket of the connection
+    * @param id: The number of the connection
+    * @param response: The answer
+*/
+void Server::answer(int fd, unsigned long id, const String &response) {
+    auto it = connections.find(fd);
+    if (it == connections.end() || it->second->id != id) {
+        return;
+    }
+    Connection &connection = *it->second;
+    connection.output.append(response);
+    connection.busy = false;
+    handle(connection);
+    // The timeout of a request waiting behind the read starts now
+    if (!connection.input.empty()) {
+        connection.since = Clock::now();
+    }
+    if (!send(connection)) {
+        disconnect(fd);
+    }
+}
+
+/*
+    * Function to have run do something a Worker has finished, on its own
+    * thread. Safe to call from any thread.
+    * @param done: What to do
+*/
+void Server::complete(std::function<void()> done) {
+    {
+        std::lock_guard<std::mutex> lock(finishedMutex);
+        finished.push_back(std::move(done));
+    }
+    const char byte = 0;
+    ssize_t written = write(ready[1], &byte, 1);
+    (void)written;
+}
+
+// Function to do everything the Workers have finished since it was last called
+void Server::finish() {
+    char buffer[256];
+    while (::read(ready[0], buffer, sizeof(buffer)) > 0) {
+        /* drained */
+    }
+    std::vector<std::function<void()>> done;
+    {
+        std::lock_guard<std::mutex> lock(finishedMutex);
+        done.swap(finished);
+    }
+    for (const auto &fn : done) {
+        fn();
+    }
+}
+
+// Function to stop watching and close a connection
+void Server::disconnect(int fd) {
+    poller->forget(fd);
+    close(fd);
+    connections.erase(fd);
+}
+
+/*
+    * Function to save any changes to the database. If another process has
+    * saved it since, what it saved is loaded and the changes made again on
+    * top of it before saving.
+    * @return bool: False if the changes could not be saved, with diverged
+    * set if they never can be
+*/
+bool Server::flush() {
+    try {
+        session.save();
+        return true;
+    } catch (const ConflictError &) {
+        // Saved by another process since it was loaded
+    } catch (const std::exception &e) {
+        std::cerr << "Error: failed to save " << session.getDb() << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    try {
+        session.reload();
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << session.getDb() << " was saved by another process, and "
+                  << "the changes not yet saved to it no longer apply: " << e.what() << std::endl;
+        diverged = true;
+        return false;
+    }
+    return flush();
+}
+
+// Function to begin saving the changes, written by the saver while
+// commands go on being run
+void Server::save() {
+    std::shared_ptr<TodoList::PendingSave> pending = session.beginSave();
+    if (!pending) {
+        return;
+    }
+    saver->post([this, pending] {
+        pending->write();
+        complete([this] { saved(); });
+    });
+}
+
+/*
+    * Function to take the result of the save written by the saver. If
+    * another process has saved the database since, the changes are made
+    * again on top of what it saved and saved again straight away; if they
+    * no longer fit, diverged is set.
+*/
+void Server::saved() {
+    if (!session.isSaving()) {
+        // Already taken, such as by a command undoing its changes
+        return;
+    }
+    try {
+        session.finishSave();
+        // Changes made while it was written are saved after the usual delay
+        flushAt = Clock::now() + std::chrono::milliseconds(FLUSH_DELAY_MS);
+        return;
+    } catch (const ConflictError &) {
+        // Saved by another process since it was loaded
+    } catch (const std::exception &e) {
+        std::cerr << "Error: failed to save " << session.getDb() << ": " << e.what() << std::endl;
+        // Try again later rather than on every command
+        flushAt = Clock::now() + std::chrono::milliseconds(FLUSH_DELAY_MS);
+        return;
+    }
+
+    try {
+        session.reload();
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << session.getDb() << " was saved by another process, and "
+                  << "the changes not yet saved to it no longer apply: " << e.what() << std::endl;
+        diverged = true;
+        return;
+    }
+    flushAt = Clock::now();
+}
+
+// Function to make run return, safe to call from another thread
+void Server::stop() noexcept {
+    const char byte = 0;
+    ssize_t written = write(wakeup[1], &byte, 1);
+    (void)written;
+}
+
+// Function to stop the Server on an interrupt or terminate signal
+void Server::stopOnSignals() {
+    signalWakeup = wakeup[1];
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = onSignal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+}
+
+/*
+    * Constructor to connect to the Server serving a database
+    * @param db: The filename of the database
+*/
+Server::Client::Client(const String &db) : fd(connectTo(socketPath(db))) {}
+
+Server::Client::~Client() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+// Function to check if a Server is serving the database
+bool Server::Client::isConnected() const noexcept {
+    return fd >= 0;
+}
+
+/*
+    * Function to send a command, without waiting for its answer
+    * @param arguments: The arguments of the command, starting with the program name
+    * @return bool: False if the command could not be sent
+*/
+bool Server::Client::send(const std::vector<String> &arguments) {
+    if (fd < 0 || arguments.empty() || arguments.size() > MAX_ARGUMENTS) {
+        return false;
+    }
+    const std::uint32_t count = arguments.size();
+    bool sent = writeAll(fd, &count, sizeof(count));
+    for (std::size_t i = 0; sent && i < arguments.size(); i++) {
+        sent = writeString(fd, arguments[i]);
+    }
+    return sent;
+}
+
+/*
+    * Function to wait for the answer to the oldest command sent and not yet
+    * answered
+    * @param status: Set to the exit code of the command
+    * @param out: Set to what the command printed
+    * @param err: Set to the errors the command printed
+    * @return bool: False if the connection was lost
+*/
+bool Server::Client::receive(int &status, String &out, String &err) {
+    std::int32_t result;
+    if (fd < 0 || !readAll(fd, &result, sizeof(result)) ||
+        !readString(fd, out, UINT32_MAX) || !readString(fd, err, UINT32_MAX)) {
+        return false;
+    }
+    status = result;
+    return true;
+}
+
+/*
+    * Function to run a command in the Server serving a database, if there is
+    * one
+    * @param db: The filename of the database
+    * @param argc: The number of arguments of the command
+    * @param argv: The arguments of the command
+    * @param out: The stream to print the result of the command to
+    * @param err: The stream to print errors to
+    * @param status: Set to the exit code of the command
+    * @return bool: True if the command was run by a Server, false if no
+    * Server is serving the database
+*/
+bool Server::forward(const String &db, int argc, const char *const argv[],
+                     std::ostream &out, std::ostream &err, int &status) {
+    Client client(db);
+    if (!client.isConnected()) {
+        return false;
+    }
+
+    String text, errors;
+    if (client.send(std::vector<String>(argv, argv + argc)) &&
+        client.receive(status, text, errors)) {
+        out << text << std::flush;
+        err << errors << std::flush;
+    } else {
+        // The command may or may not have run, so it cannot be run here
+        err << "Error: lost connection to the server for " << db << std::endl;
+        status = 1;
+    }
+    return true;
+}
+
+#else
+
+class Server::Poller {};
+
+class Server::Worker {};
+
+struct Server::Connection {};
+
+Server::Server(const String &db, const String &)
+    : session(db), options(App::cxxoptsSetup()), path(socketPath(db)),
+      listener(-1), wakeup{-1, -1}, diverged(false), accepted(0), ready{-1, -1} {
+    throw std::runtime_error("Serving a database is not supported on Windows");
+}
+
+Server::~Server() {}
+
+int Server::run() {
+    return 1;
+}
+
+void Server::accept() {}
+
+bool Server::receive(Connection &) {
+    return false;
+}
+
+bool Server::send(Connection &) {
+    return false;
+}
+
+void Server::handle(Connection &) {}
+
+bool Server::read(Connection &, const std::vector<String> &) {
+    return false;
+}
+
+void Server::answer(int, unsigned long, const String &) {}
+
+void Server::complete(std::function<void()>) {}
+
+void Server::finish() {}
+
+void Server::disconnect(int) {}
+
+bool Server::flush() {
+    return false;
+}
+
+void Server::save() {}
+
+void Server::saved() {}
+
+Server::Client::Client(const String &) : fd(-1) {}
+
+Server::Client::~Client() {}
+
+bool Server::Client::isConnected() const noexcept {
+    return false;
+}
+
+bool Server::Client::send(const std::vector<String> &) {
+    return false;
+}
+
+bool Server::Client::receive(int &, String &, String &) {
+    return false;
+}
+
+void Server::stop() noexcept {}
+
+void Server::stopOnSignals() {}
+
+bool Server::forward(const String &, int, const char *const[], std::ostream &,
+                     std::ostream &, int &) {
+    return false;
+}
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the Server class.
+ * A Server loads a database once and runs the commands it is sent over a
+ * Unix domain socket, named after the database with '.sock' appended,
+ * against the TodoList held in memory. Changes are written back to the
+ * database a short while after the first unsaved change (so that a burst of
+ * commands is saved once) and when the Server stops. The save is written on
+ * a thread of its own from a Snapshot, so commands are served while it is
+ * written and those made meanwhile are saved by the next. If another process
+ * saved the database meanwhile, the Server loads what it saved and makes its
+ * own changes again on top; if they no longer fit, the Server stops rather
+ * than serve commands it cannot save.
+ * Each command is sent as its arguments and answered with its exit code and
+ * the text it printed, so that forward can make a todo command run by a
+ * Server look exactly like one run on its own.
+ * A Server waits for all of its connections at once (with epoll on Linux)
+ * and never blocks on any one of them. Each connection keeps the part of a
+ * request received so far and the part of the responses not yet sent, so
+ * that slow clients do not hold up the others, and a client (such as a
+ * Server::Client) can send many commands on one connection without waiting
+ * for each answer; they are run, and answered, in order.
+ * json commands (other than a search) are answered on a thread of their own
+ * from a Snapshot of the TodoList taken when the command is reached, so a
+ * large read does not hold up the commands of other connections, and a
+ * command changing the TodoList meanwhile is not seen by the read.
+ * A Server can instead serve a read-only copy of another database, the
+ * primary, which it keeps up to date by reading the changes saved to the
+ * primary's journal (see Replica), so that reads can be moved away from the
+ * process or host changing the database.
+ * Servers are not supported on Windows, where every command runs on its own.
+*/
+
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "lib_cxxopts.hpp"
+#include "session.h"
+
+class Server {
+  class Poller;
+  class Worker;
+  struct Connection;
+
+  Session session;
+  cxxopts::Options options;
+  String path;
+  int listener;
+
+  // Written to by stop to wake up run
+  int wakeup[2];
+
+  // Set when another process saved the database and the changes held in
+  // memory could not be made again on top of what it saved
+  bool diverged;
+
+  // When the changes not yet saved are next saved
+  std::chrono::steady_clock::time_point flushAt;
+
+  std::unique_ptr<Poller> poller;
+  std::map<int, std::unique_ptr<Connection>> connections;
+
+  // The number of connections accepted, which numbers each of them
+  unsigned long accepted;
+
+  // Answers json commands from Snapshots, and writes saves
+  std::unique_ptr<Worker> reader;
+  std::unique_ptr<Worker> saver;
+
+  // What the Worker threads have finished, to be done by run, which is
+  // woken up by a byte written to ready
+  int ready[2];
+  std::mutex finishedMutex;
+  std::vector<std::function<void()>> finished;
+
+  void accept();
+  bool receive(Connection &connection);
+  bool send(Connection &connection);
+  void handle(Connection &connection);
+  bool read(Connection &connection, const std::vector<String> &arguments);
+  void answer(int fd, unsigned long id, const String &response);
+  void disconnect(int fd);
+  bool flush();
+  void save();
+  void saved();
+  void complete(std::function<void()> done);
+  void finish();
+
+public:
+  // A connection to a Server, on which commands can be sent ahead of their answers
+  class Client {
+    int fd;
+
+  public:
+    explicit Client(const String &db);
+    Client(const Client &other) = delete;
+    Client &operator=(const Client &other) = delete;
+    ~Client();
+
+    bool isConnected() const noexcept;
+    bool send(const std::vector<String> &arguments);
+    bool receive(int &status, String &out, String &err);
+  };
+
+  // How long after the first unsaved change the database is saved
+  static const int FLUSH_DELAY_MS = 1000;
+
+  // How often a Server serving a copy of another database reads its journal
+  static const int FOLLOW_INTERVAL_MS = 100;
+
+  explicit Server(const String &db, const String &primary = "");
+  Server(const Server &other) = delete;
+  Server &operator=(const Server &other) = delete;
+  ~Server();
+
+  int run();
+  void stop() noexcept;
+  void stopOnSignals();
+
+  static String socketPath(const String &db);
+  static bool forward(const String &db, int argc, const char *const argv[],
+                      std::ostream &out, std::ostream &err, int &status);
+};
+
+#endif // SERVER_H
@@ -0,0 +1,278 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the Session class.
+*/
+
+
+#include "session.h"
+
+#include <stdexcept>
+
+
+/*
+    * Constructor to create a Session for a database, without loading it
+    * @param db: The filename of the database
+*/
+Session::Session(const String &db)
+    : db(db), tl(), loaded(false), modified(false), modifications(0), savedModifications(0) {}
+
+// Function to return the filename of the database
+const String &Session::getDb() const noexcept {
+    return db;
+}
+
+// Function to return true if the TodoList has been loaded
+bool Session::isLoaded() const noexcept {
+    return loaded;
+}
+
+/*
+    * Function to return the TodoList, loading it from the database the
+    * first time
+    * @return TodoList&: The TodoList
+*/
+TodoList &Session::getTodoList() {
+    if (!loaded) {
+        tl.load(db);
+        loaded = true;
+    }
+    return tl;
+}
+
+// Function to record that the TodoList has changed and needs saving
+void Session::setModified() noexcept {
+    modified = true;
+    modifications++;
+    completions.reset();
+}
+
+// Function to return true if the TodoList has changed since it was saved
+bool Session::isModified() const noexcept {
+    return modified;
+}
+
+/*
+    * Function to save the TodoList to the database if it has changed, unless
+    * the Session follows it, once any save begun by beginSave has finished
+    * @throws ConflictError: If another process has saved the database since
+    * it was loaded, see reload
+    * @throws std::runtime_error: If the database cannot be written
+*/
+void Session::save() {
+    finishSave();
+    if (modified && !replica) {
+        tl.save(db);
+        modified = false;
+    }
+}
+
+/*
+    * Function to load the database again, after another process has saved
+    * it, and make the changes not yet saved to it again. What it saved is
+    * taken from the save that found it, if that save loaded it.
+    * @throws std::runtime_error: If the database cannot be loaded, or a
+    * change cannot be made again, in which case the Session is unchanged
+    * @throws std::out_of_range: If a change is to a project or task that is
+    * no longer in the database
+*/
+void Session::reload() {
+    settle();
+    const unsigned int count = loaded ? tl.getChanges().size() : 0;
+    std::unique_ptr<TodoList> fresh = std::move(reloaded);
+    if (!fresh) {
+        fresh.reset(new TodoList());
+        fresh->load(db);
+    }
+    rebase(std::move(*fresh), count);
+}
+
+/*
+    * Function to undo the changes not yet saved after the first count of
+    * them, such as those of a command that failed part way through, by
+    * loading the database again and making only the first count again
+    * @param count: The number of changes to keep
+    * @throws std::runtime_error: If the database cannot be loaded, or a
+    * change cannot be made again, in which case the Session is unchanged
+    * @throws std::out_of_range: If a change is to a project or task that is
+    * no longer in the database
+*/
+void Session::restore(unsigned int count) {
+    // The changes a save finishing now saved are in the database loaded
+    const unsigned int saved = settle();
+    count = count > saved ? count - saved : 0;
+    reloaded.reset();
+    TodoList fresh;
+    fresh.load(db);
+    rebase(std::move(fresh), count);
+}
+
+/*
+    * Function to replace the TodoList with one loaded from the database,
+    * with the first count of the changes not yet saved made again on it
+    * @param fresh: The TodoList loaded
+    * @param count: The number of changes to make again
+    * @throws std::runtime_error: If a change cannot be made again, in which
+    * case the Session is unchanged
+    * @throws std::out_of_range: If a change is to a project or task that is
+    * no longer in the database
+*/
+void Session::rebase(TodoList fresh, unsigned int count) {
+    if (loaded) {
+        const std::vector<Json> &changes = tl.getChanges().recorded();
+        for (unsigned int i = 0; i < count && i < changes.size(); i++) {
+            fresh.replay(changes[i]);
+        }
+    }
+    tl = std::move(fresh);
+    loaded = true;
+    completions.reset();
+}
+
+/*
+    * Function to begin saving the TodoList as it is now, if it has changed,
+    * unless the Session follows its database or a save is already being
+    * written. The save is written by calling its write, on any thread, and
+    * its result taken by finishSave, while commands go on changing the
+    * TodoList.
+    * @return std::shared_ptr<TodoList::PendingSave>: The save, or null if
+    * there is nothing to save
+*/
+std::shared_ptr<TodoList::PendingSave> Session::beginSave() {
+    if (!modified || replica || saving) {
+        return nullptr;
+    }
+    saving = tl.beginSave(db);
+    savedModifications = modifications;
+    return saving;
+}
+
+/*
+    * Function to take the result of the save begun by beginSave, waiting
+    * for it to be written if it has not been yet. The Session stays
+    * modified if commands changed the TodoList meanwhile.
+    * @throws ConflictError: If another process saved the database first,
+    * in which case reload makes the changes again on what it saved
+    * @throws std::runtime_error: If the database cannot be written, in which
+    * case the changes are kept to be saved again
+*/
+void Session::finishSave() {
+    if (!saving) {
+        return;
+    }
+    std::shared_ptr<TodoList::PendingSave> save = std::move(saving);
+    saving.reset();
+    try {
+        tl.finishSave(*save);
+    } catch (const ConflictError &) {
+        reloaded = save->takeReloaded();
+        throw;
+    }
+    modified = modifications != savedModifications;
+}
+
+// Function to return true while a save begun by beginSave has not finished
+bool Session::isSaving() const noexcept {
+    return saving != nullptr;
+}
+
+// Function to finish any save still being written, whatever its result,
+// returning the number of changes it saved
+unsigned int Session::settle() noexcept {
+    if (!saving) {
+        return 0;
+    }
+    const unsigned int count = saving->size();
+    try {
+        finishSave();
+        return count;
+    } catch (const std::exception &) {
+        // The changes are all still held, to be saved again
+        return 0;
+    }
+}
+
+/*
+    * Function to make the Session a read-only copy of its database, loaded
+    * now and kept up to date from its journal by catchUp
+    * @throws std::runtime_error: If the database cannot be loaded, or its
+    * journal cannot be started
+*/
+void Session::follow() {
+    replica.reset(new Replica(db));
+    getTodoList();
+}
+
+// Function to return the Replica keeping the TodoList up to date, or null
+// unless the Session follows its database
+const Replica *Session::getReplica() const noexcept {
+    return replica.get();
+}
+
+/*
+    * Function to apply the changes saved to the database since the last
+    * time, if the Session follows it
+    * @return unsigned int: The number of changes applied
+*/
+unsigned int Session::catchUp() {
+    if (!replica) {
+        return 0;
+    }
+    const unsigned int applied = replica->poll(getTodoList());
+    if (applied > 0) {
+        completions.reset();
+    }
+    return applied;
+}
+
+/*
+    * Function to return the counters of each project. Unless the TodoList is
+    * already loaded they are read from the file saved alongside the
+    * database, and that file is refreshed if it was missing or out of date.
+    * @return StatsContainer: The counters of each project
+*/
+StatsContainer Session::getStats() {
+    StatsContainer stats;
+    if (!loaded && TodoList::loadStats(db, stats)) {
+        return stats;
+    }
+
+    const bool refresh = !loaded;
+    stats = getTodoList().projectStats();
+    if (refresh) {
+        try {
+            tl.saveStats(db);
+        } catch (const std::runtime_error &e) {
+            // Not fatal, the counters are recomputed on the next stats action
+        }
+    }
+    return stats;
+}
+
+/*
+    * Function to return the completions of the TodoList. Unless the TodoList
+    * is already loaded they are mapped from the file saved alongside the
+    * database, and that file is rebuilt if it was missing or out of date.
+    * @return const Completions&: The completions
+*/
+const Completions &Session::getCompletions() {
+    if (completions) {
+        return *completions;
+    }
+
+    completions.reset(new Completions());
+    if (!loaded && completions->load(db)) {
+        return *completions;
+    }
+
+    const bool refresh = !loaded;
+    completions->build(getTodoList());
+    if (refresh) {
+        try {
+            completions->save(db, tl.getGeneration());
+        } catch (const std::runtime_error &e) {
+            // Not fatal, the completions are rebuilt on the next complete action
+        }
+    }
+    return *completions;
+}
@@ -0,0 +1,83 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the Session class.
+ * A Session is the database a command runs against. The TodoList is only
+ * loaded from the database the first time it is needed, so that the stats
+ * and complete actions can be answered from the files saved alongside it,
+ * and is then kept in memory, so that a Session serving many commands (see
+ * Server) only parses the database once. Commands that change the TodoList
+ * mark the Session as modified, and the TodoList is written back by save.
+ * If another process saves the database first, reload loads what it saved
+ * and makes the changes not yet saved again on top of it.
+ * A save can also be begun with beginSave and written on another thread
+ * (see TodoList::PendingSave) while commands go on changing the TodoList;
+ * finishSave takes its result, and the Session stays modified if there
+ * were changes made meanwhile.
+ * A Session that follows its database is a read-only copy of it, kept up
+ * to date by a Replica with catchUp, and is never saved.
+*/
+
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <memory>
+
+#include "prefixindex.h"
+#include "replica.h"
+#include "todolist.h"
+
+class Session {
+  String db;
+  TodoList tl;
+  bool loaded;
+  bool modified;
+
+  // Counts the commands that changed the TodoList, to tell whether any were
+  // run while the save being written was
+  unsigned long modifications;
+  unsigned long savedModifications;
+  std::shared_ptr<TodoList::PendingSave> saving;
+
+  // Loaded by the last save, when another process saved first, for reload
+  std::unique_ptr<TodoList> reloaded;
+
+  // Built by the first complete action and kept until the TodoList changes
+  std::unique_ptr<Completions> completions;
+
+  // Set by follow, when the changes come from the database's journal
+  std::unique_ptr<Replica> replica;
+
+  unsigned int settle() noexcept;
+  void rebase(TodoList fresh, unsigned int count);
+
+public:
+  explicit Session(const String &db);
+  Session(const Session &other) = delete;
+  Session &operator=(const Session &other) = delete;
+  ~Session() = default;
+
+  const String &getDb() const noexcept;
+  bool isLoaded() const noexcept;
+  TodoList &getTodoList();
+
+  void setModified() noexcept;
+  bool isModified() const noexcept;
+  void save();
+  void reload();
+  void restore(unsigned int count);
+
+  std::shared_ptr<TodoList::PendingSave> beginSave();
+  void finishSave();
+  bool isSaving() const noexcept;
+
+  void follow();
+  const Replica *getReplica() const noexcept;
+  unsigned int catchUp();
+
+  StatsContainer getStats();
+  const Completions &getCompletions();
+};
+
+#endif // SESSION_H
@@ -0,0 +1,47 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the Simd class.
+*/
+
+
+#include "simd.h"
+
+
+/*
+    * Function to check whether the CPU can run code of a level
+    * @param level: The level
+    * @return bool: True if it can
+*/
+bool Simd::supported(Level level) noexcept {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    switch (level) {
+        case AVX2:
+            return __builtin_cpu_supports("avx2");
+        case SSE2:
+            return __builtin_cpu_supports("sse2");
+        default:
+            return true;
+    }
+#else
+    return level == SCALAR;
+#endif
+}
+
+// Function to return the fastest level the CPU supports
+Simd::Level Simd::best() noexcept {
+    return supported(AVX2) ? AVX2 : supported(SSE2) ? SSE2 : SCALAR;
+}
+
+// Function to return the name of a level
+const char *Simd::name(Level level) noexcept {
+    switch (level) {
+        case AVX2:
+            return "avx2";
+        case SSE2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
@@ -0,0 +1,30 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the Simd class.
+ * Code with a vectorised path (escaping JSON strings, indexing a database
+ * as it is loaded) has one for each Level: a byte at a time, 16 bytes at a
+ * time with SSE2 and 32 at a time with AVX2. The Simd class says which the
+ * CPU supports, so that the fastest can be chosen when the program runs.
+ * The vectorised paths are only compiled for x86 with GCC or Clang, which
+ * is what SIMD_X86 is defined for.
+*/
+
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86
+#endif
+
+class Simd {
+public:
+  enum Level { SCALAR, SSE2, AVX2 };
+
+  static bool supported(Level level) noexcept;
+  static Level best() noexcept;
+  static const char *name(Level level) noexcept;
+};
+
+#endif // SIMD_H
@@ -0,0 +1,53 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the Snapshot class.
+ */
+
+
+#include "snapshot.h"
+#include "jsonwriter.h"
+
+#include <algorithm>
+
+/*
+    * Constructor to create a Snapshot from published Projects
+    * @param projects: The Projects, sorted by identifier
+*/
+Snapshot::Snapshot(SnapshotContainer projects) : projects(std::move(projects)) {}
+
+// Returns the number of projects in the Snapshot
+unsigned int Snapshot::size() const noexcept {
+    return projects.size();
+}
+
+// Returns the projects in the Snapshot, sorted by identifier
+const SnapshotContainer &Snapshot::getProjects() const noexcept {
+    return projects;
+}
+
+/*
+    * Function to find a project in the Snapshot
+    * @param identifier: The identifier of the project to find
+    * @return const Project*: The project, or null if there is none
+*/
+const Project *Snapshot::findProject(const String &identifier) const noexcept {
+    auto it = std::lower_bound(projects.begin(), projects.end(), identifier,
+                               [](const std::shared_ptr<const Project> &project, const String &ident) {
+                                   return project->getIdent() < ident;
+                               });
+    if (it == projects.end() || (*it)->getIdent() != identifier) {
+        return nullptr;
+    }
+    return it->get();
+}
+
+// Function to write the Snapshot as JSON, as TodoList::write does
+void Snapshot::write(JsonWriter &writer) const {
+    writer.beginObject();
+    for (const auto &project : projects) {
+        writer.key(project->getIdent());
+        project->write(writer);
+    }
+    writer.endObject();
+}
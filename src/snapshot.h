@@ -0,0 +1,40 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the Snapshot class.
+ * A Snapshot is a TodoList as it was at one moment and never changes, so it
+ * can be read on another thread while the TodoList goes on being changed
+ * (a Server answers json commands from one). It holds the copy of each
+ * Project made by Project::publish, so a Project that has not changed since
+ * the last Snapshot is shared with it, and taking a Snapshot only copies the
+ * Projects changed since.
+*/
+
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <memory>
+#include <vector>
+
+#include "project.h"
+
+using SnapshotContainer = std::vector<std::shared_ptr<const Project>>;
+
+class Snapshot {
+  // Sorted by identifier
+  SnapshotContainer projects;
+
+public:
+  explicit Snapshot(SnapshotContainer projects);
+  Snapshot(const Snapshot &other) = delete;
+  Snapshot &operator=(const Snapshot &other) = delete;
+  ~Snapshot() = default;
+
+  unsigned int size() const noexcept;
+  const SnapshotContainer &getProjects() const noexcept;
+  const Project *findProject(const String &identifier) const noexcept;
+  void write(JsonWriter &writer) const;
+};
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,259 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the Stats class.
+*/
+
+
+#include "stats.h"
+#include "jsonwriter.h"
+
+
+// Constructor to create an empty set of counters
+Stats::Stats() : tasks(0), completed(0) {}
+
+// Count an incomplete task due on the given date
+void Stats::addOpenDue(const Date &date) {
+    if (date.isInitialised()) {
+        openDue[date]++;
+    }
+}
+
+// Stop counting an incomplete task due on the given date
+void Stats::removeOpenDue(const Date &date) {
+    if (!date.isInitialised()) {
+        return;
+    }
+    auto it = openDue.find(date);
+    if (it != openDue.end() && --(it->second) == 0) {
+        openDue.erase(it);
+    }
+}
+
+// Function to count a task that has been added to the collection
+void Stats::addTask(const Task &task) {
+    tasks++;
+    if (task.isComplete()) {
+        completed++;
+    } else {
+        addOpenDue(task.getDueDate());
+    }
+    for (const String &tag : task.getTags()) {
+        addTag(tag);
+    }
+}
+
+// Function to stop counting a task that has been removed from the collection
+void Stats::removeTask(const Task &task) {
+    tasks--;
+    if (task.isComplete()) {
+        completed--;
+    } else {
+        removeOpenDue(task.getDueDate());
+    }
+    for (const String &tag : task.getTags()) {
+        removeTag(tag);
+    }
+}
+
+/*
+    * Function to update the counters before a task's completed state changes
+    * @param task: The task, still in its previous state
+    * @param completed: The new completed state
+*/
+void Stats::setComplete(const Task &task, bool completed) {
+    if (task.isComplete() == completed) {
+        return;
+    }
+    if (completed) {
+        this->completed++;
+        removeOpenDue(task.getDueDate());
+    } else {
+        this->completed--;
+        addOpenDue(task.getDueDate());
+    }
+}
+
+/*
+    * Function to update the counters before a task's due date changes
+    * @param task: The task, still with its previous due date
+    * @param date: The new due date
+*/
+void Stats::setDueDate(const Task &task, const Date &date) {
+    if (task.isComplete()) {
+        return;
+    }
+    removeOpenDue(task.getDueDate());
+    addOpenDue(date);
+}
+
+// Function to count a tag added to a task
+void Stats::addTag(const String &tag) {
+    tagCounts[tag]++;
+}
+
+// Function to stop counting a tag removed from a task
+void Stats::removeTag(const String &tag) {
+    auto it = tagCounts.find(tag);
+    if (it != tagCounts.end() && --(it->second) == 0) {
+        tagCounts.erase(it);
+    }
+}
+
+// Function to add the counters of another collection to this one
+void Stats::merge(const Stats &other) {
+    tasks += other.tasks;
+    completed += other.completed;
+    for (const auto &entry : other.tagCounts) {
+        tagCounts[entry.first] += entry.second;
+    }
+    for (const auto &entry : other.openDue) {
+        openDue[entry.first] += entry.second;
+    }
+}
+
+// Function to remove the counters of another collection from this one
+void Stats::subtract(const Stats &other) {
+    tasks -= other.tasks;
+    completed -= other.completed;
+    for (const auto &entry : other.tagCounts) {
+        auto it = tagCounts.find(entry.first);
+        if (it != tagCounts.end() && (it->second -= entry.second) == 0) {
+            tagCounts.erase(it);
+        }
+    }
+    for (const auto &entry : other.openDue) {
+        auto it = openDue.find(entry.first);
+        if (it != openDue.end() && (it->second -= entry.second) == 0) {
+            openDue.erase(it);
+        }
+    }
+}
+
+// Function to return the number of tasks
+unsigned long Stats::numTasks() const noexcept {
+    return tasks;
+}
+
+// Function to return the number of completed tasks
+unsigned long Stats::numCompleted() const noexcept {
+    return completed;
+}
+
+/*
+    * Function to return the number of incomplete tasks due before a date
+    * @param today: The date to compare the due dates against
+    * @return unsigned long: The number of overdue tasks
+*/
+unsigned long Stats::numOverdue(const Date &today) const {
+    unsigned long overdue = 0;
+    for (auto it = openDue.begin(); it != openDue.end() && it->first < today; it++) {
+        overdue += it->second;
+    }
+    return overdue;
+}
+
+// Function to return the number of distinct tags in use
+unsigned long Stats::numTags() const noexcept {
+    return tagCounts.size();
+}
+
+// Function to return the number of tasks carrying each tag
+const std::map<String, unsigned long> &Stats::getTagCounts() const noexcept {
+    return tagCounts;
+}
+
+/*
+    * Function to return the counters as reported by the stats action
+    * @param today: The date used to decide whether a task is overdue
+    * @return Json: The counters
+*/
+Json Stats::summary(const Date &today) const {
+    Json j;
+    j["tasks"] = tasks;
+    j["completed"] = completed;
+    j["overdue"] = numOverdue(today);
+    j["tags"] = tagCounts.size();
+    return j;
+}
+
+/*
+    * Function to return the JSON representation of the counters, which holds
+    * everything needed to restore them with fromJson
+    * @return Json: The JSON representation of the Stats object
+*/
+Json Stats::json() const {
+    Json j;
+    j["tasks"] = tasks;
+    j["completed"] = completed;
+    j["tags"] = Json::object();
+    for (const auto &entry : tagCounts) {
+        j["tags"][entry.first] = entry.second;
+    }
+    j["due"] = Json::array();
+    for (const auto &entry : openDue) {
+        j["due"].push_back({entry.first.getYear(), entry.first.getMonth(),
+                            entry.first.getDay(), entry.second});
+    }
+    return j;
+}
+
+/*
+    * Function to write the JSON representation of the counters, the same as
+    * json().dump() prints it
+    * @param writer: The JsonWriter to write to
+*/
+void Stats::write(JsonWriter &writer) const {
+    writer.beginObject();
+    writer.key("completed");
+    writer.number(static_cast<unsigned long long>(completed));
+    writer.key("due");
+    writer.beginArray();
+    for (const auto &entry : openDue) {
+        writer.beginArray();
+        writer.number(static_cast<unsigned long long>(entry.first.getYear()));
+        writer.number(static_cast<unsigned long long>(entry.first.getMonth()));
+        writer.number(static_cast<unsigned long long>(entry.first.getDay()));
+        writer.number(static_cast<unsigned long long>(entry.second));
+        writer.endArray();
+    }
+    writer.endArray();
+    writer.key("tags");
+    writer.beginObject();
+    for (const auto &entry : tagCounts) {
+        writer.key(entry.first);
+        writer.number(static_cast<unsigned long long>(entry.second));
+    }
+    writer.endObject();
+    writer.key("tasks");
+    writer.number(static_cast<unsigned long long>(tasks));
+    writer.endObject();
+}
+
+/*
+    * Function to restore counters from their JSON representation
+    * @param j: The JSON representation, as returned by json()
+    * @return Stats: The restored counters
+    * @throws Json::exception: If the JSON representation is malformed
+*/
+Stats Stats::fromJson(const Json &j) {
+    Stats s;
+    s.tasks = j.at("tasks").get<unsigned long>();
+    s.completed = j.at("completed").get<unsigned long>();
+    for (auto &tag : j.at("tags").items()) {
+        s.tagCounts[tag.key()] = tag.value().get<unsigned long>();
+    }
+    for (const Json &due : j.at("due")) {
+        Date date;
+        date.setDate(due.at(0).get<unsigned int>(), due.at(1).get<unsigned int>(),
+                     due.at(2).get<unsigned int>());
+        s.openDue[date] = due.at(3).get<unsigned long>();
+    }
+    return s;
+}
+
+// Overloaded == function to check if two sets of counters are equal.
+bool operator==(const Stats &s1, const Stats &s2) {
+    return s1.tasks == s2.tasks && s1.completed == s2.completed &&
+           s1.tagCounts == s2.tagCounts && s1.openDue == s2.openDue;
+}
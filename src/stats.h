@@ -0,0 +1,61 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the Stats class.
+ * Stats holds counters over a collection of tasks (number of tasks, how many
+ * are completed, how many are overdue and which tags are in use). Project and
+ * TodoList keep a Stats object up to date as their tasks change, so reading
+ * the counters never requires a scan over the tasks themselves.
+*/
+
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <map>
+
+#include "task.h"
+
+class Stats {
+  unsigned long tasks;
+  unsigned long completed;
+
+  // Number of tasks carrying each tag
+  std::map<String, unsigned long> tagCounts;
+
+  // Number of incomplete tasks due on each date, used to count the overdue
+  // tasks relative to any given day.
+  std::map<Date, unsigned long> openDue;
+
+  void addOpenDue(const Date &date);
+  void removeOpenDue(const Date &date);
+
+public:
+  Stats();
+  ~Stats() = default;
+
+  void addTask(const Task &task);
+  void removeTask(const Task &task);
+  void setComplete(const Task &task, bool completed);
+  void setDueDate(const Task &task, const Date &date);
+  void addTag(const String &tag);
+  void removeTag(const String &tag);
+
+  void merge(const Stats &other);
+  void subtract(const Stats &other);
+
+  unsigned long numTasks() const noexcept;
+  unsigned long numCompleted() const noexcept;
+  unsigned long numOverdue(const Date &today) const;
+  unsigned long numTags() const noexcept;
+  const std::map<String, unsigned long> &getTagCounts() const noexcept;
+
+  Json summary(const Date &today) const;
+  Json json() const;
+  void write(JsonWriter &writer) const;
+  static Stats fromJson(const Json &j);
+
+  friend bool operator==(const Stats &s1, const Stats &s2);
+};
+
+#endif // STATS_H
@@ -6,7 +6,9 @@
 
 
 #include "task.h"
-#include <sstream>
+#include "jsonwriter.h"
+#include "project.h"
+#include <algorithm>
 
 
 // Constructor to create a Task object with an identifier
@@ -21,6 +23,9 @@ const String Task::getIdent() const noexcept{
 
 // Function to set the identifier of the Task object
 void Task::setIndent(String& identifier) {
+    if (project) {
+        project->onRename(*this, identifier);
+    }
     this->identifier = identifier;
 }
 
@@ -30,12 +35,15 @@ bool Task::addTag(const String tag) {
         return false; // tag already exists
     } else {
         tags.push_back(tag);
+        if (project) {
+            project->onTagAdded(*this, tag);
+        }
         return true; // tag inserted into the container
     }
 }
 
 // Function to return the tags of the Task object
-const TagContainer Task::getTags() const noexcept {
+const TagContainer &Task::getTags() const noexcept {
     return tags;
 }
 
@@ -44,6 +52,9 @@ bool Task::deleteTag(const String tag) {
     auto it = std::find(tags.begin(), tags.end(), tag);
     if (it != tags.end()) {
         tags.erase(it);
+        if (project) {
+            project->onTagRemoved(*this, tag);
+        }
         return true;
     } else {
         throw std::out_of_range("Tag is empty.");
@@ -69,17 +80,34 @@ bool Task::containsTag(const String tag) const {
 
 // Function to return the tags as a string
 String Task::tagsString() const {
-    std::stringstream sttr;
-    sttr << "[";
+    String s;
+    s.reserve(tagsStringLength());
+    appendTagsString(s);
+    return s;
+}
+
+// Function to return the length of tagsString(), without building it
+std::size_t Task::tagsStringLength() const noexcept {
+    std::size_t length = 2;
+    for (const String &tag : tags) {
+        length += JsonWriter::escapedLength(tag) + 3;
+    }
+    return tags.empty() ? length : length - 1;
+}
+
+// Function to append tagsString() to a string
+void Task::appendTagsString(String &s) const {
+    s += '[';
     for (auto it = tags.begin(); it != tags.end(); it++) {
-        sttr << "\"" << *it << "\"";
-        if ((it + 1) != tags.end()) {
-            sttr << ",";
+        if (it != tags.begin()) {
+            s += ',';
         }
+        s += '"';
+        JsonWriter::appendEscaped(s, *it);
+        s += '"';
     }
-    sttr << "]";
-    return sttr.str();
-}   
+    s += ']';
+}
 
 // Function to return the due date of the Task object
 Date Task::getDueDate() const noexcept {
@@ -88,11 +116,17 @@ Date Task::getDueDate() const noexcept {
 
 
 void Task::setDueDate(Date date) {
+    if (project) {
+        project->onDueDate(*this, date);
+    }
     dueDate = date;
 }
 
 
 void Task::setComplete(bool aBool) {
+    if (project) {
+        project->onComplete(*this, aBool);
+    }
     completed = aBool;
 }
 
@@ -114,22 +148,74 @@ bool operator==(const Task& task1, const Task& task2) {
 }
 
 
+// The parts of str() around the values of the Task object
+static const char STR_COMPLETED[] = "\":{\"completed\":";
+static const char STR_DUE_DATE[] = ",\"dueDate\":\"";
+static const char STR_TAGS[] = "\",\"tags\":";
+
+/*
+    * Function to return the string representation of the Task object. The
+    * length is worked out first, so the string is allocated once. The
+    * identifier and tags are escaped as JSON strings.
+    * @return String: The string representation of the Task object
+*/
 String Task::str() const {
-    std::stringstream sttr;
-    sttr << "\"" << identifier << "\""
-        << ":{\"completed\":" << completeStr()
-        << ",\"dueDate\":\"" << dueDate.str()
-        << "\",\"tags\":" << tagsString() 
-        << "}";
-    return sttr.str();
+    String s;
+    s.reserve(strLength());
+    appendStr(s);
+    return s;
+}
+
+// Function to return the length of str(), without building it
+std::size_t Task::strLength() const noexcept {
+    return 1 + JsonWriter::escapedLength(identifier) + sizeof(STR_COMPLETED) - 1 + (completed ? 4 : 5) +
+           sizeof(STR_DUE_DATE) - 1 + dueDate.strLength() + sizeof(STR_TAGS) - 1 +
+           tagsStringLength() + 1;
+}
+
+// Function to append str() to a string
+void Task::appendStr(String &s) const {
+    s += '"';
+    JsonWriter::appendEscaped(s, identifier);
+    s.append(STR_COMPLETED, sizeof(STR_COMPLETED) - 1);
+    s += completed ? "true" : "false";
+    s.append(STR_DUE_DATE, sizeof(STR_DUE_DATE) - 1);
+    dueDate.appendStr(s);
+    s.append(STR_TAGS, sizeof(STR_TAGS) - 1);
+    appendTagsString(s);
+    s += '}';
 }
 
 Json Task::json() const {
+    return json(dueDate.str());
+}
+
+// Function to return the JSON representation of the Task object with its
+// due date already written, as a Project writes all its tasks' at once
+Json Task::json(const String& dueDateText) const {
     Json j;
     j["completed"] = completed;
-    j["dueDate"] = dueDate.str();
+    j["dueDate"] = dueDateText;
     for (auto it = tags.begin(); it != tags.end(); it++) {
         j["tags"].push_back(*it);
     }
     return j;
 }
+
+// Write the JSON representation of the Task object, the same as json()
+void Task::write(JsonWriter &writer) const {
+    writer.beginObject();
+    writer.key("completed");
+    writer.value(completed);
+    writer.key("dueDate");
+    writer.value(dueDate.str());
+    if (!tags.empty()) {
+        writer.key("tags");
+        writer.beginArray();
+        for (const String &tag : tags) {
+            writer.value(tag);
+        }
+        writer.endArray();
+    }
+    writer.endObject();
+}
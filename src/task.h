@@ -14,6 +14,10 @@
 #define TASK_H
 
 #include "date.h"
+#include "owner.h"
+
+class JsonWriter;
+class Project;
 
 using TagContainer = std::vector<String>;
 using Json = nlohmann::json;
@@ -26,20 +30,34 @@ class Task {
     Date dueDate;
     bool completed;
 
+    // The Project this Task is stored in, notified of every change so that
+    // it can keep its counters and indexes up to date. Unset for a
+    // free-standing Task.
+    Owner<Project> project;
+    friend class Project;
+
+    Json json(const String& dueDateText) const;
+
     public:
     explicit Task(const String& identifier);
+    Task(const Task& other) = default;
+    Task(Task&& other) noexcept = default;
+    Task& operator=(const Task& other) = default;
+    Task& operator=(Task&& other) noexcept = default;
     ~Task() = default;
 
     const String getIdent() const noexcept;
     void setIndent(String& identifier);
     bool addTag(const String tag);
-    const TagContainer getTags() const noexcept;
+    const TagContainer &getTags() const noexcept;
     bool findTag(const String tag);
     bool deleteTag(String tag);
     void mergeTags(const TagContainer& tags);
     const unsigned int numTags() const noexcept;
     bool containsTag(String tag) const;
     String tagsString() const;
+    std::size_t tagsStringLength() const noexcept;
+    void appendTagsString(String &s) const;
 
     Date getDueDate() const noexcept;
     void setDueDate(Date date);
@@ -50,7 +68,10 @@ class Task {
 
     friend bool operator==(const Task& task1, const Task& task2);
     String str() const;
+    std::size_t strLength() const noexcept;
+    void appendStr(String &s) const;
     Json json() const;
+    void write(JsonWriter &writer) const;
 
 };
 
@@ -0,0 +1,285 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the ThreadPool class.
+*/
+
+
+#include "threadpool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+
+// The pool and worker the calling thread is working for, if any
+static thread_local const ThreadPool *currentPool = nullptr;
+static thread_local unsigned int currentIndex = 0;
+
+// How many tasks the calling thread is inside of, so that time spent in a
+// task run while another waits is not counted twice
+static thread_local unsigned int depth = 0;
+
+using Clock = std::chrono::steady_clock;
+
+// How many times parallelFor looks for work before it sleeps
+static const unsigned int SPINS = 64;
+
+// Returns the nanoseconds since a point in time
+static unsigned long long nanosecondsSince(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+
+/*
+    * Constructor to create a ThreadPool and start its workers
+    * @param size: The number of workers including the calling thread, 0 for
+    * one per core
+*/
+ThreadPool::ThreadPool(unsigned int size) : queued(0), stopping(false) {
+    if (size == 0) {
+        size = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned int i = 0; i < size; i++) {
+        workers.emplace_back(new Worker());
+    }
+    for (unsigned int i = 1; i < size; i++) {
+        threads.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+// Destructor, waits for the workers to finish the queued tasks and stop
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        stopping = true;
+    }
+    idle.notify_all();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+// Function to return the ThreadPool shared by the whole program, with one
+// worker per core
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// Function to return the number of workers, including the calling thread
+unsigned int ThreadPool::size() const noexcept {
+    return workers.size();
+}
+
+// Function to return the index of the worker running the calling thread,
+// between 0 and size() - 1; 0 outside of the pool's tasks
+unsigned int ThreadPool::currentWorker() const noexcept {
+    return self();
+}
+
+unsigned int ThreadPool::self() const noexcept {
+    return currentPool == this ? currentIndex : 0;
+}
+
+// Queue a task on a worker and wake up a worker to run it
+void ThreadPool::push(unsigned int worker, std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(workers[worker]->mutex);
+        workers[worker]->tasks.push_back(std::move(task));
+    }
+    queued++;
+    {
+        // Taking the lock orders the count with a worker about to wait
+        std::lock_guard<std::mutex> lock(idleMutex);
+    }
+    idle.notify_one();
+}
+
+// Take the newest task queued on a worker
+bool ThreadPool::pop(unsigned int worker, std::function<void()> &task) {
+    std::lock_guard<std::mutex> lock(workers[worker]->mutex);
+    if (workers[worker]->tasks.empty()) {
+        return false;
+    }
+    task = std::move(workers[worker]->tasks.back());
+    workers[worker]->tasks.pop_back();
+    queued--;
+    return true;
+}
+
+// Take the oldest task queued on another worker, starting at a random one
+bool ThreadPool::steal(unsigned int worker, std::function<void()> &task) {
+    static thread_local std::minstd_rand random(std::random_device{}());
+    const unsigned int n = workers.size();
+    const unsigned int start = random() % n;
+    for (unsigned int i = 0; i < n; i++) {
+        const unsigned int victim = (start + i) % n;
+        if (victim == worker) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(workers[victim]->mutex);
+        if (!workers[victim]->tasks.empty()) {
+            task = std::move(workers[victim]->tasks.front());
+            workers[victim]->tasks.pop_front();
+            queued--;
+            workers[worker]->steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Run one queued task, returning false if there was none
+bool ThreadPool::runOne(unsigned int worker) {
+    std::function<void()> task;
+    if (!pop(worker, task) && !steal(worker, task)) {
+        return false;
+    }
+    const bool outermost = depth++ == 0;
+    const Clock::time_point start = Clock::now();
+    task();
+    depth--;
+    if (outermost) {
+        workers[worker]->busy += nanosecondsSince(start);
+    }
+    workers[worker]->executed++;
+    return true;
+}
+
+// The loop run by each worker thread
+void ThreadPool::work(unsigned int worker) {
+    currentPool = this;
+    currentIndex = worker;
+    while (true) {
+        if (runOne(worker)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(idleMutex);
+        idle.wait(lock, [this]() { return stopping || queued > 0; });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
+
+// Run part of a parallelFor, splitting off half of what is left whenever
+// this worker has nothing queued for others to steal
+void ThreadPool::runRange(unsigned int worker, std::size_t begin, std::size_t end,
+                          std::size_t grain, const RangeFunction &fn,
+                          std::atomic<std::size_t> &pending, std::exception_ptr &error,
+                          std::mutex &errorMutex) {
+    try {
+        while (end - begin > grain) {
+            bool empty;
+            {
+                std::lock_guard<std::mutex> lock(workers[worker]->mutex);
+                empty = workers[worker]->tasks.empty();
+            }
+            if (empty) {
+                const std::size_t middle = begin + (end - begin) / 2;
+                pending++;
+                push(worker, [this, middle, end, grain, &fn, &pending, &error, &errorMutex]() {
+                    runRange(self(), middle, end, grain, fn, pending, error, errorMutex);
+                });
+                end = middle;
+            } else {
+                fn(begin, begin + grain);
+                begin += grain;
+            }
+        }
+        fn(begin, end);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+    if (--pending == 0) {
+        // Wake the caller of parallelFor, if it is waiting for the last piece
+        std::lock_guard<std::mutex> lock(idleMutex);
+        idle.notify_all();
+    }
+}
+
+/*
+    * Function to call a function on every piece of a range of indexes, in
+    * parallel, returning once every piece is done
+    * @param begin: The first index
+    * @param end: One past the last index
+    * @param fn: The function, called with the begin and end of each piece
+    * @param grain: The size of the smallest piece worth running on its own
+    * @throws: The first exception thrown by fn, once every piece is done
+*/
+void ThreadPool::parallelFor(std::size_t begin, std::size_t end, const RangeFunction &fn,
+                             std::size_t grain) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max<std::size_t>(grain, 1);
+
+    // A thread from outside the pool works as worker 0 while it waits
+    const ThreadPool *previousPool = currentPool;
+    const unsigned int previousIndex = currentIndex;
+    std::unique_lock<std::mutex> callerLock(callerMutex, std::defer_lock);
+    if (currentPool != this) {
+        callerLock.lock();
+        currentPool = this;
+        currentIndex = 0;
+    }
+    const unsigned int worker = currentIndex;
+
+    std::atomic<std::size_t> pending{1};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    const bool outermost = depth++ == 0;
+    const Clock::time_point start = Clock::now();
+    runRange(worker, begin, end, workers.size() == 1 ? end - begin : grain, fn,
+             pending, error, errorMutex);
+    depth--;
+    if (outermost) {
+        workers[worker]->busy += nanosecondsSince(start);
+    }
+    workers[worker]->executed++;
+
+    // Help with what is left, then wait for the pieces other workers are
+    // running, only spinning a little before sleeping until they are done or
+    // something is queued
+    unsigned int spins = 0;
+    while (pending > 0) {
+        if (runOne(worker)) {
+            spins = 0;
+        } else if (++spins < SPINS) {
+            std::this_thread::yield();
+        } else {
+            std::unique_lock<std::mutex> lock(idleMutex);
+            idle.wait(lock, [this, &pending]() { return pending == 0 || queued > 0; });
+            spins = 0;
+        }
+    }
+
+    currentPool = previousPool;
+    currentIndex = previousIndex;
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Function to return how much work each worker has done
+std::vector<WorkerStats> ThreadPool::stats() const {
+    std::vector<WorkerStats> result;
+    for (const auto &worker : workers) {
+        result.push_back({worker->executed, worker->steals, worker->busy});
+    }
+    return result;
+}
+
+// Function to set every worker's counters back to zero
+void ThreadPool::resetStats() noexcept {
+    for (const auto &worker : workers) {
+        worker->executed = 0;
+        worker->steals = 0;
+        worker->busy = 0;
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the ThreadPool class.
+ * A ThreadPool runs tasks on a fixed set of worker threads. Each worker has
+ * its own queue: it takes its newest task first and, when its queue is
+ * empty, steals the oldest task of a worker chosen at random, so work
+ * spreads out without a shared queue every thread contends on.
+ * parallelFor splits a range of indexes adaptively: a worker only splits
+ * off half of what it has left while its own queue is empty (so idle
+ * workers have something to steal), and otherwise works through it in
+ * grain-sized pieces.
+ * The thread calling parallelFor takes part in the work, as worker 0, and
+ * sleeps once there is none left for it until the other workers are done.
+*/
+
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// How much work one worker of a ThreadPool has done
+struct WorkerStats {
+  unsigned long long tasks;
+  unsigned long long steals;
+  unsigned long long busyNanoseconds;
+};
+
+class ThreadPool {
+public:
+  using RangeFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+    std::atomic<unsigned long long> executed{0};
+    std::atomic<unsigned long long> steals{0};
+    std::atomic<unsigned long long> busy{0};
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::vector<std::thread> threads;
+
+  // Number of queued tasks, and the lock and condition idle workers wait on
+  std::atomic<std::size_t> queued;
+  std::mutex idleMutex;
+  std::condition_variable idle;
+  bool stopping;
+
+  // Serialises callers that are not workers, which share worker 0
+  std::mutex callerMutex;
+
+  unsigned int self() const noexcept;
+  void push(unsigned int worker, std::function<void()> task);
+  bool pop(unsigned int worker, std::function<void()> &task);
+  bool steal(unsigned int worker, std::function<void()> &task);
+  bool runOne(unsigned int worker);
+  void work(unsigned int worker);
+  void runRange(unsigned int worker, std::size_t begin, std::size_t end,
+                std::size_t grain, const RangeFunction &fn,
+                std::atomic<std::size_t> &pending, std::exception_ptr &error,
+                std::mutex &errorMutex);
+
+public:
+  explicit ThreadPool(unsigned int size = 0);
+  ThreadPool(const ThreadPool &other) = delete;
+  ThreadPool &operator=(const ThreadPool &other) = delete;
+  ~ThreadPool();
+
+  static ThreadPool &shared();
+
+  unsigned int size() const noexcept;
+  unsigned int currentWorker() const noexcept;
+
+  void parallelFor(std::size_t begin, std::size_t end, const RangeFunction &fn,
+                   std::size_t grain = 1);
+
+  /*
+   * Call a function on every element of a container (e.g. a ProjectContainer
+   * or TaskContainer), in parallel
+   */
+  template <typename Container, typename Function>
+  void parallelForEach(Container &container, Function fn, std::size_t grain = 1) {
+    parallelFor(0, container.size(), [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        fn(container[i]);
+      }
+    }, grain);
+  }
+
+  std::vector<WorkerStats> stats() const;
+  void resetStats() noexcept;
+};
+
+#endif // THREADPOOL_H
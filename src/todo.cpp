@@ -7,13 +7,92 @@
 
 
 #include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
 #include <exception>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
 
 #include "todo.h"
+#include "aggregation.h"
+#include "exporter.h"
+#include "jsonwriter.h"
+#include "prefixindex.h"
+#include "server.h"
 #include "lib_cxxopts.hpp"
 
+// How many times a change is attempted while other processes save the
+// database first
+static const unsigned int SAVE_ATTEMPTS = 5;
+
+/**
+ * @brief Print what the json action asks for, other than a search: a tag,
+ * task or project, or the whole database.
+ * 
+ * @param db The database to print from, a TodoList or a Snapshot of one.
+ * @param args The cxxopts parse result.
+ * @param out The stream to print the result to.
+ * @param err The stream to print errors to.
+ * @return int The exit code.
+*/
+template <typename Database>
+static int printJson(const Database &db, cxxopts::ParseResult &args,
+                     std::ostream &out, std::ostream &err) {
+  const JsonWriter::Style style = args.count("pretty") ? JsonWriter::PRETTY
+                                                       : JsonWriter::COMPACT;
+
+  if (!args.count("project")) {
+    if (args.count("task") || args.count("tag")) {
+      err << "Error: missing project argument(s)." << std::endl;
+      return 1;
+    }
+    // Printed as it is written, without building the whole output
+    JsonWriter writer(out, style);
+    db.write(writer);
+    writer.flush();
+    out << std::endl;
+    return 0;
+  }
+
+  const Project *project = db.findProject(args["project"].as<String>());
+  if (!project) {
+    err << "Error: invalid project argument(s)." << std::endl;
+    return 1;
+  }
+  if (!args.count("task")) {
+    JsonWriter writer(out, style);
+    project->write(writer);
+    writer.flush();
+    out << std::endl;
+    return 0;
+  }
+
+  const Task *task = project->findTask(args["task"].as<String>());
+  if (!task) {
+    err << "Error: invalid task argument(s)." << std::endl;
+    return 1;
+  }
+  if (!args.count("tag")) {
+    JsonWriter writer(out, style);
+    task->write(writer);
+    writer.flush();
+    out << std::endl;
+    return 0;
+  }
+
+  String tag = args["tag"].as<String>();
+  if (!task->containsTag(tag)) {
+    err << "Error: invalid tag arguments(s)." << std::endl;
+    return 1;
+  }
+  out << tag << std::endl;
+  return 0;
+}
+
 /**
  * @brief Run the todo application.
  * 
@@ -31,18 +110,102 @@ int App::run(int argc, char *argv[]) {
     return 0;
   }
 
-  // Open the database and construct the TodoList
   const String db = args["db"].as<String>();
-  TodoList tlObj{};
 
-  tlObj.load(db);
+  if (args.count("serve")) {
+    try {
+      Server server(db, args.count("follow") ? args["follow"].as<String>() : "");
+      server.stopOnSignals();
+      return server.run();
+    } catch (const std::runtime_error &e) {
+      std::cerr << "Error: " << e.what() << std::endl;
+      return 1;
+    }
+  }
+
+  if (args.count("batch")) {
+    const String fileName = args["batch"].as<String>();
+    const unsigned int saveEvery = args["save-every"].as<unsigned int>();
+    Session session(db);
+    if (fileName == "-") {
+      return batch(session, std::cin, std::cout, std::cerr, saveEvery);
+    }
+    std::ifstream file(fileName);
+    if (!file.is_open()) {
+      std::cerr << "Error: failed to open " << fileName << std::endl;
+      return 1;
+    }
+    return batch(session, file, std::cout, std::cerr, saveEvery);
+  }
+
+  if (args.count("repl")) {
+    Session session(db);
+    return repl(session, std::cin, std::cout, std::cerr);
+  }
+
+  // Hand the command to the daemon serving the database, if there is one
+  int status = 0;
+  if (Server::forward(db, argc, argv, std::cout, std::cerr, status)) {
+    return status;
+  }
 
+  // Otherwise open the database and run the command here
   const Action a = parseActionArgument(args);
+  if (a != Action::CREATE && a != Action::UPDATE && a != Action::DELETE) {
+    Session session(db);
+    return execute(session, args, std::cout, std::cerr);
+  }
+
+  // A change is made to the database as loaded, so if another process saves
+  // it first, start again from the database it saved. The output is held
+  // back until the change has been saved.
+  for (unsigned int attempt = 1;; attempt++) {
+    std::ostringstream out, err;
+    Session session(db);
+    status = execute(session, args, out, err);
+    try {
+      session.save();
+    } catch (const ConflictError &e) {
+      if (attempt < SAVE_ATTEMPTS) {
+        continue;
+      }
+      err << "Error: " << e.what() << std::endl;
+      status = 1;
+    } catch (const std::exception &e) {
+      // e.g. it cannot be written, or a name given is not valid UTF-8
+      err << "Error: " << e.what() << std::endl;
+      status = 1;
+    }
+    std::cout << out.str() << std::flush;
+    std::cerr << err.str() << std::flush;
+    return status;
+  }
+}
+
+/**
+ * @brief Run a command against a database.
+ * 
+ * @param session The database, loaded when the command first needs it.
+ * @param args The cxxopts parse result.
+ * @param out The stream to print the result to.
+ * @param err The stream to print errors to.
+ * @return int The exit code. A command that changes the TodoList marks the
+ * session as modified rather than saving it.
+*/
+int App::execute(Session &session, cxxopts::ParseResult &args,
+                 std::ostream &out, std::ostream &err) {
+  const Action a = parseActionArgument(args);
+
+  if (session.getReplica() && (a == Action::CREATE || a == Action::UPDATE || a == Action::DELETE)) {
+    err << "Error: this is a read-only copy of " << session.getDb() << "." << std::endl;
+    return 1;
+  }
 
   switch (a) {
 
     case Action::CREATE: {
       // FOR CREATE ACTION
+      TodoList &tlObj = session.getTodoList();
       if (args["project"].count()) {
         String projectIdent = args["project"].as<String>();
         if (!tlObj.containsProject(projectIdent)) {
@@ -69,7 +232,7 @@ int App::run(int argc, char *argv[]) {
             try {
               dueDate.setDateFromString(dateAsString);
             } catch (const std::invalid_argument& e) {
-              std::cerr << "Invalid date: " << dateAsString << std::endl;
+              err << "Invalid date: " << dateAsString << std::endl;
               return 1;
             }
             tlObj.getProject(projectIdent).getTask(taskIdent).setDueDate(dueDate);
@@ -82,9 +245,9 @@ int App::run(int argc, char *argv[]) {
             tlObj.getProject(projectIdent).getTask(taskIdent).setComplete(false);
           }
         }    
-        tlObj.save(db);      
+        session.setModified();      
       } else {
-        std::cerr << "Error: missing project, task, tag, due, completed/incomplete argument(s)." << std::endl;
+        err << "Error: missing project, task, tag, due, completed/incomplete argument(s)." << std::endl;
         return 1;
       }
       
@@ -94,43 +257,41 @@ int App::run(int argc, char *argv[]) {
     case Action::JSON: {
       // FOR JSON ACTION
 
-      if (args["project"].count()) {
-        String projectIdent = args["project"].as<String>();
+      const JsonWriter::Style style = args.count("pretty") ? JsonWriter::PRETTY
+                                                           : JsonWriter::COMPACT;
 
-        if (tlObj.containsProject(projectIdent)) {
-          auto& project = tlObj.getProject(projectIdent);
-          if (args["task"].count()) {
-            String taskIdent = args["task"].as<String>();
-            
-            if (project.containsTask(taskIdent)) {
-              auto& task = tlObj.getProject(projectIdent).getTask(taskIdent);
-              if (args["tag"].count()) {
-                String tag = args["tag"].as<String>();
-                if (task.containsTag(tag)) {
-                  std::cout << tag << std::endl;
-                } else {
-                  std::cerr << "Error: invalid tag arguments(s)." << std::endl;
-                  return 1;
-                }
-              } else {
-                std::cout << task.json() << std::endl;
-              }
-            } else {
-              std::cerr << "Error: invalid task argument(s)." << std::endl;
-              return 1;
-            }
-          } else {
-            std::cout << project.json() << std::endl;
-          }
-        } else {
-          std::cerr << "Error: invalid project argument(s)." << std::endl;
+      if (args.count("search")) {
+        if (args.count("task") || args.count("tag")) {
+          err << "Error: the search argument only accepts a project argument." << std::endl;
           return 1;
         }
-      } else if ((args.count("task") || args.count("tag")) && !args.count("project")) {
-        std::cerr << "Error: missing project argument(s)." << std::endl;
-        return 1;
+        String projectIdent = args.count("project") ? args["project"].as<String>() : "";
+        out << searchResults(session.getTodoList(), args["search"].as<String>(), projectIdent)
+                   .dump(style == JsonWriter::PRETTY ? 4 : -1)
+            << std::endl;
       } else {
-        std::cout << tlObj.json() << std::endl;
+        // A whole database not already in memory is printed as it is read,
+        // without loading it, unless it has to be loaded to be printed in
+        // the order loading it gives
+        if (!args.count("project") && !args.count("task") && !args.count("tag") &&
+            !session.isLoaded()) {
+          JsonExporter exporter(out, style);
+          bool printed;
+          try {
+            printed = exporter.exportFileInOrder(session.getDb());
+          } catch (const std::runtime_error &e) {
+            err << "Error: " << e.what() << std::endl;
+            return 1;
+          }
+          if (printed) {
+            exporter.finish();
+            out << std::endl;
+            break;
+          }
+        }
+        if (::printJson(session.getTodoList(), args, out, err) != 0) {
+          return 1;
+        }
       }
       break;
     }
@@ -138,6 +299,8 @@ int App::run(int argc, char *argv[]) {
     case Action::UPDATE: {
       // FOR UPDATE ACTION
 
+      TodoList &tlObj = session.getTodoList();
+
       if (args["project"].count() && args["task"].count()) {
         String projectIdent = args["project"].as<String>();
         
@@ -149,7 +312,7 @@ int App::run(int argc, char *argv[]) {
             tlObj.getProject(oldIdent).setIdent(newIdent);
             projectIdent = newIdent;
           } else {
-            std::cerr << "Project " << oldIdent << " not found." << std::endl;
+            err << "Project " << oldIdent << " not found." << std::endl;
             return 1;
           }
         }
@@ -163,7 +326,7 @@ int App::run(int argc, char *argv[]) {
               taskIdent = newIdent;
               
             } else {
-              std::cerr << "Task " << oldIdent << " not found." << std::endl;
+              err << "Task " << oldIdent << " not found." << std::endl;
               return 1;
             }
           }
@@ -171,7 +334,7 @@ int App::run(int argc, char *argv[]) {
               if (tlObj.containsProject(projectIdent) && tlObj.getProject(projectIdent).containsTask(taskIdent)) {
                 tlObj.getProject(projectIdent).getTask(taskIdent).setComplete(true);
               } else {
-                std::cerr << "Error project or task not found." << std::endl;
+                err << "Error project or task not found." << std::endl;
                 return 1;
               }
           }
@@ -179,7 +342,7 @@ int App::run(int argc, char *argv[]) {
               if (tlObj.containsProject(projectIdent) && tlObj.getProject(projectIdent).containsTask(taskIdent)) {
                 tlObj.getProject(projectIdent).getTask(taskIdent).setComplete(false);
               } else {
-                std::cerr << "Error project or task not found." << std::endl;
+                err << "Error project or task not found." << std::endl;
                 return 1;
               }
           }
@@ -188,7 +351,7 @@ int App::run(int argc, char *argv[]) {
             tlObj.getProject(projectIdent).getTask(taskIdent).getDueDate().setDateFromString(dueDateStr);
           }
         }
-        tlObj.save(db);
+        session.setModified();
       }
       break;
     }
@@ -196,6 +359,8 @@ int App::run(int argc, char *argv[]) {
     case Action::DELETE: {
       // FOR DELETE ACTION
 
+      TodoList &tlObj = session.getTodoList();
+
       if (args.count("project")) {
         String projectIdent = args["project"].as<String>();
         if (tlObj.containsProject(projectIdent)) {
@@ -205,7 +370,7 @@ int App::run(int argc, char *argv[]) {
               if (args.count("tag")) {
                 String tag = args["tag"].as<String>();
                 if (!tlObj.getProject(projectIdent).getTask(taskIdent).deleteTag(tag)) {
-                  std::cerr << "Tag " << tag << " not found in task " << taskIdent << " in project " 
+                  err << "Tag " << tag << " not found in task " << taskIdent << " in project " 
                     << projectIdent << std::endl;
                   return 1;
                 }
@@ -215,26 +380,420 @@ int App::run(int argc, char *argv[]) {
                 tlObj.getProject(projectIdent).deleteTask(taskIdent);
               }
             } else {
-              std::cerr << "Task " << taskIdent << " not found in Project " << projectIdent << std::endl;    
+              err << "Task " << taskIdent << " not found in Project " << projectIdent << std::endl;    
               return 1;
             }
           } else {
             tlObj.deleteProject(projectIdent);
           }
         } else {
-          std::cerr << "Project " << projectIdent << "not found." << std::endl;
+          err << "Project " << projectIdent << "not found." << std::endl;
           return 1;
         }
-        tlObj.save(db);
+        session.setModified();
       }
       
       break;
     }
+
+    case Action::STATS: {
+      // FOR STATS ACTION
+
+      if (args.count("task") || args.count("tag")) {
+        err << "Error: the stats action only accepts a project argument." << std::endl;
+        return 1;
+      }
+      Json summary = statsSummary(session.getStats(), Date::today());
+      if (args.count("project")) {
+        String projectIdent = args["project"].as<String>();
+        if (!summary["projects"].contains(projectIdent)) {
+          err << "Error: invalid project argument(s)." << std::endl;
+          return 1;
+        }
+        out << summary["projects"][projectIdent] << std::endl;
+      } else {
+        out << summary << std::endl;
+      }
+      break;
+    }
+
+    case Action::AGGREGATE: {
+      // FOR AGGREGATE ACTION
+
+      TodoList &tlObj = session.getTodoList();
+
+      if (!args.count("by")) {
+        err << "Error: missing by argument(s)." << std::endl;
+        return 1;
+      }
+      try {
+        Aggregation aggregation(args["by"].as<String>());
+        out << aggregation.run(tlObj) << std::endl;
+      } catch (const std::invalid_argument &e) {
+        err << "Error: invalid by argument(s)." << std::endl;
+        return 1;
+      }
+      break;
+    }
+
+    case Action::COMPLETE: {
+      // FOR COMPLETE ACTION
+
+      const Completions &completions = session.getCompletions();
+      const unsigned int limit = args["limit"].as<unsigned int>();
+      std::vector<String> matches;
+      if (args.count("tag")) {
+        matches = completions.tagNames(args["tag"].as<String>(), limit);
+      } else if (args.count("task")) {
+        if (!args.count("project")) {
+          err << "Error: missing project argument(s)." << std::endl;
+          return 1;
+        }
+        matches = completions.taskIdents(args["project"].as<String>(),
+                                         args["task"].as<String>(), limit);
+      } else if (args.count("project")) {
+        matches = completions.projectIdents(args["project"].as<String>(), limit);
+      } else {
+        err << "Error: missing project, task or tag argument(s)." << std::endl;
+        return 1;
+      }
+      for (const String &match : matches) {
+        out << match << '\n';
+      }
+      out << std::flush;
+      break;
+    }
+
+    case Action::FEED: {
+      // FOR FEED ACTION
+
+      if (args.count("since")) {
+        ChangeFeed::read(session.getDb(), args["since"].as<unsigned long long>(), out);
+        break;
+      }
+      // The journal is started before the database is read, so every change
+      // after it is kept. Changes a server has not saved yet are not in the
+      // journal, so they are saved first to keep the database and sequence
+      // number in step.
+      ChangeFeed::start(session.getDb());
+      session.save();
+      TodoList &tlObj = session.getTodoList();
+      out << Json({{"seq", tlObj.getSequence()}, {"database", tlObj.json()}}) << std::endl;
+      break;
+    }
+
+    case Action::REPLICATION: {
+      // FOR REPLICATION ACTION
+
+      const Replica *replica = session.getReplica();
+      if (!replica) {
+        err << "Error: not a copy of another database." << std::endl;
+        return 1;
+      }
+      out << replica->status(session.getTodoList()) << std::endl;
+      break;
+    }
+
+    case Action::EXPORT: {
+      // FOR EXPORT ACTION
+
+      const String format = args["format"].as<String>();
+      std::unique_ptr<Exporter> exporter;
+      if (format == "ndjson") {
+        exporter.reset(new NdjsonExporter(out));
+      } else if (format == "arrow") {
+        exporter.reset(new ArrowExporter(out));
+      } else {
+        err << "Error: invalid format argument(s)." << std::endl;
+        return 1;
+      }
+      // A database not already in memory is exported as it is read
+      try {
+        if (session.isLoaded()) {
+          exporter->exportTodoList(session.getTodoList());
+        } else {
+          exporter->exportFile(session.getDb());
+        }
+        exporter->finish();
+      } catch (const std::runtime_error &e) {
+        exporter->finish();
+        err << "Error: " << e.what() << std::endl;
+        return 1;
+      }
+      out << std::flush;
+      break;
+    }
   }
   return 0;
 }
 
 
+/**
+ * @brief Run a command given as a list of arguments against a database held
+ * in memory, reporting any failure on err rather than throwing.
+ * 
+ * @param session The database.
+ * @param options The cxxopts options, from cxxoptsSetup.
+ * @param arguments The arguments of the command, starting with the program
+ * name.
+ * @param out The stream to print the result to.
+ * @param err The stream to print errors to.
+ * @return int The exit code.
+*/
+int App::execute(Session &session, cxxopts::Options &options,
+                 const std::vector<String> &arguments, std::ostream &out,
+                 std::ostream &err) {
+  std::vector<const char *> argv;
+  for (const String &argument : arguments) {
+    argv.push_back(argument.c_str());
+  }
+
+  const unsigned int recorded = session.isLoaded() ? session.getTodoList().getChanges().size() : 0;
+  int status;
+  try {
+    auto args = options.parse(static_cast<int>(argv.size()), argv.data());
+    status = execute(session, args, out, err);
+  } catch (const std::exception &e) {
+    err << "Error: " << e.what() << std::endl;
+    status = 1;
+  }
+
+  // A command run on its own that fails part way through is not saved, but
+  // here the TodoList it changed stays in memory, so undo its changes
+  if (status != 0 && session.isLoaded() && !session.getReplica() &&
+      session.getTodoList().getChanges().size() != recorded) {
+    try {
+      session.restore(recorded);
+    } catch (const std::exception &e) {
+      err << "Error: failed to undo the changes: " << e.what() << std::endl;
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Check if a command only reads what a Snapshot holds, so that it
+ * can be answered from one with printJson rather than run by execute: the
+ * json action, other than a search.
+ * 
+ * @param args The cxxopts parse result.
+ * @return bool True if the command can be answered from a Snapshot.
+*/
+bool App::readsSnapshot(cxxopts::ParseResult &args) {
+  try {
+    return parseActionArgument(args) == Action::JSON && !args.count("search");
+  } catch (const std::exception &) {
+    // Reported when the command is run
+    return false;
+  }
+}
+
+/**
+ * @brief Answer a command for which readsSnapshot is true from a Snapshot,
+ * as execute would from the TodoList it was taken of. Safe to call on any
+ * thread.
+ * 
+ * @param snapshot The Snapshot to read.
+ * @param args The cxxopts parse result.
+ * @param out The stream to print the result to.
+ * @param err The stream to print errors to.
+ * @return int The exit code.
+*/
+int App::printJson(const Snapshot &snapshot, cxxopts::ParseResult &args,
+                   std::ostream &out, std::ostream &err) {
+  return ::printJson(snapshot, args, out, err);
+}
+
+/**
+ * @brief Split a command line into its arguments. Arguments are separated
+ * by whitespace and can be quoted with single or double quotes; outside
+ * single quotes a backslash keeps the next character as it is.
+ * 
+ * @param line The command line.
+ * @return std::vector<String> The arguments.
+ * @throws std::invalid_argument If a quote is not closed.
+*/
+std::vector<String> App::splitCommand(const String &line) {
+  std::vector<String> arguments;
+  String argument;
+  bool inArgument = false;
+  char quote = 0;
+  for (std::size_t i = 0; i < line.size(); i++) {
+    const char c = line[i];
+    if (quote == '\'') {
+      if (c == '\'') {
+        quote = 0;
+      } else {
+        argument += c;
+      }
+    } else if (c == '\\' && i + 1 < line.size()) {
+      argument += line[++i];
+      inArgument = true;
+    } else if (quote == '"') {
+      if (c == '"') {
+        quote = 0;
+      } else {
+        argument += c;
+      }
+    } else if (c == '\'' || c == '"') {
+      quote = c;
+      inArgument = true;
+    } else if (std::isspace(static_cast<unsigned char>(c))) {
+      if (inArgument) {
+        arguments.push_back(argument);
+        argument.clear();
+        inArgument = false;
+      }
+    } else {
+      argument += c;
+      inArgument = true;
+    }
+  }
+  if (quote) {
+    throw std::invalid_argument("unterminated quote");
+  }
+  if (inArgument) {
+    arguments.push_back(argument);
+  }
+  return arguments;
+}
+
+// Run a command line, in the daemon serving the database if there is one
+static int runLine(Session &session, cxxopts::Options &options,
+                   const String &line, std::ostream &out, std::ostream &err) {
+  int status;
+  try {
+    std::vector<String> arguments = App::splitCommand(line);
+    arguments.insert(arguments.begin(), "todo");
+    std::vector<const char *> argv;
+    for (const String &argument : arguments) {
+      argv.push_back(argument.c_str());
+    }
+    if (!Server::forward(session.getDb(), static_cast<int>(argv.size()), argv.data(),
+                         out, err, status)) {
+      status = App::execute(session, options, arguments, out, err);
+    }
+  } catch (const std::invalid_argument &e) {
+    err << "Error: " << e.what() << std::endl;
+    status = 1;
+  }
+  return status;
+}
+
+// Save the changes made to a database, returning false on failure
+static bool saveSession(Session &session, std::ostream &err) {
+  try {
+    session.save();
+  } catch (const std::exception &e) {
+    err << "Error: failed to save " << session.getDb() << ": " << e.what() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Run commands read one per line against a database. Empty lines and
+ * lines starting with '#' are skipped. The output of each command is
+ * followed by a line giving its line number and exit code, e.g.
+ * '# 3 exit 0'. Commands are handed to the daemon serving the database
+ * instead, if there is one.
+ * 
+ * @param session The database, loaded by the first command that needs it.
+ * @param in The stream to read the commands from.
+ * @param out The stream to print the results to.
+ * @param err The stream to print errors to.
+ * @param saveEvery Save the database after every saveEvery commands as well
+ * as at the end, or only at the end if 0.
+ * @return int 0 if every command succeeded and the database was saved,
+ * otherwise 1.
+*/
+int App::batch(Session &session, std::istream &in, std::ostream &out,
+               std::ostream &err, unsigned int saveEvery) {
+  auto options = cxxoptsSetup();
+  int result = 0;
+  unsigned long lineNumber = 0;
+  unsigned long commands = 0;
+  String line;
+
+  while (std::getline(in, line)) {
+    lineNumber++;
+    const std::size_t first = line.find_first_not_of(" \t\r");
+    if (first == String::npos || line[first] == '#') {
+      continue;
+    }
+
+    int status = runLine(session, options, line, out, err);
+    out << "# " << lineNumber << " exit " << status << '\n';
+    if (status != 0) {
+      result = 1;
+    }
+
+    commands++;
+    if (saveEvery && commands % saveEvery == 0 && !saveSession(session, err)) {
+      result = 1;
+    }
+  }
+  if (!saveSession(session, err)) {
+    result = 1;
+  }
+  out << std::flush;
+  return result;
+}
+
+// Format a duration in milliseconds to the microsecond
+static String milliseconds(const std::chrono::steady_clock::duration &elapsed) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.3f ms",
+                std::chrono::duration<double, std::milli>(elapsed).count());
+  return buffer;
+}
+
+/**
+ * @brief Run commands typed one per line against a database until 'exit',
+ * 'quit' or the end of the input. 'commit' saves the changes made so far,
+ * and 'help' prints the arguments a command can have. The output of each
+ * command is followed by a line giving its exit code and how long it took,
+ * e.g. '# exit 0 in 0.215 ms'.
+ * 
+ * @param session The database, kept in memory between commands.
+ * @param in The stream to read the commands from.
+ * @param out The stream to print the prompt and results to.
+ * @param err The stream to print errors to.
+ * @return int 0 if the changes were saved on exit, otherwise 1.
+*/
+int App::repl(Session &session, std::istream &in, std::ostream &out,
+              std::ostream &err) {
+  using Clock = std::chrono::steady_clock;
+  auto options = cxxoptsSetup();
+  String line;
+
+  while (out << "todo> " << std::flush && std::getline(in, line)) {
+    const std::size_t first = line.find_first_not_of(" \t\r");
+    if (first == String::npos || line[first] == '#') {
+      continue;
+    }
+    const std::size_t last = line.find_last_not_of(" \t\r");
+    const String command = line.substr(first, last - first + 1);
+
+    if (command == "exit" || command == "quit") {
+      break;
+    } else if (command == "help") {
+      out << options.help() << std::endl;
+    } else if (command == "commit") {
+      const Clock::time_point start = Clock::now();
+      const bool saved = saveSession(session, err);
+      out << "# " << (saved ? "saved" : "not saved") << " in "
+          << milliseconds(Clock::now() - start) << std::endl;
+    } else {
+      const Clock::time_point start = Clock::now();
+      const int status = runLine(session, options, line, out, err);
+      out << "# exit " << status << " in " << milliseconds(Clock::now() - start) << std::endl;
+    }
+  }
+  out << std::endl;
+  return saveSession(session, err) ? 0 : 1;
+}
+
 /**
  * @brief Setup the cxxopts options.
  * print the usage if the help flag is set.
@@ -248,7 +807,9 @@ cxxopts::Options App::cxxoptsSetup() {
       "db", "Filename of the todo database",
       cxxopts::value<String>()->default_value("database.json"))(
 
-      "action", "Action to take, can be: 'create', 'json', 'update', 'delete'.",
+      "action", "Action to take, can be: 'create', 'json', 'update', 'delete', "
+      "'stats', 'aggregate', 'complete', 'feed', 'replication', "
+      "'export'.",
       cxxopts::value<String>())(
 
       "project",
@@ -292,6 +853,78 @@ cxxopts::Options App::cxxoptsSetup() {
       "Ommitting the argument removes the due date from the task.",
       cxxopts::value<String>())(
 
+      "by",
+      "When aggregating, a comma separated list of the dimensions to group "
+      "tasks by: 'project', 'project:N' (the first N characters of the "
+      "project identifier), 'tag', 'year', 'month' (of the due date) and "
+      "'completed'.",
+      cxxopts::value<String>())(
+
+      "search",
+      "With the json action, print the tasks whose identifier, or whose "
+      "project's identifier, contains the argument (ignoring case). Can be "
+      "combined with the project argument to search a single project.",
+      cxxopts::value<String>())(
+
+      "limit",
+      "With the complete action, the largest number of matches to print.",
+      cxxopts::value<unsigned int>()->default_value("10"))(
+
+      "format",
+      "With the export action, the format to print every task in: "
+      "'ndjson', one JSON object per line with the task's project, "
+      "identifier, completed state, due date and tags, or 'arrow', an "
+      "Arrow IPC file with a column for each.",
+      cxxopts::value<String>()->default_value("ndjson"))(
+
+      "pretty",
+      "With the json action, print the JSON over several lines, indented "
+      "by four spaces, rather than on one line.",
+      cxxopts::value<bool>())(
+
+      "since",
+      "With the feed action, print the changes saved to the database after "
+      "the change with this sequence number, one JSON object per line. "
+      "Without it, the feed action prints the database and the sequence "
+      "number of the last change saved to it, and starts keeping the journal "
+      "the changes are read from, which is not kept until then.",
+      cxxopts::value<unsigned long long>())(
+
+      "batch",
+      "Run the commands in the given file (or standard input if the "
+      "argument is '-'), one per line with the same arguments "
+      "as a single command, e.g. '--action create --project M02'. The "
+      "database is loaded once and saved at the end. Each command's output "
+      "is followed by a line '# N exit S' giving its line number and exit "
+      "code.",
+      cxxopts::value<String>())(
+
+      "save-every",
+      "With the batch argument, also save the database after every N "
+      "commands.",
+      cxxopts::value<unsigned int>()->default_value("0"))(
+
+      "repl",
+      "Read commands from the terminal, one per line with the same "
+      "arguments as a single command, against the database loaded once. "
+      "'commit' saves the changes made so far, 'exit' saves them and quits. "
+      "Each command is followed by its exit code and how long it took.",
+      cxxopts::value<bool>())(
+
+      "serve",
+      "Load the database once and serve commands from memory until "
+      "interrupted. While it runs, todo commands for the same database are "
+      "handed to it, and changes are saved to the database shortly after "
+      "they are made.",
+      cxxopts::value<bool>())(
+
+      "follow",
+      "With the serve argument, serve a read-only copy of the database "
+      "given as the argument instead, kept up to date from the changes "
+      "saved to it. Commands for the db argument are handed to it, and the "
+      "replication action shows how far behind it is.",
+      cxxopts::value<String>())(
+
       "h,help", "Print usage.");
 
   return cxxopts;
@@ -304,7 +937,7 @@ cxxopts::Options App::cxxoptsSetup() {
  * @return App::Action The action.
 */
 App::Action App::parseActionArgument(cxxopts::ParseResult &args) {
-// enum Action { CREATE, JSON, DELETE, UPDATE };
+// enum Action { CREATE, JSON, DELETE, UPDATE, STATS, AGGREGATE, COMPLETE, FEED, REPLICATION, EXPORT };
   String input = args["action"].as<String>();
   // Convert the input to lowercase 
   std::transform(input.begin(), input.end(), input.begin(), ::tolower);
@@ -316,6 +949,18 @@ App::Action App::parseActionArgument(cxxopts::ParseResult &args) {
     return Action::DELETE;
   } else if(input == "update") {
     return Action::UPDATE;
+  } else if(input == "stats") {
+    return Action::STATS;
+  } else if(input == "aggregate") {
+    return Action::AGGREGATE;
+  } else if(input == "complete") {
+    return Action::COMPLETE;
+  } else if(input == "feed") {
+    return Action::FEED;
+  } else if(input == "replication") {
+    return Action::REPLICATION;
+  } else if(input == "export") {
+    return Action::EXPORT;
   }
   throw std::invalid_argument("action");
 }
@@ -361,3 +1006,50 @@ std::vector<String> App::splitTags(const String& stringTags) {
   }
   return tags;
 }
+
+/**
+ * @brief Build the output of the stats action.
+ * 
+ * @param stats The counters of each project.
+ * @param today The date used to decide whether a task is overdue.
+ * @return Json The totals over all projects, followed by the counters of
+ * each project under "projects".
+*/
+Json App::statsSummary(const StatsContainer &stats, const Date &today) {
+  Stats total;
+  Json projects = Json::object();
+  for (const auto &entry : stats) {
+    total.merge(entry.second);
+    projects[entry.first] = entry.second.summary(today);
+  }
+  Json j = total.summary(today);
+  j["projects"] = projects;
+  return j;
+}
+
+/**
+ * @brief Find the tasks whose identifier contains a word.
+ * 
+ * @param tl The TodoList to search.
+ * @param word The word to search for, ignoring case.
+ * @param p Only search the project with this identifier, unless empty.
+ * @return Json The JSON representation of each task found, by project. A
+ * project whose identifier contains the word is included with all of its
+ * tasks.
+*/
+Json App::searchResults(TodoList &tl, const String &word, const String &p) {
+  Json j = Json::object();
+  for (const SearchMatch &match : tl.search(word)) {
+    if (!p.empty() && match.project != p) {
+      continue;
+    }
+    Project &project = tl.getProject(match.project);
+    if (match.isProject) {
+      Json tasks = project.json();
+      j[match.project] = tasks.is_null() ? Json::object() : tasks;
+    } else if (!j.contains(match.project) || !j[match.project].contains(match.task)) {
+      j[match.project][match.task] = project.getTask(match.task).json();
+    }
+  }
+  return j;
+}
@@ -11,6 +11,7 @@
 
 
 #include "lib_cxxopts.hpp"
+#include "session.h"
 #include "todolist.h"
 
 namespace App {
@@ -19,12 +20,28 @@ namespace App {
 const String PROGRAMMER = "Arvin Singh";
 
 // enum for the different actions that can be performed
-enum Action { CREATE, JSON, DELETE, UPDATE };
+enum Action { CREATE, JSON, DELETE, UPDATE, STATS, AGGREGATE, COMPLETE, FEED, REPLICATION, EXPORT };
 
 int run(int argc, char *argv[]);
 
+int execute(Session &session, cxxopts::ParseResult &args, std::ostream &out,
+            std::ostream &err);
+int execute(Session &session, cxxopts::Options &options,
+            const std::vector<String> &arguments, std::ostream &out,
+            std::ostream &err);
+
+bool readsSnapshot(cxxopts::ParseResult &args);
+int printJson(const Snapshot &snapshot, cxxopts::ParseResult &args,
+              std::ostream &out, std::ostream &err);
+
 cxxopts::Options cxxoptsSetup();
 
+std::vector<String> splitCommand(const String &line);
+int batch(Session &session, std::istream &in, std::ostream &out,
+          std::ostream &err, unsigned int saveEvery = 0);
+int repl(Session &session, std::istream &in, std::ostream &out,
+         std::ostream &err);
+
 App::Action parseActionArgument(cxxopts::ParseResult &args);
 
 String getJSON(TodoList &tl);
@@ -35,6 +52,10 @@ String getJSON(TodoList &tl, const String &p, const String &task,
 
 std::vector<String> splitTags(const String& stringTags);
 
+Json statsSummary(const StatsContainer &stats, const Date &today);
+
+Json searchResults(TodoList &tl, const String &word, const String &p = "");
+
 } // namespace App
 
 #endif // _TODO_H
@@ -6,10 +6,125 @@
 
 
 #include "todolist.h"
+#include "filereader.h"
+#include "jsonwriter.h"
+#include "threadpool.h"
+#include "todoparser.h"
+#include "writequeue.h"
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+
+// Open a file to write, empty or to append to, returning -1 on failure
+static int openForWriting(const String &fileName, bool append) {
+#ifdef _WIN32
+    return _open(fileName.c_str(), _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : _O_TRUNC),
+                 _S_IREAD | _S_IWRITE);
+#else
+    return open(fileName.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC),
+                0644);
+#endif
+}
+
+// Build a task from its JSON representation, as saved in a database
+static Task taskFromJson(const String &identifier, const Json &value) {
+    Task t(identifier);
+    if (value.contains("completed")) {
+        t.setComplete(value["completed"]);
+    }
+    if (value.contains("dueDate")) {
+        Date date;
+        date.setDateFromString(value["dueDate"]);
+        t.setDueDate(date);
+    }
+    if (value.contains("tags")) {
+        for (auto &tag : value["tags"]) {
+            t.addTag(tag);
+        }
+    }
+    return t;
+}
 
 
 // Constructor to create a TodoList object
-TodoList::TodoList() {}
+TodoList::TodoList() : generation(FileGeneration()), sequence(0) {}
+
+// Copy constructor
+TodoList::TodoList(const TodoList &other)
+    : projects(other.projects), stats(other.stats), source(other.source),
+      generation(other.generation), changes(other.changes), sequence(other.sequence) {
+    bindProjects();
+}
+
+// Move constructor, the projects now belong to this object
+TodoList::TodoList(TodoList &&other) noexcept
+    : projects(std::move(other.projects)), stats(std::move(other.stats)),
+      index(std::move(other.index)), source(std::move(other.source)),
+      generation(other.generation), changes(std::move(other.changes)),
+      sequence(other.sequence) {
+    bindProjects();
+}
+
+// Copy assignment
+TodoList &TodoList::operator=(const TodoList &other) {
+    if (this != &other) {
+        projects = other.projects;
+        stats = other.stats;
+        index.reset();
+        source = other.source;
+        generation = other.generation;
+        changes = other.changes;
+        sequence = other.sequence;
+        bindProjects();
+    }
+    return *this;
+}
+
+// Move assignment
+TodoList &TodoList::operator=(TodoList &&other) noexcept {
+    if (this != &other) {
+        projects = std::move(other.projects);
+        stats = std::move(other.stats);
+        index = std::move(other.index);
+        source = std::move(other.source);
+        generation = other.generation;
+        changes = std::move(other.changes);
+        sequence = other.sequence;
+        bindProjects();
+    }
+    return *this;
+}
+
+// Point every project back at this TodoList, after they may have been relocated
+void TodoList::bindProjects() noexcept {
+    for (Project &project : projects) {
+        project.list.bind(this);
+    }
+}
+
+// Function to add a project to the end of the container and start counting it
+void TodoList::pushProject(Project project) {
+    auto capacity = projects.capacity();
+    projects.push_back(std::move(project));
+    if (projects.capacity() != capacity) {
+        bindProjects();
+    } else {
+        projects.back().list.bind(this);
+    }
+    stats.merge(projects.back().getStats());
+    if (index) {
+        index->addProject(projects.back());
+    }
+}
 
 
 // Returns number of projects.
@@ -28,7 +143,8 @@ Project &TodoList::newProject(const String &identifier) {
             return project;
         }
     }
-    projects.emplace_back(identifier);
+    pushProject(Project(identifier));
+    changes.projectCreated(projects.back());
     return projects.back();
 }
 
@@ -48,7 +164,8 @@ bool TodoList::addProject(Project project) {
             return false;
         }
     }
-    projects.push_back(project);
+    pushProject(std::move(project));
+    changes.projectCreated(projects.back());
     return true;
 }
 
@@ -80,6 +197,20 @@ bool TodoList::containsProject(const String &identifier) const {
     return false;
 }
 
+/*
+    * Function to find a project in the TodoList object
+    * @param &identifier: The identifier of the project to find
+    * @return const Project*: The project, or null if there is none
+*/
+const Project *TodoList::findProject(const String &identifier) const noexcept {
+    for (const auto &project : projects) {
+        if (project.getIdent() == identifier) {
+            return &project;
+        }
+    }
+    return nullptr;
+}
+
 /*
     * Function to delete a project in the TodoList object
     * @param &identifier: The identifier of the project to delete
@@ -88,6 +219,11 @@ bool TodoList::containsProject(const String &identifier) const {
 bool TodoList::deleteProject(const String &identifier) {
     for (auto it = projects.begin(); it != projects.end(); ++it) {
         if (it->getIdent() == identifier) {
+            stats.subtract(it->getStats());
+            changes.projectDeleted(identifier);
+            if (index) {
+                index->removeProject(*it);
+            }
             projects.erase(it);
             return true;
         }
@@ -99,35 +235,63 @@ bool TodoList::deleteProject(const String &identifier) {
     * Function to load a database from a file
     * database file is in JSON format
     * therefore we parse the file and create the objects
+    * The file is read with a TodoParser, or with nlohmann::json if it is
+    * not laid out as save writes it. A FileReader reads the file on another
+    * thread while the TodoParser parses what has been read so far.
     * @param &fileName: The name of the file to load
 */
 void TodoList::load(const String &fileName) {
-    std::ifstream file(fileName);
-    if (!file.is_open()) {
+    FileLock lock(fileName, FileLock::SHARED);
+    FileReader reader(fileName);
+    if (!reader.isOpen()) {
         throw std::runtime_error("File failed to open.");
     }
-    Json j = Json::parse(file);
+    source = fileName;
+    generation = FileGeneration::of(fileName);
+    sequence = ChangeFeed::lastSequence(fileName);
 
-    for (auto &project : j.items()) {
-        Project p(project.key());
-        for (auto &task : project.value().items()) {
-            Task t(task.key());
-            if (task.value().contains("completed")) {
-                t.setComplete(task.value()["completed"]);
-            }
-            if (task.value().contains("dueDate")) {
-                Date date;
-                date.setDateFromString(task.value()["dueDate"]);
-                t.setDueDate(date);
+    TodoParser parser(reader.size());
+    const char *data;
+    std::size_t length;
+    while (reader.next(data, length)) {
+        parser.feed(data, length);
+    }
+
+    // The identifiers are unique, so each task is pushed without a search
+    std::vector<TodoParser::ParsedProject> parsed;
+    if (parser.finish(parsed)) {
+        for (TodoParser::ParsedProject &p : parsed) {
+            Project project(p.ident);
+            project.tasks.reserve(p.tasks.size());
+            for (const Task &task : p.tasks) {
+                project.pushTask(task);
             }
-            if (task.value().contains("tags")) {
-                for (auto &tag : task.value()["tags"]) {
-                    t.addTag(tag);
-                }
+            pushProject(std::move(project));
+        }
+        return;
+    }
+    Json j = Json::parse(parser.getText());
+
+    // Build the projects in parallel, then add them in the order they were read
+    std::vector<const Json *> values;
+    std::vector<Project> loaded;
+    values.reserve(j.size());
+    loaded.reserve(j.size());
+    for (auto &project : j.items()) {
+        loaded.emplace_back(project.key());
+        values.push_back(&project.value());
+    }
+
+    ThreadPool::shared().parallelFor(0, loaded.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            for (auto &task : values[i]->items()) {
+                loaded[i].addTask(taskFromJson(task.key(), task.value()));
             }
-            p.addTask(t);
         }
-        projects.push_back(p);
+    });
+
+    for (Project &project : loaded) {
+        pushProject(std::move(project));
     }
 }
 
@@ -135,27 +299,316 @@ void TodoList::load(const String &fileName) {
     * Function to save a database to a file
     * database file is in JSON format
     * therefore we serialize the object to JSON
+    * The JSON is written to a temporary file that then replaces the
+    * database, so other processes only ever see a complete database.
     * @param &fileName: The name of the file to save
+    * @throws ConflictError: If the TodoList was loaded from the file and
+    * another process has saved it since
+    * @throws std::runtime_error: If the database or its journal cannot be
+    * written. The changes are kept to append to the journal next time.
+    * @throws Json::type_error: If an identifier or tag is not valid UTF-8
+    * (see JsonWriter), in which case nothing is written
 */
 void TodoList::save(const String &fileName) {
-    std::ofstream file(fileName);
-    if (!file.is_open()) {
+    FileLock lock(fileName, FileLock::EXCLUSIVE);
+    if (fileName == source && FileGeneration::of(fileName) != generation) {
+        throw ConflictError(fileName);
+    }
+
+    // serialize the object to JSON, as write prints it, with the projects
+    // that changed since they were last written written again in parallel
+
+    ThreadPool::shared().parallelFor(0, projects.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            projects[i].compactJson();
+        }
+    });
+
+    std::ostringstream database;
+    {
+        JsonWriter writer(database);
+        write(writer);
+        writer.endLine();
+    }
+
+    sequence = replace(fileName, database.str(), countersJson(), source, changes, generation);
+    source = fileName;
+    changes.clear();
+}
+
+/*
+    * Function to replace a database file with a TodoList serialised as JSON,
+    * then save its counters and append its changes to the journal, with the
+    * database locked by the caller. Shared by save and PendingSave::write.
+    * @param &fileName: The name of the database file
+    * @param &database: The TodoList, as write prints it
+    * @param &counters: The counters of each project, as written by countersJson
+    * @param &source: The database the TodoList was last loaded from or saved to
+    * @param &changes: The changes made to the TodoList since then
+    * @param &generation: Set to the generation of the file saved
+    * @return unsigned long long: The sequence number of the last change in
+    * the journal
+    * @throws std::runtime_error: If the database or its journal cannot be
+    * written
+*/
+unsigned long long TodoList::replace(const String &fileName, const String &database,
+                                     const String &counters, const String &source,
+                                     const ChangeFeed &changes, FileGeneration &generation) {
+    // written and flushed to disk before it replaces the database, so that
+    // a crash leaves either the old or the new database
+    const String temporary = fileName + ".tmp";
+    const int fd = openForWriting(temporary, false);
+    if (fd < 0) {
         throw std::runtime_error("File not found");
     }
-    // serialize the object to JSON
+    WriteQueue &queue = WriteQueue::shared();
+    const WriteQueue::Ticket ticket = queue.write(fd, database, 0, true);
+
+    // While the database is written, the journal entries are made ready.
+    // Only a database something follows keeps a journal (see
+    // ChangeFeed::start). A database saved over another has no changes in
+    // common with it, which is recorded instead.
+    const bool journalled = std::ifstream(ChangeFeed::journalPath(fileName)).is_open();
+    ChangeFeed replaced;
+    const ChangeFeed *feed = nullptr;
+    if (journalled && fileName != source) {
+        replaced.reset();
+        feed = &replaced;
+    } else if (journalled && !changes.empty()) {
+        feed = &changes;
+    }
+    unsigned long long last;
+    const String entries = feed ? feed->entries(fileName, last) : String();
+    if (!feed) {
+        last = ChangeFeed::lastSequence(fileName);
+    }
+
+    try {
+        queue.wait(ticket);
+    } catch (const std::runtime_error &) {
+        close(fd);
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Failed to write " + temporary);
+    }
+    close(fd);
+
+#ifdef _WIN32
+    std::remove(fileName.c_str());
+#endif
+    if (std::rename(temporary.c_str(), fileName.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Failed to replace " + fileName);
+    }
+    generation = FileGeneration::of(fileName);
+    writeStats(fileName, generation, counters);
+
+    // The changes are appended to the journal once the database holding
+    // them has replaced the old one, and only forgotten once they are in it
+    if (feed) {
+        ChangeFeed::appendEntries(fileName, entries);
+    }
+    return last;
+}
+
+/*
+    * Function to begin saving the TodoList to a file as it is now, on another
+    * thread: the PendingSave returned is written by its write, which can be
+    * called on any thread while the TodoList goes on being changed, and its
+    * result taken by finishSave.
+    * @param &fileName: The name of the file to save
+    * @return std::shared_ptr<PendingSave>: The save
+*/
+std::shared_ptr<TodoList::PendingSave> TodoList::beginSave(const String &fileName) const {
+    std::shared_ptr<PendingSave> save = std::make_shared<PendingSave>();
+    save->snapshot = snapshot();
+    save->fileName = fileName;
+    save->source = source;
+    save->generation = generation;
+    save->counters = countersJson();
+    save->changes = changes;
+    save->sequence = sequence;
+    return save;
+}
+
+/*
+    * Function to take the result of a save begun by beginSave, waiting for
+    * it to be written if it has not been yet. The changes it saved are
+    * forgotten, and those made since are kept for the next save.
+    * @param &save: The save
+    * @throws ConflictError: If the TodoList was loaded from the file and
+    * another process has saved it since, in which case what it saved is
+    * loaded by the save (see PendingSave::takeReloaded)
+    * @throws std::runtime_error: If the database or its journal cannot be
+    * written, or another process saved it and it cannot be loaded
+    * @throws Json::type_error: If an identifier or tag is not valid UTF-8
+    * In all of these cases the TodoList is unchanged.
+*/
+void TodoList::finishSave(PendingSave &save) {
+    save.wait();
+    if (save.error) {
+        std::rethrow_exception(save.error);
+    }
+    generation = save.generation;
+    source = save.fileName;
+    sequence = save.sequence;
+    changes.drop(save.changes.size());
+}
+
+TodoList::PendingSave::PendingSave() : sequence(0), done(false) {}
+
+TodoList::PendingSave::~PendingSave() = default;
+
+// Returns the number of changes the save saves
+unsigned int TodoList::PendingSave::size() const noexcept {
+    return changes.size();
+}
+
+/*
+    * Function to write the save, as TodoList::save would have when it was
+    * begun. Any error is kept to be thrown by finishSave. If another process
+    * has saved the database since the TodoList was loaded, what it saved is
+    * loaded instead, so the changes can be made again on top of it.
+*/
+void TodoList::PendingSave::write() noexcept {
+    try {
+        try {
+            FileLock lock(fileName, FileLock::EXCLUSIVE);
+            if (fileName == source && FileGeneration::of(fileName) != generation) {
+                throw ConflictError(fileName);
+            }
 
-    Json projectsJson;
+            const SnapshotContainer &projects = snapshot->getProjects();
+            ThreadPool::shared().parallelFor(0, projects.size(), [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    projects[i]->compactJson();
+                }
+            });
 
-    for (Project& project : projects) {
-        Json projectJson;  
-        for (const Task& task : project.getTasks()) {
-            projectJson[task.getIdent()] = task.json();
+            std::ostringstream database;
+            {
+                JsonWriter writer(database);
+                snapshot->write(writer);
+                writer.endLine();
+            }
+            sequence = replace(fileName, database.str(), counters, source, changes, generation);
+        } catch (const ConflictError &) {
+            std::unique_ptr<TodoList> fresh(new TodoList());
+            fresh->load(fileName);
+            reloaded = std::move(fresh);
+            throw;
         }
-        projectsJson[project.getIdent()] = project.json();
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    written.notify_all();
+}
+
+// Function to wait until the save has been written, or has failed
+void TodoList::PendingSave::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    written.wait(lock, [this] { return done; });
+}
+
+/*
+    * Function to take what another process saved to the database, loaded
+    * by write when finishSave throws a ConflictError
+    * @return std::unique_ptr<TodoList>: The TodoList loaded, or null
+*/
+std::unique_ptr<TodoList> TodoList::PendingSave::takeReloaded() {
+    return std::move(reloaded);
+}
+
+/*
+    * Function to make a change read from the journal of a database, as it
+    * was made to the TodoList that saved it. The change is not recorded
+    * again, and the TodoList takes its sequence number.
+    * @param &change: The change, one line of the journal (see ChangeFeed)
+    * @throws std::runtime_error: If the change is a reset, after which the
+    * database has to be loaded again
+    * @throws std::out_of_range: If the change is to a project or task that
+    * does not exist
+*/
+void TodoList::apply(const Json &change) {
+    const unsigned int recorded = changes.size();
+    try {
+        redo(change);
+    } catch (...) {
+        changes.truncate(recorded);
+        throw;
+    }
+    changes.truncate(recorded);
+    sequence = change.at("seq");
+}
+
+/*
+    * Function to make a change recorded by another TodoList again, such as
+    * one not yet saved when another process saved the database. The change
+    * is recorded as if it was made to this TodoList.
+    * @param &change: The change, as recorded by a ChangeFeed
+    * @throws std::runtime_error: If the change is a reset, or adds a
+    * project or task that already exists
+    * @throws std::out_of_range: If the change is to a project or task that
+    * does not exist
+*/
+void TodoList::replay(const Json &change) {
+    const String op = change.at("op");
+    if ((op == "project.created" && containsProject(change.at("project"))) ||
+        (op == "task.created" && getProject(change.at("project")).containsTask(change.at("task")))) {
+        throw std::runtime_error("The change has already been made: " + op);
+    }
+    const unsigned int recorded = changes.size();
+    try {
+        redo(change);
+    } catch (...) {
+        changes.truncate(recorded);
+        throw;
+    }
+}
+
+// Make a change read from a journal or recorded by a ChangeFeed, recording
+// it like any other
+void TodoList::redo(const Json &change) {
+    const String op = change.at("op");
+    if (op == "reset") {
+        throw std::runtime_error("The database has been replaced");
     }
+    const String project = change.at("project");
 
-    file << projectsJson << std::endl;
-    file.close();
+    if (op == "project.created") {
+        Project p(project);
+        for (auto &task : change.at("value").items()) {
+            p.addTask(taskFromJson(task.key(), task.value()));
+        }
+        addProject(std::move(p));
+    } else if (op == "project.renamed") {
+        getProject(project).setIdent(change.at("to"));
+    } else if (op == "project.deleted") {
+        deleteProject(project);
+    } else if (op == "task.created") {
+        getProject(project).addTask(taskFromJson(change.at("task"), change.at("value")));
+    } else if (op == "task.renamed") {
+        String to = change.at("to");
+        getProject(project).getTask(change.at("task")).setIndent(to);
+    } else if (op == "task.deleted") {
+        getProject(project).deleteTask(change.at("task"));
+    } else if (op == "tag.added") {
+        getProject(project).getTask(change.at("task")).addTag(change.at("tag"));
+    } else if (op == "tag.removed") {
+        getProject(project).getTask(change.at("task")).deleteTag(change.at("tag"));
+    } else if (op == "task.completed") {
+        getProject(project).getTask(change.at("task")).setComplete(change.at("completed"));
+    } else if (op == "task.due") {
+        Date date;
+        date.setDateFromString(change.at("due"));
+        getProject(project).getTask(change.at("task")).setDueDate(date);
+    } else {
+        throw std::runtime_error("Unknown change: " + op);
+    }
 }
 
 /*
@@ -185,17 +638,27 @@ bool operator==(const TodoList &c1, const TodoList &c2) {
 }
 
 /*
-    * Function to return the string representation of the TodoList object
+    * Function to return the string representation of the TodoList object.
+    * The length of the whole string is worked out first, so it is allocated
+    * once and every project and task is appended to it in place.
     * @return String: The string representation of the TodoList object
 */
 String TodoList::str() const {
-    String s = "{";
-
+    std::size_t length = 2;
     for (const Project& project : projects) {
-        s += project.str() + ",";
+        length += project.strLength() + 1;
+    }
+    String s;
+    s.reserve(projects.empty() ? length : length - 1);
+
+    s += '{';
+    for (auto it = projects.begin(); it != projects.end(); it++) {
+        if (it != projects.begin()) {
+            s += ',';
+        }
+        it->appendStr(s);
     }
-    s.pop_back();
-    s += "}";
+    s += '}';
     return s;
 }
 
@@ -204,14 +667,258 @@ String TodoList::str() const {
     * @return Json: The JSON representation of the TodoList object
 */
 Json TodoList::json() const {
-    Json j;
+    Json j = Json::object();
     for (const Project& project : projects) {
-        j[project.getIdent()] = project.str();       
+        j[project.getIdent()] = project.json();
     }
-    return j.dump(4);
+    return j;
+}
+
+/*
+    * Function to write the JSON representation of the TodoList object as it
+    * goes, rather than building it first, with the projects and tasks sorted
+    * by identifier, the same as json().dump() prints it and save saves it
+    * @param writer: The JsonWriter to write to
+*/
+void TodoList::write(JsonWriter &writer) const {
+    writer.beginObject();
+    for (const Project *project : sortedProjects()) {
+        writer.key(project->getIdent());
+        project->write(writer);
+    }
+    writer.endObject();
+}
+
+/*
+    * Function to take a Snapshot of the TodoList object as it is now, which
+    * can be read on any thread while the TodoList goes on changing. Only
+    * the Projects changed since the last Snapshot are copied.
+    * @return std::shared_ptr<const Snapshot>: The Snapshot
+*/
+std::shared_ptr<const Snapshot> TodoList::snapshot() const {
+    SnapshotContainer published;
+    published.reserve(projects.size());
+    for (const Project *project : sortedProjects()) {
+        published.push_back(project->publish());
+    }
+    return std::make_shared<const Snapshot>(std::move(published));
+}
+
+// Returns the projects in the TodoList object, sorted by identifier
+std::vector<const Project*> TodoList::sortedProjects() const {
+    std::vector<const Project*> sorted;
+    sorted.reserve(projects.size());
+    for (const Project &project : projects) {
+        sorted.push_back(&project);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Project *a, const Project *b) {
+        return a->getIdent() < b->getIdent();
+    });
+    return sorted;
 }
 
 // Returns the projects in the TodoList object
 const ProjectContainer& TodoList::getProjects() const {
     return projects;
 }
+
+// Returns the counters over every task in the TodoList object
+const Stats& TodoList::getStats() const noexcept {
+    return stats;
+}
+
+// Returns the changes made since the TodoList was loaded or saved
+const ChangeFeed& TodoList::getChanges() const noexcept {
+    return changes;
+}
+
+// Returns the sequence number of the last change in the journal of the
+// database when the TodoList was loaded or saved
+unsigned long long TodoList::getSequence() const noexcept {
+    return sequence;
+}
+
+// Returns the generation of the database when the TodoList was loaded or
+// saved, or that of a missing file if it has been neither
+const FileGeneration& TodoList::getGeneration() const noexcept {
+    return generation;
+}
+
+// Returns the counters of each project, in the same order as the projects
+StatsContainer TodoList::projectStats() const {
+    StatsContainer result;
+    result.reserve(projects.size());
+    for (const Project& project : projects) {
+        result.emplace_back(project.getIdent(), project.getStats());
+    }
+    return result;
+}
+
+/*
+    * Function to return the signature of a generation of a file, used to
+    * tell whether what is saved next to a database is still current
+    * @param &generation: The generation of the file
+    * @return Json: The signature of the file, or null if it does not exist
+*/
+Json TodoList::fileSignature(const FileGeneration &generation) {
+    if (generation == FileGeneration()) {
+        return nullptr;
+    }
+    Json j;
+    j["device"] = generation.device;
+    j["inode"] = generation.inode;
+    j["size"] = generation.size;
+    j["mtime"] = generation.mtime;
+    j["mtime_ns"] = generation.mtimeNanoseconds;
+    return j;
+}
+
+// Write the signature of a generation of a file, as fileSignature(generation)
+// dumps it
+static void writeSignature(JsonWriter &writer, const FileGeneration &generation) {
+    if (generation == FileGeneration()) {
+        writer.null();
+        return;
+    }
+    writer.beginObject();
+    writer.key("device");
+    writer.number(generation.device);
+    writer.key("inode");
+    writer.number(generation.inode);
+    writer.key("mtime");
+    writer.number(generation.mtime);
+    writer.key("mtime_ns");
+    writer.number(generation.mtimeNanoseconds);
+    writer.key("size");
+    writer.number(generation.size);
+    writer.endObject();
+}
+
+/*
+    * Function to save the counters of each project next to a database file
+    * (as fileName + ".stats"), so they can be read without loading the
+    * database. Nothing is saved unless the TodoList was loaded from or saved
+    * to the file and no other process has saved it since, so that the
+    * counters are never labelled with a database they were not counted from.
+    * @param &fileName: The name of the database file
+*/
+void TodoList::saveStats(const String &fileName) const {
+    FileLock lock(fileName, FileLock::EXCLUSIVE);
+    if (fileName != source || FileGeneration::of(fileName) != generation) {
+        return;
+    }
+    writeStats(fileName, generation, countersJson());
+}
+
+/*
+    * Function to write the counters of each project as JSON, to be saved
+    * next to a database file by writeStats
+    * @return String: The counters, an array of [identifier, counters] pairs
+*/
+String TodoList::countersJson() const {
+    std::ostringstream out;
+    {
+        JsonWriter writer(out);
+        writer.beginArray();
+        for (const Project& project : projects) {
+            writer.beginArray();
+            writer.value(project.getIdent());
+            project.getStats().write(writer);
+            writer.endArray();
+        }
+        writer.endArray();
+    }
+    return out.str();
+}
+
+/*
+    * Function to write the counters of each project next to a database file,
+    * labelled with the generation of the database they were counted from.
+    * They are written to a temporary file that then replaces the old
+    * counters, with the database locked by the caller.
+    * @param &fileName: The name of the database file
+    * @param &generation: The generation of the database file
+    * @param &counters: The counters, as written by countersJson
+*/
+void TodoList::writeStats(const String &fileName, const FileGeneration &generation,
+                          const String &counters) {
+    const String path = fileName + ".stats";
+    const String temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary);
+        if (!file.is_open()) {
+            throw std::runtime_error("File not found");
+        }
+        {
+            JsonWriter writer(file);
+            writer.beginObject();
+            writer.key("database");
+            writeSignature(writer, generation);
+            writer.key("projects");
+            writer.fragment(counters);
+            writer.endObject();
+            writer.endLine();
+        }
+        file.flush();
+        if (!file) {
+            file.close();
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Failed to write " + temporary);
+        }
+    }
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Failed to replace " + path);
+    }
+}
+
+/*
+    * Function to load the counters saved next to a database file
+    * @param &fileName: The name of the database file
+    * @param &stats: Filled with the counters of each project
+    * @return bool: True if the counters were loaded, false if they are
+    * missing, unreadable or were not counted from the database file as it is
+*/
+bool TodoList::loadStats(const String &fileName, StatsContainer &stats) {
+    FileLock lock(fileName, FileLock::SHARED);
+    std::ifstream file(fileName + ".stats");
+    if (!file.is_open()) {
+        return false;
+    }
+    try {
+        Json j = Json::parse(file);
+        Json signature = fileSignature(FileGeneration::of(fileName));
+        if (signature.is_null() || j.at("database") != signature) {
+            return false;
+        }
+        StatsContainer result;
+        for (const Json &project : j.at("projects")) {
+            result.emplace_back(project.at(0).get<String>(),
+                                Stats::fromJson(project.at(1)));
+        }
+        stats = std::move(result);
+        return true;
+    } catch (const Json::exception &e) {
+        return false;
+    }
+}
+
+/*
+    * Function to find the projects and tasks whose identifier contains a word,
+    * ignoring case. The first search builds an index of every identifier,
+    * which is kept up to date by later changes.
+    * @param &word: The word to search for
+    * @return MatchContainer: The projects and tasks found
+*/
+MatchContainer TodoList::search(const String &word) {
+    if (!index) {
+        index.reset(new SearchIndex());
+        for (const Project& project : projects) {
+            index->addProject(project);
+        }
+    }
+    return index->search(word);
+}
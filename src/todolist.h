@@ -10,15 +10,28 @@
 #ifndef TODOLIST_H
 #define TODOLIST_H
 
+#include <condition_variable>
+#include <exception>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include "changefeed.h"
+#include "filelock.h"
 #include "project.h"
+#include "searchindex.h"
+#include "snapshot.h"
 
 using ProjectContainer = std::vector<Project>;
+using StatsContainer = std::vector<std::pair<String, Stats>>;
 
 class TodoList {
 
     public:
     explicit TodoList();
+    TodoList(const TodoList &other);
+    TodoList(TodoList &&other) noexcept;
+    TodoList &operator=(const TodoList &other);
+    TodoList &operator=(TodoList &&other) noexcept;
     ~TodoList() = default;
     
     unsigned int size() const;
@@ -26,15 +39,92 @@ class TodoList {
     bool addProject(Project project);
     Project &getProject(const String &identifier);
     bool containsProject(const String &identifier) const;
+    const Project *findProject(const String &identifier) const noexcept;
     bool deleteProject(const String &identifier);
     void load(const String &fileName);
     void save(const String &fileName);
+    void apply(const Json &change);
+    void replay(const Json &change);
     const ProjectContainer &getProjects() const;
     String str() const;
     Json json() const;
+    void write(JsonWriter &writer) const;
+    std::shared_ptr<const Snapshot> snapshot() const;
+
+    const Stats &getStats() const noexcept;
+    StatsContainer projectStats() const;
+    void saveStats(const String &fileName) const;
+    static bool loadStats(const String &fileName, StatsContainer &stats);
+    static Json fileSignature(const FileGeneration &generation);
+
+    const ChangeFeed &getChanges() const noexcept;
+    unsigned long long getSequence() const noexcept;
+    const FileGeneration &getGeneration() const noexcept;
+
+    MatchContainer search(const String &word);
+
+    // The TodoList as it was when a save was begun by beginSave, written by
+    // write on another thread while the TodoList goes on being changed
+    class PendingSave {
+        friend class TodoList;
+        std::shared_ptr<const Snapshot> snapshot;
+        String fileName;
+        String source;
+        FileGeneration generation;
+        String counters;
+        ChangeFeed changes;
+        unsigned long long sequence;
+
+        // What another process saved, loaded when it saved first
+        std::unique_ptr<TodoList> reloaded;
+
+        std::exception_ptr error;
+        bool done;
+        std::mutex mutex;
+        std::condition_variable written;
+
+        public:
+        PendingSave();
+        PendingSave(const PendingSave &other) = delete;
+        PendingSave &operator=(const PendingSave &other) = delete;
+        ~PendingSave();
+
+        unsigned int size() const noexcept;
+        void write() noexcept;
+        void wait();
+        std::unique_ptr<TodoList> takeReloaded();
+    };
+
+    std::shared_ptr<PendingSave> beginSave(const String &fileName) const;
+    void finishSave(PendingSave &save);
 
     private:
     ProjectContainer projects;
+    Stats stats;
+
+    // Built by the first search and kept up to date from then on
+    std::unique_ptr<SearchIndex> index;
+
+    // The database last loaded or saved, and its generation at the time
+    String source;
+    FileGeneration generation;
+
+    // The changes made since then, and the last change in the journal of
+    // the database at the time
+    ChangeFeed changes;
+    unsigned long long sequence;
+
+    friend class Project;
+    void bindProjects() noexcept;
+    std::vector<const Project*> sortedProjects() const;
+    String countersJson() const;
+    static void writeStats(const String &fileName, const FileGeneration &generation,
+                           const String &counters);
+    static unsigned long long replace(const String &fileName, const String &database,
+                                      const String &counters, const String &source,
+                                      const ChangeFeed &changes, FileGeneration &generation);
+    void redo(const Json &change);
+    void pushProject(Project project);
 };
 
 #endif // TODOLIST_H
@@ -0,0 +1,864 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the TodoParser class.
+*/
+
+
+#include "todoparser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+
+// What a block of 64 bytes of text holds, a bit for each byte
+struct BlockMasks {
+    std::uint64_t quote;
+    std::uint64_t backslash;
+    std::uint64_t structural;
+    std::uint64_t whitespace;
+    std::uint64_t control;
+    std::uint64_t high;
+};
+
+// A function classifying the bytes of a block of 64
+using ClassifyFunction = void (*)(const char *block, BlockMasks &masks);
+
+// Function to classify a block a byte at a time
+static void classifyScalar(const char *block, BlockMasks &masks) {
+    masks = BlockMasks();
+    for (unsigned int i = 0; i < 64; i++) {
+        const unsigned char c = static_cast<unsigned char>(block[i]);
+        const std::uint64_t bit = std::uint64_t(1) << i;
+        switch (c) {
+            case '"':
+                masks.quote |= bit;
+                break;
+            case '\\':
+                masks.backslash |= bit;
+                break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                masks.structural |= bit;
+                break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                masks.whitespace |= bit;
+                break;
+            default:
+                break;
+        }
+        if (c < 0x20) {
+            masks.control |= bit;
+        }
+        if (c >= 0x80) {
+            masks.high |= bit;
+        }
+    }
+}
+
+#ifdef SIMD_X86
+// Returns a bit for each of 16 bytes, set if its top bit is
+__attribute__((target("sse2"))) static inline std::uint64_t bits16(__m128i bytes) {
+    return static_cast<std::uint16_t>(_mm_movemask_epi8(bytes));
+}
+
+// Returns 0xff for each of 16 bytes equal to c
+__attribute__((target("sse2"))) static inline __m128i equal16(__m128i bytes, char c) {
+    return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(c));
+}
+
+// Function to classify a block 16 bytes at a time
+__attribute__((target("sse2"))) static void classifySse2(const char *block, BlockMasks &masks) {
+    masks = BlockMasks();
+    const __m128i control = _mm_set1_epi8(0x1f);
+    for (unsigned int i = 0; i < 4; i++) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+        const __m128i structural = _mm_or_si128(
+            _mm_or_si128(_mm_or_si128(equal16(bytes, '{'), equal16(bytes, '}')),
+                         _mm_or_si128(equal16(bytes, '['), equal16(bytes, ']'))),
+            _mm_or_si128(equal16(bytes, ':'), equal16(bytes, ',')));
+        const __m128i whitespace =
+            _mm_or_si128(_mm_or_si128(equal16(bytes, ' '), equal16(bytes, '\t')),
+                         _mm_or_si128(equal16(bytes, '\n'), equal16(bytes, '\r')));
+        const unsigned int shift = 16 * i;
+        masks.quote |= bits16(equal16(bytes, '"')) << shift;
+        masks.backslash |= bits16(equal16(bytes, '\\')) << shift;
+        masks.structural |= bits16(structural) << shift;
+        masks.whitespace |= bits16(whitespace) << shift;
+        masks.control |= bits16(_mm_cmpeq_epi8(_mm_min_epu8(bytes, control), bytes)) << shift;
+        masks.high |= bits16(bytes) << shift;
+    }
+}
+
+// Returns a bit for each of 32 bytes, set if its top bit is
+__attribute__((target("avx2"))) static inline std::uint64_t bits32(__m256i bytes) {
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(bytes));
+}
+
+// Returns 0xff for each of 32 bytes equal to c
+__attribute__((target("avx2"))) static inline __m256i equal32(__m256i bytes, char c) {
+    return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(c));
+}
+
+// Function to classify a block 32 bytes at a time
+__attribute__((target("avx2"))) static void classifyAvx2(const char *block, BlockMasks &masks) {
+    masks = BlockMasks();
+    const __m256i control = _mm256_set1_epi8(0x1f);
+    for (unsigned int i = 0; i < 2; i++) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32 * i));
+        const __m256i structural = _mm256_or_si256(
+            _mm256_or_si256(_mm256_or_si256(equal32(bytes, '{'), equal32(bytes, '}')),
+                            _mm256_or_si256(equal32(bytes, '['), equal32(bytes, ']'))),
+            _mm256_or_si256(equal32(bytes, ':'), equal32(bytes, ',')));
+        const __m256i whitespace =
+            _mm256_or_si256(_mm256_or_si256(equal32(bytes, ' '), equal32(bytes, '\t')),
+                            _mm256_or_si256(equal32(bytes, '\n'), equal32(bytes, '\r')));
+        const unsigned int shift = 32 * i;
+        masks.quote |= bits32(equal32(bytes, '"')) << shift;
+        masks.backslash |= bits32(equal32(bytes, '\\')) << shift;
+        masks.structural |= bits32(structural) << shift;
+        masks.whitespace |= bits32(whitespace) << shift;
+        masks.control |= bits32(_mm256_cmpeq_epi8(_mm256_min_epu8(bytes, control), bytes)) << shift;
+        masks.high |= bits32(bytes) << shift;
+    }
+}
+#endif
+
+// Returns the indexer in use, the fastest the CPU supports unless set
+static std::atomic<Simd::Level> &indexerInUse() noexcept {
+    static std::atomic<Simd::Level> level(Simd::best());
+    return level;
+}
+
+// Returns the function classifying blocks with the indexer in use
+static ClassifyFunction classifyFunction() noexcept {
+#ifdef SIMD_X86
+    switch (indexerInUse().load(std::memory_order_relaxed)) {
+        case Simd::AVX2:
+            return classifyAvx2;
+        case Simd::SSE2:
+            return classifySse2;
+        default:
+            break;
+    }
+#endif
+    return classifyScalar;
+}
+
+// Returns the position of the lowest bit set
+static inline unsigned int lowestBit(std::uint64_t bits) {
+#ifdef __GNUC__
+    return __builtin_ctzll(bits);
+#else
+    unsigned int i = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+// Returns each bit XORed with every bit below it, so that the bits from an
+// opening quote up to its closing quote (but not including it) are set
+static inline std::uint64_t prefixXor(std::uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+/*
+    * Function to find the bytes of a block escaped by a backslash, without
+    * looking at the backslashes one at a time (as simdjson does). Subtracting
+    * the backslashes that can start an escape from the bits after them, with
+    * the odd bits set, carries through each run of backslashes, leaving the
+    * byte after a run set when the run is odd.
+    * @param backslash: The backslashes of the block
+    * @param nextIsEscaped: Whether the first byte of the block is escaped,
+    * updated for the block after
+    * @return The escaped bytes
+*/
+static inline std::uint64_t escapedBytes(std::uint64_t backslash, std::uint64_t &nextIsEscaped) {
+    const std::uint64_t ODD_BITS = 0xaaaaaaaaaaaaaaaaULL;
+    const std::uint64_t potentialEscape = backslash & ~nextIsEscaped;
+    const std::uint64_t escapeAndTerminal =
+        (((potentialEscape << 1) | ODD_BITS) - potentialEscape) ^ ODD_BITS;
+    const std::uint64_t escaped = escapeAndTerminal ^ (backslash | nextIsEscaped);
+    nextIsEscaped = (escapeAndTerminal & backslash) >> 63;
+    return escaped;
+}
+
+// The most a text can hold, for its positions to fit in an index
+static const std::size_t MAX_SIZE = 0xffffffffULL;
+
+// The first stage: indexes a text 64 bytes at a time, carrying what it
+// knows about the bytes before from one block to the next, so that a text
+// can be indexed as it arrives
+struct Indexer {
+    ClassifyFunction classify;
+    std::uint64_t nextIsEscaped;
+    std::uint64_t inStringCarry;
+    std::uint64_t otherCarry;
+    std::uint64_t controlInString;
+    std::uint64_t highBytes;
+    // How many bytes have been indexed, whole blocks until the last
+    std::size_t indexed;
+
+    explicit Indexer(ClassifyFunction classify)
+        : classify(classify), nextIsEscaped(0), inStringCarry(0), otherCarry(0),
+          controlInString(0), highBytes(0), indexed(0) {}
+
+    // Function to index the block of 64 bytes at an offset of the text
+    void block(const char *block, std::size_t offset, std::vector<std::uint32_t> &indexes) {
+        BlockMasks masks;
+        classify(block, masks);
+
+        const std::uint64_t quote = masks.quote & ~escapedBytes(masks.backslash, nextIsEscaped);
+        const std::uint64_t inString = prefixXor(quote) ^ inStringCarry;
+        inStringCarry = 0 - (inString >> 63);
+        controlInString |= masks.control & inString;
+        highBytes |= masks.high;
+
+        // Anything else outside a string, where only the start of each run
+        // is indexed
+        const std::uint64_t other = ~(masks.structural | masks.whitespace | quote | inString);
+        std::uint64_t tokens = (masks.structural & ~inString) | quote |
+                               (other & ~((other << 1) | otherCarry));
+        otherCarry = other >> 63;
+
+        for (; tokens != 0; tokens &= tokens - 1) {
+            indexes.push_back(static_cast<std::uint32_t>(offset + lowestBit(tokens)));
+        }
+    }
+
+    // Function to index every whole block of the text not indexed yet
+    void blocks(const String &text, std::vector<std::uint32_t> &indexes) {
+        for (; text.size() - indexed >= 64; indexed += 64) {
+            block(text.data() + indexed, indexed, indexes);
+        }
+    }
+
+    // Function to index the rest of the text, the last block padded with
+    // whitespace, returning false if a string is not closed or has a
+    // control character in
+    bool finish(const String &text, std::vector<std::uint32_t> &indexes) {
+        blocks(text, indexes);
+        if (indexed < text.size()) {
+            char last[64];
+            std::memset(last, ' ', sizeof(last));
+            std::memcpy(last, text.data() + indexed, text.size() - indexed);
+            block(last, indexed, indexes);
+            indexed = text.size();
+        }
+        return controlInString == 0 && inStringCarry == 0;
+    }
+};
+
+// Returns whether bytes are valid UTF-8, as nlohmann::json requires of strings
+static bool validUtf8(const char *s, std::size_t length) {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+    const unsigned char *const end = p + length;
+    while (p < end) {
+        const unsigned char c = *p;
+        if (c < 0x80) {
+            p++;
+            continue;
+        }
+        std::size_t size;
+        unsigned char low = 0x80;
+        unsigned char high = 0xbf;
+        if (c >= 0xc2 && c <= 0xdf) {
+            size = 2;
+        } else if (c >= 0xe0 && c <= 0xef) {
+            size = 3;
+            // no overlong encodings or surrogates
+            low = c == 0xe0 ? 0xa0 : 0x80;
+            high = c == 0xed ? 0x9f : 0xbf;
+        } else if (c >= 0xf0 && c <= 0xf4) {
+            size = 4;
+            low = c == 0xf0 ? 0x90 : 0x80;
+            high = c == 0xf4 ? 0x8f : 0xbf;
+        } else {
+            return false;
+        }
+        if (static_cast<std::size_t>(end - p) < size || p[1] < low || p[1] > high) {
+            return false;
+        }
+        for (std::size_t i = 2; i < size; i++) {
+            if (p[i] < 0x80 || p[i] > 0xbf) {
+                return false;
+            }
+        }
+        p += size;
+    }
+    return true;
+}
+
+// Function to read four hex digits, returning false if they are not
+static bool hex4(const char *s, unsigned int &value) {
+    value = 0;
+    for (unsigned int i = 0; i < 4; i++) {
+        const char c = s[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9') {
+            value |= c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            value |= c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            value |= c - 'A' + 10;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function to append a code point as UTF-8
+static void appendUtf8(String &s, unsigned int codePoint) {
+    if (codePoint < 0x80) {
+        s += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        s += static_cast<char>(0xc0 | (codePoint >> 6));
+        s += static_cast<char>(0x80 | (codePoint & 0x3f));
+    } else if (codePoint < 0x10000) {
+        s += static_cast<char>(0xe0 | (codePoint >> 12));
+        s += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+        s += static_cast<char>(0x80 | (codePoint & 0x3f));
+    } else {
+        s += static_cast<char>(0xf0 | (codePoint >> 18));
+        s += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+        s += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+        s += static_cast<char>(0x80 | (codePoint & 0x3f));
+    }
+}
+
+/*
+    * Function to decode the escapes of a string
+    * @param raw: The string as it is in the text, between its quotes
+    * @param length: Its length
+    * @param s: Set to the string decoded
+    * @return bool: False if an escape is not valid
+*/
+static bool unescape(const char *raw, std::size_t length, String &s) {
+    s.clear();
+    const char *const end = raw + length;
+    while (raw < end) {
+        const char *const backslash = static_cast<const char *>(std::memchr(raw, '\\', end - raw));
+        if (backslash == nullptr) {
+            s.append(raw, end - raw);
+            break;
+        }
+        s.append(raw, backslash - raw);
+        if (end - backslash < 2) {
+            return false;
+        }
+        raw = backslash + 2;
+        switch (backslash[1]) {
+            case '"':
+            case '\\':
+            case '/':
+                s += backslash[1];
+                break;
+            case 'b':
+                s += '\b';
+                break;
+            case 'f':
+                s += '\f';
+                break;
+            case 'n':
+                s += '\n';
+                break;
+            case 'r':
+                s += '\r';
+                break;
+            case 't':
+                s += '\t';
+                break;
+            case 'u': {
+                unsigned int codePoint;
+                if (end - raw < 4 || !hex4(raw, codePoint)) {
+                    return false;
+                }
+                raw += 4;
+                if (codePoint >= 0xdc00 && codePoint <= 0xdfff) {
+                    return false;
+                }
+                // a high surrogate has to be followed by a low one
+                if (codePoint >= 0xd800 && codePoint <= 0xdbff) {
+                    unsigned int low;
+                    if (end - raw < 6 || raw[0] != '\\' || raw[1] != 'u' || !hex4(raw + 2, low) ||
+                        low < 0xdc00 || low > 0xdfff) {
+                        return false;
+                    }
+                    raw += 6;
+                    codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+                }
+                appendUtf8(s, codePoint);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+// Walks the index of a database: the second stage
+class IndexWalker {
+    const String &text;
+    const std::vector<std::uint32_t> &indexes;
+    bool checkUtf8;
+    std::size_t next;
+
+    // Returns whether a byte ends a literal
+    bool endsLiteral(std::size_t position) const {
+        if (position >= text.size()) {
+            return true;
+        }
+        switch (text[position]) {
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+            case '"':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+public:
+    IndexWalker(const String &text, const std::vector<std::uint32_t> &indexes, bool checkUtf8)
+        : text(text), indexes(indexes), checkUtf8(checkUtf8), next(0) {}
+
+    // Returns the character at the next index, or NUL after the last
+    char peek() const {
+        return next < indexes.size() ? text[indexes[next]] : '\0';
+    }
+
+    // Function to move past a character, returning false if it is not next
+    bool consume(char c) {
+        if (peek() != c) {
+            return false;
+        }
+        next++;
+        return true;
+    }
+
+    bool atEnd() const {
+        return next == indexes.size();
+    }
+
+    // Returns whether the next index has been found yet
+    bool available() const {
+        return next < indexes.size();
+    }
+
+    // Returns how many indexes have been walked past
+    std::size_t position() const {
+        return next;
+    }
+
+    // Function to set whether strings have to be checked to be UTF-8, as
+    // they do once a byte above 0x7f has been seen
+    void setCheckUtf8(bool check) {
+        checkUtf8 = check;
+    }
+
+    // Function to read a string, returning false if one is not next
+    bool string(String &s) {
+        if (peek() != '"') {
+            return false;
+        }
+        // the quote after an opening quote is always its closing quote
+        const std::size_t open = indexes[next] + 1;
+        const std::size_t length = indexes[next + 1] - open;
+        next += 2;
+        const char *raw = text.data() + open;
+        if (checkUtf8 && !validUtf8(raw, length)) {
+            return false;
+        }
+        if (std::memchr(raw, '\\', length) == nullptr) {
+            s.assign(raw, length);
+            return true;
+        }
+        return unescape(raw, length, s);
+    }
+
+    // Function to read true or false, returning false if neither is next
+    bool boolean(bool &b) {
+        if (atEnd()) {
+            return false;
+        }
+        const std::size_t position = indexes[next];
+        if (text.compare(position, 4, "true") == 0 && endsLiteral(position + 4)) {
+            b = true;
+        } else if (text.compare(position, 5, "false") == 0 && endsLiteral(position + 5)) {
+            b = false;
+        } else {
+            return false;
+        }
+        next++;
+        return true;
+    }
+};
+
+/*
+    * Function to read a task, in a project's object
+    * @param walk: The walker, at the task's identifier
+    * @param tasks: The tasks read so far, which the task is added to
+    * @param dueDates: The due dates of the tasks read so far, which the
+    * task's (empty if it has none) is added to, to be read together
+    * @param previous: The identifier of the task before, set to this one's
+    * @param sorted: Cleared if the task is not after the one before
+    * @return bool: False if the task is not as a task should be
+*/
+static bool readTask(IndexWalker &walk, std::vector<Task> &tasks, std::vector<String> &dueDates,
+                     String &previous, bool &sorted) {
+    String ident;
+    if (!walk.string(ident) || !walk.consume(':') || !walk.consume('{')) {
+        return false;
+    }
+    if (!tasks.empty() && !(previous < ident)) {
+        sorted = false;
+    }
+
+    bool completed = false;
+    String dueDate;
+    std::vector<String> tags;
+    String member;
+    if (!walk.consume('}')) {
+        do {
+            if (!walk.string(member) || !walk.consume(':')) {
+                return false;
+            }
+            if (member == "completed") {
+                if (!walk.boolean(completed)) {
+                    return false;
+                }
+            } else if (member == "dueDate") {
+                if (!walk.string(dueDate)) {
+                    return false;
+                }
+            } else if (member == "tags") {
+                // a repeated member keeps its last value
+                tags.clear();
+                if (!walk.consume('[')) {
+                    return false;
+                }
+                if (!walk.consume(']')) {
+                    do {
+                        tags.emplace_back();
+                        if (!walk.string(tags.back())) {
+                            return false;
+                        }
+                    } while (walk.consume(','));
+                    if (!walk.consume(']')) {
+                        return false;
+                    }
+                }
+            } else {
+                return false;
+            }
+        } while (walk.consume(','));
+        if (!walk.consume('}')) {
+            return false;
+        }
+    }
+
+    Task task(ident);
+    task.setComplete(completed);
+    for (const String &tag : tags) {
+        task.addTag(tag);
+    }
+    tasks.push_back(std::move(task));
+    dueDates.push_back(std::move(dueDate));
+    previous = std::move(ident);
+    return true;
+}
+
+// Function to sort by identifier, keeping the last of any with the same one
+template <typename T, typename Ident>
+static void sortUnique(std::vector<T> &items, Ident ident) {
+    std::stable_sort(items.begin(), items.end(),
+                     [&ident](const T &a, const T &b) { return ident(a) < ident(b); });
+    std::vector<T> unique;
+    unique.reserve(items.size());
+    for (std::size_t i = 0; i < items.size(); i++) {
+        if (i + 1 == items.size() || ident(items[i]) != ident(items[i + 1])) {
+            unique.push_back(std::move(items[i]));
+        }
+    }
+    items = std::move(unique);
+}
+
+// What a TodoParser has been handed, and how far it has got through it
+struct TodoParser::State {
+    String owned;
+    const String &text;
+    std::vector<std::uint32_t> indexes;
+    Indexer indexer;
+    IndexWalker walk;
+
+    // Where the second stage is in the object of projects
+    enum Step { START, FIRST, PROJECT, AFTER, DONE, FAILED } step;
+
+    // For a text handed over a piece at a time: how many indexes have been
+    // scanned for how deep in objects and arrays they are, that depth, and
+    // how many indexes there are up to the end of the last project whose
+    // end has been indexed, which can then be walked
+    std::size_t scanned;
+    unsigned int depth;
+    std::size_t ready;
+
+    std::vector<ParsedProject> result;
+    bool sorted;
+    std::vector<String> dueDates;
+    std::vector<Date> dates;
+
+    // Reads a text held elsewhere, or if there is none the text handed over
+    explicit State(const String *source)
+        : text(source ? *source : owned), indexer(classifyFunction()), walk(text, indexes, false),
+          step(START), scanned(0), depth(0), ready(0), sorted(true) {}
+
+    void scan();
+    void walkReady();
+    bool readProject();
+    bool finish(std::vector<ParsedProject> &projects);
+};
+
+// Function to find where the projects indexed since the last scan end
+void TodoParser::State::scan() {
+    for (; scanned < indexes.size(); scanned++) {
+        switch (text[indexes[scanned]]) {
+            case '{':
+            case '[':
+                depth++;
+                break;
+            case '}':
+            case ']':
+                if (depth == 2) {
+                    ready = scanned + 1;
+                }
+                if (depth > 0) {
+                    depth--;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// Function to walk the indexes as far as the last project ready to be read
+void TodoParser::State::walkReady() {
+    walk.setCheckUtf8(indexer.highBytes != 0);
+    while (true) {
+        switch (step) {
+            case START:
+                if (!walk.available()) {
+                    return;
+                }
+                step = walk.consume('{') ? FIRST : FAILED;
+                break;
+            case FIRST:
+                if (!walk.available()) {
+                    return;
+                }
+                step = walk.consume('}') ? DONE : PROJECT;
+                break;
+            case PROJECT:
+                if (walk.position() >= ready) {
+                    return;
+                }
+                step = readProject() ? AFTER : FAILED;
+                break;
+            case AFTER:
+                if (!walk.available()) {
+                    return;
+                }
+                if (walk.consume(',')) {
+                    step = PROJECT;
+                } else {
+                    step = walk.consume('}') ? DONE : FAILED;
+                }
+                break;
+            default:
+                return;
+        }
+    }
+}
+
+// Function to read a project, with the walker at its identifier, returning
+// false if it is not as a project should be
+bool TodoParser::State::readProject() {
+    result.emplace_back();
+    ParsedProject &project = result.back();
+    if (!walk.string(project.ident) || !walk.consume(':') || !walk.consume('{')) {
+        return false;
+    }
+    if (result.size() > 1 && !(result[result.size() - 2].ident < project.ident)) {
+        sorted = false;
+    }
+    if (walk.consume('}')) {
+        return true;
+    }
+
+    String previous;
+    bool tasksSorted = true;
+    dueDates.clear();
+    do {
+        if (!readTask(walk, project.tasks, dueDates, previous, tasksSorted)) {
+            return false;
+        }
+    } while (walk.consume(','));
+    if (!walk.consume('}')) {
+        return false;
+    }
+    if (!Date::parseMany(dueDates, dates)) {
+        return false;
+    }
+    for (std::size_t i = 0; i < dates.size(); i++) {
+        project.tasks[i].setDueDate(dates[i]);
+    }
+    if (!tasksSorted) {
+        sortUnique(project.tasks, [](const Task &t) { return t.getIdent(); });
+    }
+    return true;
+}
+
+// Function to index and walk the rest of the text, returning the projects
+// read if it is a database as save writes them
+bool TodoParser::State::finish(std::vector<ParsedProject> &projects) {
+    if (step == FAILED || text.size() > MAX_SIZE || !indexer.finish(text, indexes)) {
+        return false;
+    }
+    ready = indexes.size();
+    walkReady();
+    if (step != DONE || !walk.atEnd()) {
+        return false;
+    }
+    if (!sorted) {
+        sortUnique(result, [](const ParsedProject &p) -> const String & { return p.ident; });
+    }
+    projects = std::move(result);
+    return true;
+}
+
+/*
+    * Constructor to create a TodoParser to be handed a text a piece at a time
+    * @param size: How long the text is expected to be, to make room for it
+*/
+TodoParser::TodoParser(std::size_t size) : state(new State(nullptr)) {
+    state->owned.reserve(size);
+    state->indexes.reserve(size / 4 + 64);
+}
+
+TodoParser::~TodoParser() = default;
+
+/*
+    * Function to hand over the next piece of the text. Each whole block of
+    * 64 bytes is indexed straight away, and each project is read as soon as
+    * its end has been indexed, so that reading the text overlaps with
+    * whatever hands it over.
+    * @param data: The piece
+    * @param length: Its length
+*/
+void TodoParser::feed(const char *data, std::size_t length) {
+    State &s = *state;
+    s.owned.append(data, length);
+    if (s.step == State::FAILED || s.owned.size() > MAX_SIZE) {
+        return;
+    }
+    s.indexer.blocks(s.text, s.indexes);
+    s.scan();
+    s.walkReady();
+}
+
+/*
+    * Function to read what is left once the whole text has been handed over
+    * @param projects: Set to the projects read, sorted by identifier, if
+    * they could be
+    * @return bool: False if the text is not a database as save writes them,
+    * in which case it should be read with nlohmann::json (see getText)
+*/
+bool TodoParser::finish(std::vector<ParsedProject> &projects) {
+    return state->finish(projects);
+}
+
+// Returns the text handed over
+const String &TodoParser::getText() const noexcept {
+    return state->text;
+}
+
+/*
+    * Function to read the projects and tasks of a database
+    * @param text: The text of the database file
+    * @param projects: Set to the projects read, sorted by identifier, if
+    * they could be
+    * @return bool: False if the text is not a database as save writes them,
+    * in which case it should be read with nlohmann::json
+*/
+bool TodoParser::parse(const String &text, std::vector<ParsedProject> &projects) {
+    State state(&text);
+    state.indexes.reserve(text.size() / 4 + 64);
+    return state.finish(projects);
+}
+
+/*
+    * Function to index the text of a database, as the first stage of parse
+    * @param text: The text
+    * @param indexes: Set to the position of every quote, structural
+    * character outside a string and start of anything else
+    * @return bool: False if a string is not closed or has a control
+    * character in
+*/
+bool TodoParser::index(const String &text, std::vector<std::uint32_t> &indexes) {
+    indexes.clear();
+    if (text.size() > MAX_SIZE) {
+        return false;
+    }
+    indexes.reserve(text.size() / 4 + 64);
+    Indexer indexer(classifyFunction());
+    return indexer.finish(text, indexes);
+}
+
+// Returns the indexer in use
+Simd::Level TodoParser::getIndexer() noexcept {
+    return indexerInUse();
+}
+
+/*
+    * Function to choose the indexer to use, e.g. to compare them
+    * @param level: The indexer
+    * @return Whether the CPU supports it; if not, the indexer is unchanged
+*/
+bool TodoParser::setIndexer(Simd::Level level) noexcept {
+    if (!Simd::supported(level)) {
+        return false;
+    }
+    indexerInUse() = level;
+    return true;
+}
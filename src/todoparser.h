@@ -0,0 +1,70 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the TodoParser class.
+ * A TodoParser reads the text of a database file in two stages, in the
+ * style of simdjson (https://arxiv.org/abs/1902.08318).
+ * The first stage indexes the text 64 bytes at a time: each block is
+ * classified with SSE2 or AVX2 (see Simd) into bit masks of its quotes,
+ * backslashes, structural characters ({}[]:,), whitespace and control
+ * characters. Quotes escaped by an odd run of backslashes are masked out,
+ * a prefix XOR of the quotes left gives which bytes are inside strings, and
+ * the index is the position of every quote, every structural character
+ * outside a string and the start of anything else (such as a literal).
+ * The second stage walks the index as the database's fixed layout says it
+ * must be: an object of projects, each an object of tasks, each an object
+ * with "completed" (a boolean), "dueDate" (a string) and "tags" (an array
+ * of strings). Anything else, from a member that is not one of these to
+ * JSON that is not valid, makes parse return false, so that the caller can
+ * fall back to nlohmann::json, which reports the error or reads what it can
+ * as it always has.
+ * Projects, and the tasks of each project, are returned sorted by
+ * identifier, and a repeated identifier keeps the last value, as when the
+ * database is read into a Json object.
+ * A TodoParser object can also be handed the text a piece at a time as it
+ * is read from the file (see feed), carrying the first stage's state from
+ * one piece to the next and reading each project as soon as its end has
+ * been indexed, so that parsing overlaps with reading.
+*/
+
+
+#ifndef TODOPARSER_H
+#define TODOPARSER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "simd.h"
+#include "task.h"
+
+class TodoParser {
+public:
+  // A project as read, with its tasks
+  struct ParsedProject {
+    String ident;
+    std::vector<Task> tasks;
+  };
+
+  explicit TodoParser(std::size_t size = 0);
+  ~TodoParser();
+
+  TodoParser(const TodoParser &other) = delete;
+  TodoParser &operator=(const TodoParser &other) = delete;
+
+  void feed(const char *data, std::size_t length);
+  bool finish(std::vector<ParsedProject> &projects);
+  const String &getText() const noexcept;
+
+  static bool parse(const String &text, std::vector<ParsedProject> &projects);
+  static bool index(const String &text, std::vector<std::uint32_t> &indexes);
+
+  static Simd::Level getIndexer() noexcept;
+  static bool setIndexer(Simd::Level level) noexcept;
+
+private:
+  struct State;
+  std::unique_ptr<State> state;
+};
+
+#endif // TODOPARSER_H
@@ -0,0 +1,540 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the implementation of the WriteQueue class.
+ * io_uring is used through its system calls directly, so that no library
+ * has to be installed to build.
+*/
+
+
+#include "writequeue.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+
+const std::size_t WriteQueue::BUFFER_SIZE;
+const unsigned int WriteQueue::BUFFER_COUNT;
+
+
+#ifdef __linux__
+
+// The rings shared with the kernel, and what each submitted operation is for
+struct WriteQueue::Ring {
+  // A write of the part of a buffer not yet written, or an fsync if it
+  // has no buffer
+  struct Operation {
+    Ticket ticket;
+    int buffer;
+    unsigned int length;
+    int fd;
+    long long offset;
+    unsigned int written;
+  };
+
+  int fd;
+  void *sqMap;
+  std::size_t sqMapSize;
+  void *cqMap;
+  std::size_t cqMapSize;
+  io_uring_sqe *sqes;
+  std::size_t sqesSize;
+
+  unsigned *sqTail;
+  unsigned *sqMask;
+  unsigned *sqArray;
+  unsigned *cqHead;
+  unsigned *cqTail;
+  unsigned *cqMask;
+  io_uring_cqe *cqes;
+
+  // Buffers registered with the kernel, if it allowed them to be
+  std::vector<std::unique_ptr<char[]>> buffers;
+  std::vector<int> freeBuffers;
+  bool registered;
+
+  // One slot per operation that may be in flight at once
+  std::vector<Operation> operations;
+  std::vector<unsigned int> freeOperations;
+
+  // Number of operations prepared since the last submit
+  unsigned int prepared;
+
+  // Operations to submit again: writes cut short, and the operations
+  // linked after them, which the kernel cancels
+  std::vector<unsigned int> retries;
+
+  Ring() : fd(-1), sqMap(MAP_FAILED), sqMapSize(0), cqMap(MAP_FAILED), cqMapSize(0),
+           sqes(static_cast<io_uring_sqe *>(MAP_FAILED)), sqesSize(0), registered(false),
+           prepared(0) {}
+
+  ~Ring() {
+    if (sqes != MAP_FAILED) {
+      munmap(sqes, sqesSize);
+    }
+    if (cqMap != MAP_FAILED && cqMap != sqMap) {
+      munmap(cqMap, cqMapSize);
+    }
+    if (sqMap != MAP_FAILED) {
+      munmap(sqMap, sqMapSize);
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  // Set up a ring with room for depth operations, false if io_uring is unavailable
+  bool setup(unsigned int depth) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    fd = syscall(__NR_io_uring_setup, depth, &params);
+    // Writing at the current position (for appends) needs Linux 5.6
+    if (fd < 0 || !(params.features & IORING_FEAT_RW_CUR_POS)) {
+      return false;
+    }
+
+    sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+      sqMapSize = cqMapSize = std::max(sqMapSize, cqMapSize);
+    }
+    sqMap = mmap(nullptr, sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                 fd, IORING_OFF_SQ_RING);
+    if (sqMap == MAP_FAILED) {
+      return false;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+      cqMap = sqMap;
+    } else {
+      cqMap = mmap(nullptr, cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   fd, IORING_OFF_CQ_RING);
+      if (cqMap == MAP_FAILED) {
+        return false;
+      }
+    }
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe *>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+    if (sqes == MAP_FAILED) {
+      return false;
+    }
+
+    char *sq = static_cast<char *>(sqMap);
+    char *cq = static_cast<char *>(cqMap);
+    sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sqMask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cqMask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    // The completion ring holds at least as many entries as the submission
+    // ring, so limiting the operations in flight to it means none are dropped
+    operations.resize(params.sq_entries);
+    for (unsigned int i = params.sq_entries; i > 0; i--) {
+      freeOperations.push_back(i - 1);
+    }
+
+    std::vector<iovec> iovecs;
+    for (unsigned int i = 0; i < BUFFER_COUNT; i++) {
+      buffers.emplace_back(new char[BUFFER_SIZE]);
+      iovecs.push_back({buffers.back().get(), BUFFER_SIZE});
+      freeBuffers.push_back(BUFFER_COUNT - 1 - i);
+    }
+    // Registering pins the buffers in memory, which the memlock limit may
+    // not allow; plain writes from the same buffers are used then
+    registered = syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS,
+                         iovecs.data(), iovecs.size()) == 0;
+    return true;
+  }
+
+  // Prepare an operation, returning its entry
+  io_uring_sqe *prepare(const Operation &operation) {
+    const unsigned int slot = freeOperations.back();
+    freeOperations.pop_back();
+    operations[slot] = operation;
+    return queue(slot);
+  }
+
+  // Prepare the entry for the operation in a slot, writing from where the
+  // last attempt stopped
+  io_uring_sqe *queue(unsigned int slot) {
+    const Operation &operation = operations[slot];
+    const unsigned int tail = *sqTail + prepared++;
+    const unsigned int index = tail & *sqMask;
+    io_uring_sqe *sqe = &sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->user_data = slot;
+    sqe->fd = operation.fd;
+    if (operation.buffer < 0) {
+      sqe->opcode = IORING_OP_FSYNC;
+      sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+    } else {
+      sqe->opcode = registered ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+      sqe->off = operation.offset < 0 ? -1 : operation.offset + operation.written;
+      sqe->addr = reinterpret_cast<unsigned long long>(buffers[operation.buffer].get() +
+                                                       operation.written);
+      sqe->len = operation.length - operation.written;
+      sqe->buf_index = operation.buffer;
+    }
+    sqArray[index] = index;
+    return sqe;
+  }
+
+  // Submit the retries, those of each ticket linked in the order they were
+  // first submitted
+  void resubmit() {
+    io_uring_sqe *last = nullptr;
+    for (unsigned int slot : retries) {
+      if (last && operations[slot].ticket == operations[last->user_data].ticket) {
+        last->flags |= IOSQE_IO_LINK;
+      }
+      last = queue(slot);
+    }
+    retries.clear();
+    submit();
+  }
+
+  // Submit the prepared operations
+  void submit() {
+    __atomic_store_n(sqTail, *sqTail + prepared, __ATOMIC_RELEASE);
+    while (prepared > 0) {
+      const int submitted = syscall(__NR_io_uring_enter, fd, prepared, 0, 0, nullptr, 0);
+      if (submitted < 0) {
+        if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+          continue;
+        }
+        throw std::runtime_error(std::string("io_uring submit failed: ") +
+                                 std::strerror(errno));
+      }
+      prepared -= submitted;
+    }
+  }
+};
+
+#else
+
+struct WriteQueue::Ring {};
+
+#endif
+
+
+/*
+    * Constructor to create a WriteQueue
+    * @param backend: URING to use io_uring, BLOCKING to write as writes are
+    * queued, AUTOMATIC to use io_uring where it is available
+    * @param depth: The number of writes that may be in flight at once
+    * @throws std::runtime_error: If URING is asked for and is not available
+*/
+WriteQueue::WriteQueue(Backend backend, unsigned int depth) : backend(BLOCKING), next(1) {
+#ifdef __linux__
+    if (backend != BLOCKING) {
+        ring.reset(new Ring());
+        if (ring->setup(depth)) {
+            this->backend = URING;
+        } else {
+            ring.reset();
+        }
+    }
+#endif
+    if (backend == URING && this->backend != URING) {
+        throw std::runtime_error("io_uring is not available");
+    }
+}
+
+// Destructor, waits for every queued write
+WriteQueue::~WriteQueue() {
+    try {
+        drain();
+    } catch (const std::exception &) {
+        // Nobody is left to tell
+    }
+}
+
+// Function to return the WriteQueue shared by the whole program
+WriteQueue &WriteQueue::shared() {
+    static WriteQueue queue;
+    return queue;
+}
+
+// Function to return the backend in use, BLOCKING or URING
+WriteQueue::Backend WriteQueue::getBackend() const noexcept {
+    return backend;
+}
+
+/*
+    * Function to queue writing data to a file, returning straight away
+    * @param fd: The file descriptor, which must stay open until the ticket is done
+    * @param data: The data, which is copied
+    * @param offset: Where in the file to write, -1 for the current position
+    * (the end for a file opened to append)
+    * @param sync: True to flush the file to disk once the data is written
+    * @return Ticket: The ticket to wait for
+*/
+WriteQueue::Ticket WriteQueue::write(int fd, const std::string &data, long long offset,
+                                     bool sync) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Ticket ticket = next++;
+    pending[ticket] = {0, 0};
+    if (backend == URING) {
+        writeRing(ticket, fd, data, offset, sync);
+    } else {
+        writeBlocking(ticket, fd, data, offset, sync);
+    }
+    auto it = pending.find(ticket);
+    if (it != pending.end() && it->second.operations == 0 && it->second.error == 0) {
+        pending.erase(it);
+    }
+    return ticket;
+}
+
+void WriteQueue::writeBlocking(Ticket ticket, int fd, const std::string &data,
+                               long long offset, bool sync) {
+    std::size_t written = 0;
+    while (written < data.size()) {
+#ifdef _WIN32
+        if (offset >= 0 && _lseeki64(fd, offset + written, SEEK_SET) < 0) {
+            pending[ticket].error = errno;
+            return;
+        }
+        const int result = _write(fd, data.data() + written, data.size() - written);
+#else
+        const ssize_t result = offset < 0
+            ? ::write(fd, data.data() + written, data.size() - written)
+            : pwrite(fd, data.data() + written, data.size() - written, offset + written);
+#endif
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            pending[ticket].error = errno;
+            return;
+        }
+        written += result;
+    }
+#ifdef _WIN32
+    if (sync && _commit(fd) != 0) {
+#else
+    if (sync && fsync(fd) != 0) {
+#endif
+        pending[ticket].error = errno;
+    }
+}
+
+void WriteQueue::writeRing(Ticket ticket, int fd, const std::string &data,
+                           long long offset, bool sync) {
+#ifdef __linux__
+    std::size_t queued = 0;
+    do {
+        // Queue as much of the data as there are free buffers for, linked
+        // so that the fsync only runs once all of it is written
+        io_uring_sqe *last = nullptr;
+        while (queued < data.size()) {
+            while (ring->freeBuffers.empty() || ring->freeOperations.empty()) {
+                if (ring->prepared > 0) {
+                    break;
+                }
+                reap(true);
+            }
+            if (ring->freeBuffers.empty() || ring->freeOperations.empty()) {
+                break;
+            }
+            const int buffer = ring->freeBuffers.back();
+            ring->freeBuffers.pop_back();
+            const std::size_t length = std::min(BUFFER_SIZE, data.size() - queued);
+            std::memcpy(ring->buffers[buffer].get(), data.data() + queued, length);
+
+            last = ring->prepare({ticket, buffer, static_cast<unsigned int>(length), fd,
+                                  offset < 0 ? -1 : offset + static_cast<long long>(queued), 0});
+            last->flags = IOSQE_IO_LINK;
+            pending[ticket].operations++;
+            queued += length;
+        }
+
+        if (queued == data.size() && sync) {
+            if (ring->freeOperations.empty() && ring->prepared > 0) {
+                // The writes hold the last free operations, and cannot finish
+                // to free one until they are submitted. The fsync is not linked
+                // to them then, so it waits for them to be done instead.
+                if (last) {
+                    last->flags &= ~IOSQE_IO_LINK;
+                    last = nullptr;
+                }
+                ring->submit();
+                while (pending[ticket].operations > 0) {
+                    reap(true);
+                }
+                if (pending[ticket].error != 0) {
+                    return;
+                }
+            }
+            while (ring->freeOperations.empty()) {
+                reap(true);
+            }
+            last = ring->prepare({ticket, -1, 0, fd, 0, 0});
+            pending[ticket].operations++;
+        }
+        if (last) {
+            last->flags &= ~IOSQE_IO_LINK;
+        }
+        ring->submit();
+
+        // Links do not reach across submissions, so the rest of a large
+        // write waits for this part to finish
+        if (queued < data.size()) {
+            while (pending[ticket].operations > 0) {
+                reap(true);
+            }
+            if (pending[ticket].error != 0) {
+                return;
+            }
+        }
+    } while (queued < data.size());
+#else
+    (void)ticket, (void)fd, (void)data, (void)offset, (void)sync;
+#endif
+}
+
+// Process the completed operations, waiting for at least one if block is
+// true. Writes cut short are submitted again for the rest of their data, as
+// the blocking writes loop, unless operations are being prepared.
+void WriteQueue::reap(bool block) {
+#ifdef __linux__
+    if (!ring->retries.empty() && ring->prepared == 0) {
+        ring->resubmit();
+    }
+    unsigned int head = *ring->cqHead;
+    if (block && head == __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE)) {
+        while (syscall(__NR_io_uring_enter, ring->fd, 0, 1, IORING_ENTER_GETEVENTS,
+                       nullptr, 0) < 0) {
+            if (errno != EINTR) {
+                throw std::runtime_error(std::string("io_uring wait failed: ") +
+                                         std::strerror(errno));
+            }
+        }
+    }
+    const unsigned int tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+        const io_uring_cqe &cqe = ring->cqes[head & *ring->cqMask];
+        Ring::Operation &operation = ring->operations[cqe.user_data];
+        auto it = pending.find(operation.ticket);
+        const bool failed = it != pending.end() && it->second.error != 0;
+        int error = 0;
+        if (cqe.res == -ECANCELED && !failed) {
+            // Linked after a write cut short, so it has to wait for the rest
+            ring->retries.push_back(cqe.user_data);
+            continue;
+        } else if (cqe.res < 0) {
+            error = -cqe.res;
+        } else if (operation.buffer >= 0 && operation.written + cqe.res < operation.length) {
+            if (cqe.res > 0) {
+                operation.written += cqe.res;
+                ring->retries.push_back(cqe.user_data);
+                continue;
+            }
+            // Writing nothing at all means there is no room for more
+            error = ENOSPC;
+        }
+        ring->freeOperations.push_back(cqe.user_data);
+        if (operation.buffer >= 0) {
+            ring->freeBuffers.push_back(operation.buffer);
+        }
+        finish(operation.ticket, error);
+    }
+    __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+    if (!ring->retries.empty() && ring->prepared == 0) {
+        ring->resubmit();
+    }
+#else
+    (void)block;
+#endif
+}
+
+// Record that an operation of a ticket is done
+void WriteQueue::finish(Ticket ticket, int error) {
+    auto it = pending.find(ticket);
+    if (it == pending.end()) {
+        return;
+    }
+    if (it->second.error == 0) {
+        it->second.error = error;
+    }
+    if (--it->second.operations == 0 && it->second.error == 0) {
+        pending.erase(it);
+    }
+}
+
+/*
+    * Function to check, without waiting, if the writes of a ticket are done
+    * @param ticket: The ticket returned by write
+    * @return bool: True if they are done, whether or not they succeeded
+*/
+bool WriteQueue::done(Ticket ticket) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (backend == URING) {
+        reap(false);
+    }
+    auto it = pending.find(ticket);
+    return it == pending.end() || it->second.operations == 0;
+}
+
+void WriteQueue::waitLocked(Ticket ticket) {
+    auto it = pending.find(ticket);
+    while (it != pending.end() && it->second.operations > 0) {
+        reap(true);
+        it = pending.find(ticket);
+    }
+    if (it != pending.end()) {
+        const int error = it->second.error;
+        pending.erase(it);
+        throw std::runtime_error(std::string("Write failed: ") + std::strerror(error));
+    }
+}
+
+/*
+    * Function to wait until the writes of a ticket are done
+    * @param ticket: The ticket returned by write
+    * @throws std::runtime_error: If any of the writes, or the fsync, failed
+*/
+void WriteQueue::wait(Ticket ticket) {
+    std::lock_guard<std::mutex> lock(mutex);
+    waitLocked(ticket);
+}
+
+/*
+    * Function to wait until every queued write is done
+    * @throws std::runtime_error: If any of them failed, once all are done
+*/
+void WriteQueue::drain() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string failure;
+    while (!pending.empty()) {
+        try {
+            waitLocked(pending.begin()->first);
+        } catch (const std::runtime_error &e) {
+            if (failure.empty()) {
+                failure = e.what();
+            }
+        }
+    }
+    if (!failure.empty()) {
+        throw std::runtime_error(failure);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Author: Arvin Singh
+ * Date: 19/10/2026
+ * Description: This file contains the declaration of the WriteQueue class.
+ * A WriteQueue writes data to files, and optionally flushes it to disk,
+ * without making the caller wait: write returns a ticket straight away and
+ * wait blocks until the writes queued under that ticket are done.
+ * On Linux the writes are submitted to the kernel through io_uring. The
+ * data is copied into buffers registered with the kernel once, and the
+ * writes of a ticket are linked to the fsync that follows them, so the
+ * kernel only flushes the file once every write has succeeded.
+ * Where io_uring is not available (other systems, older kernels, or
+ * sandboxes that forbid it) the writes are made, blocking, as they are
+ * queued, so that callers work the same either way.
+*/
+
+
+#ifndef WRITEQUEUE_H
+#define WRITEQUEUE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class WriteQueue {
+public:
+  enum Backend { AUTOMATIC, BLOCKING, URING };
+  using Ticket = unsigned long long;
+
+  // The size and number of the buffers registered with the kernel
+  static const std::size_t BUFFER_SIZE = 256 * 1024;
+  static const unsigned int BUFFER_COUNT = 8;
+
+private:
+  struct Ring;
+
+  // The number of operations of a ticket still running, and the first error
+  struct Pending {
+    unsigned int operations;
+    int error;
+  };
+
+  Backend backend;
+  std::unique_ptr<Ring> ring;
+  std::map<Ticket, Pending> pending;
+  Ticket next;
+  std::mutex mutex;
+
+  void writeBlocking(Ticket ticket, int fd, const std::string &data, long long offset,
+                     bool sync);
+  void writeRing(Ticket ticket, int fd, const std::string &data, long long offset,
+                 bool sync);
+  void reap(bool block);
+  void finish(Ticket ticket, int error);
+  void waitLocked(Ticket ticket);
+
+public:
+  explicit WriteQueue(Backend backend = AUTOMATIC, unsigned int depth = 64);
+  WriteQueue(const WriteQueue &other) = delete;
+  WriteQueue &operator=(const WriteQueue &other) = delete;
+  ~WriteQueue();
+
+  static WriteQueue &shared();
+
+  Backend getBackend() const noexcept;
+
+  Ticket write(int fd, const std::string &data, long long offset, bool sync);
+  bool done(Ticket ticket);
+  void wait(Ticket ticket);
+  void drain();
+};
+
+#endif // WRITEQUEUE_H
@@ -0,0 +1,268 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for the counters kept by
+// Project and TodoList objects, and for saving and
+// loading them alongside the database file.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/todo.h"
+
+SCENARIO("Project and TodoList counters follow changes to their tasks",
+         "[stats]") {
+
+  GIVEN("a TodoList with one empty Project") {
+
+    TodoList tlObj1{};
+    Project &pObj1 = tlObj1.newProject("Test");
+
+    Date past;
+    past.setDate(2000, 1, 1);
+    Date future;
+    future.setDate(2999, 1, 1);
+    Date today;
+    today.setDate(2024, 6, 1);
+
+    REQUIRE(pObj1.getStats().numTasks() == 0);
+    REQUIRE(tlObj1.getStats().numTasks() == 0);
+
+    WHEN("tasks are created, tagged, completed and given due dates") {
+
+      Task &tObj1 = tlObj1.getProject("Test").newTask("Task 1");
+      tObj1.addTag("uni");
+      tObj1.addTag("home");
+      tObj1.setDueDate(past);
+
+      Task &tObj2 = tlObj1.getProject("Test").newTask("Task 2");
+      tObj2.addTag("uni");
+      tObj2.setDueDate(future);
+
+      THEN("the counters of the Project and TodoList are updated") {
+
+        const Stats &stats = tlObj1.getProject("Test").getStats();
+        REQUIRE(stats.numTasks() == 2);
+        REQUIRE(stats.numCompleted() == 0);
+        REQUIRE(stats.numOverdue(today) == 1);
+        REQUIRE(stats.numTags() == 2);
+        REQUIRE(tlObj1.getStats() == stats);
+
+        AND_WHEN("the overdue task is completed and a tag removed") {
+
+          tlObj1.getProject("Test").getTask("Task 1").setComplete(true);
+          tlObj1.getProject("Test").getTask("Task 1").deleteTag("home");
+
+          THEN("it is no longer counted as overdue") {
+
+            REQUIRE(stats.numCompleted() == 1);
+            REQUIRE(stats.numOverdue(today) == 0);
+            REQUIRE(stats.numTags() == 1);
+            REQUIRE(tlObj1.getStats() == stats);
+
+          } // THEN
+
+        } // AND_WHEN
+
+        AND_WHEN("a task is deleted") {
+
+          tlObj1.getProject("Test").deleteTask("Task 1");
+
+          THEN("its tags and due date are no longer counted") {
+
+            REQUIRE(stats.numTasks() == 1);
+            REQUIRE(stats.numOverdue(today) == 0);
+            REQUIRE(stats.getTagCounts().at("uni") == 1);
+            REQUIRE(tlObj1.getStats() == stats);
+
+          } // THEN
+
+        } // AND_WHEN
+
+        AND_WHEN("a copy of a task is changed") {
+
+          Task tObj3 = tlObj1.getProject("Test").getTask("Task 2");
+          tObj3.setComplete(true);
+          tObj3.addTag("copy");
+
+          THEN("the counters are unchanged") {
+
+            REQUIRE(stats.numCompleted() == 0);
+            REQUIRE(stats.numTags() == 2);
+
+          } // THEN
+
+        } // AND_WHEN
+
+        AND_WHEN("the project is deleted") {
+
+          tlObj1.deleteProject("Test");
+
+          THEN("the TodoList counters are empty") {
+
+            REQUIRE(tlObj1.getStats() == Stats());
+
+          } // THEN
+
+        } // AND_WHEN
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a Project with tasks is added") {
+
+      Project pObj2{"Other"};
+      Task tObj1{"Task 1"};
+      tObj1.addTag("uni");
+      tObj1.setComplete(true);
+      REQUIRE(pObj2.addTask(tObj1));
+      REQUIRE(pObj2.getStats().numCompleted() == 1);
+
+      REQUIRE(tlObj1.addProject(pObj2));
+
+      THEN("its counters are added to the TodoList") {
+
+        REQUIRE(tlObj1.getStats().numTasks() == 1);
+        REQUIRE(tlObj1.getStats().numCompleted() == 1);
+        REQUIRE(tlObj1.getStats().numTags() == 1);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("Counters are saved next to the database and read by the stats "
+         "action",
+         "[stats]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a database saved by a TodoList") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{ \"M02\": { \"Lab Assignment 1\": { \"completed\": true, "
+        "\"dueDate\": \"2024-11-13\", \"tags\": [ \"uni\", \"c\", "
+        "\"programming\" ] }, \"Lab Assignment 6\": { \"completed\": false, "
+        "\"dueDate\": \"2024-11-23\", \"tags\": [ \"uni\", \"c++\", "
+        "\"programming\", \"standard library\" ] } }, \"M118\": { \"Write "
+        "Mobile App\": { \"completed\": true, \"dueDate\": \"2023-11-30\", "
+        "\"tags\": [ \"uni\", \"programming\", \"android\" ] } } }"));
+
+    TodoList tlObj1{};
+    REQUIRE_NOTHROW(tlObj1.load(filePath));
+    REQUIRE_NOTHROW(tlObj1.save(filePath));
+
+    WHEN("the counters are loaded without the database") {
+
+      StatsContainer stats;
+
+      THEN("they match the counters of the TodoList") {
+
+        REQUIRE(TodoList::loadStats(filePath, stats));
+        REQUIRE(stats.size() == 2);
+        REQUIRE(stats[0].first == "M02");
+        REQUIRE(stats[0].second == tlObj1.getProject("M02").getStats());
+        REQUIRE(stats[1].second == tlObj1.getProject("M118").getStats());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the database is changed without updating the counters") {
+
+      REQUIRE_NOTHROW(writeFileContents(filePath, "{}"));
+
+      THEN("the saved counters are rejected") {
+
+        StatsContainer stats;
+        REQUIRE_FALSE(TodoList::loadStats(filePath, stats));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the database is replaced by one of the same size") {
+
+      const std::string replacement = filePath + ".replacement";
+      std::ifstream original(filePath);
+      std::string contents((std::istreambuf_iterator<char>(original)),
+                           std::istreambuf_iterator<char>());
+      contents[contents.find("true")] = 'T';
+      REQUIRE_NOTHROW(writeFileContents(replacement, contents));
+      REQUIRE(std::rename(replacement.c_str(), filePath.c_str()) == 0);
+
+      THEN("the saved counters are rejected") {
+
+        StatsContainer stats;
+        REQUIRE_FALSE(TodoList::loadStats(filePath, stats));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("another process saves the database after it was loaded") {
+
+      TodoList tlObj2{};
+      REQUIRE_NOTHROW(tlObj2.load(filePath));
+      tlObj2.getProject("M02").deleteTask("Lab Assignment 1");
+      REQUIRE_NOTHROW(tlObj2.save(filePath));
+
+      THEN("the counters of the older TodoList are not saved over the new ones") {
+
+        REQUIRE_NOTHROW(tlObj1.saveStats(filePath));
+        StatsContainer stats;
+        REQUIRE(TodoList::loadStats(filePath, stats));
+        REQUIRE(stats[0].second == tlObj2.getProject("M02").getStats());
+        REQUIRE(stats[0].second.numTasks() == 1);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the stats action is run for a project") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "stats",
+                    "--project", "M02"});
+      auto **argv = argvObj.argv();
+      auto argc = argvObj.argc();
+
+      std::stringstream buffer;
+      std::streambuf *old = std::cout.rdbuf(buffer.rdbuf());
+      int result = App::run(argc, argv);
+      std::cout.rdbuf(old);
+
+      THEN("the counters of that project are printed") {
+
+        REQUIRE(result == 0);
+        Json output = Json::parse(buffer.str());
+        REQUIRE(output["tasks"] == 2);
+        REQUIRE(output["completed"] == 1);
+        REQUIRE(output["tags"] == 5);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
@@ -0,0 +1,149 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for grouping and counting
+// tasks with the Aggregation class.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <string>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/aggregation.h"
+
+SCENARIO("Tasks can be grouped and counted along several dimensions",
+         "[aggregation]") {
+
+  const std::string filePath = "./tests/testdatabase.json";
+
+  GIVEN("the test database") {
+
+    TodoList tlObj1{};
+    REQUIRE_NOTHROW(tlObj1.load(filePath));
+
+    WHEN("the dimensions are not recognised") {
+
+      THEN("a std::invalid_argument exception is thrown") {
+
+        REQUIRE_THROWS_AS(Aggregation("owner"), std::invalid_argument);
+        REQUIRE_THROWS_AS(Aggregation(""), std::invalid_argument);
+        REQUIRE_THROWS_AS(Aggregation("project:x"), std::invalid_argument);
+        REQUIRE_THROWS_AS(Aggregation("project:0"), std::invalid_argument);
+        REQUIRE_THROWS_AS(Aggregation("project:99999999999"), std::invalid_argument);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("grouping by project") {
+
+      Json result = Aggregation("project").run(tlObj1);
+
+      THEN("there is one group per project") {
+
+        REQUIRE(result.size() == 2);
+        REQUIRE(result[0]["project"] == "M02");
+        REQUIRE(result[0]["count"] == 2);
+        REQUIRE(result[1]["project"] == "M118");
+        REQUIRE(result[1]["count"] == 1);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("grouping by a project prefix and due month") {
+
+      Json result = Aggregation("project:1,month").run(tlObj1);
+
+      THEN("projects sharing the prefix are counted together") {
+
+        REQUIRE(result.size() == 3);
+        REQUIRE(result[0]["project"] == "M");
+        REQUIRE(result[0]["month"] == "2023-11");
+        REQUIRE(result[0]["count"] == 1);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("grouping by tag and completed state") {
+
+      Json result = Aggregation("tag,completed").run(tlObj1);
+
+      THEN("a task is counted once for each of its tags") {
+
+        unsigned long total = 0;
+        for (const Json &row : result) {
+          total += row["count"].get<unsigned long>();
+          if (row["tag"] == "programming" && row["completed"] == true) {
+            REQUIRE(row["count"] == 2);
+          }
+        }
+        REQUIRE(total == 10);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("identifiers and tags with multi-byte characters and control bytes") {
+
+    TodoList tlObj1{};
+    Task &eclair = tlObj1.newProject("\xc3\xa9" "clair").newTask("T1");
+    eclair.addTag("a\x1f" "b");
+    Task &plain = tlObj1.newProject("ecru").newTask("T2");
+    plain.addTag("a");
+    tlObj1.getProject("ecru").newTask("T3").addTag("\x1e");
+    tlObj1.getProject("ecru").newTask("T4");
+
+    WHEN("grouping by the first character of the project and by tag") {
+
+      Json result = Aggregation("project:1,tag").run(tlObj1);
+
+      THEN("characters are not cut in two, and every value is its own group") {
+
+        REQUIRE_NOTHROW(result.dump());
+        REQUIRE(result.size() == 4);
+        REQUIRE(result[0] == Json({{"project", "e"}, {"tag", nullptr}, {"count", 1}}));
+        REQUIRE(result[1] == Json({{"project", "e"}, {"tag", "\x1e"}, {"count", 1}}));
+        REQUIRE(result[2] == Json({{"project", "e"}, {"tag", "a"}, {"count", 1}}));
+        REQUIRE(result[3] == Json({{"project", "\xc3\xa9"}, {"tag", "a\x1f" "b"}, {"count", 1}}));
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("a TodoList with many tasks") {
+
+    TodoList tlObj1{};
+    for (int i = 0; i < 20000; i++) {
+      Task &task = tlObj1.newProject("P" + std::to_string(i % 7))
+                       .newTask("T" + std::to_string(i));
+      task.addTag("tag" + std::to_string(i % 13));
+      task.setComplete(i % 2 == 0);
+    }
+
+    WHEN("aggregating with one thread and with several threads") {
+
+      Aggregation aggregation("project,tag,completed");
+
+      THEN("the results are the same") {
+
+        Json result = aggregation.run(tlObj1, 1);
+        REQUIRE(result == aggregation.run(tlObj1, 4));
+        REQUIRE(result.size() == 7 * 13 * 2);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
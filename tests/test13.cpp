@@ -0,0 +1,124 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for searching project and
+// task identifiers, and for keeping the search index
+// up to date as projects and tasks change.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <string>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/todo.h"
+
+SCENARIO("Projects and tasks can be found by a word in their identifier",
+         "[search]") {
+
+  const std::string filePath = "./tests/testdatabase.json";
+
+  GIVEN("the test database") {
+
+    TodoList tlObj1{};
+    REQUIRE_NOTHROW(tlObj1.load(filePath));
+
+    WHEN("searching for a word in two task identifiers") {
+
+      MatchContainer matches = tlObj1.search("lab assignment");
+
+      THEN("both tasks are found, ignoring case") {
+
+        REQUIRE(matches.size() == 2);
+        REQUIRE(matches[0].project == "M02");
+        REQUIRE_FALSE(matches[0].isProject);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("searching for a word that shares trigrams with an identifier") {
+
+      THEN("nothing is found") {
+
+        REQUIRE(tlObj1.search("Assignment 2").empty());
+        REQUIRE(tlObj1.search("mentAssign").empty());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("searching for a word shorter than a trigram") {
+
+      MatchContainer matches = tlObj1.search("M1");
+
+      THEN("the identifiers are still checked") {
+
+        REQUIRE(matches.size() == 1);
+        REQUIRE(matches[0].project == "M118");
+        REQUIRE(matches[0].isProject);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("tasks and projects are created, renamed and deleted after the "
+         "first search") {
+
+      REQUIRE(tlObj1.search("Mobile").size() == 1);
+
+      tlObj1.getProject("M02").newTask("Mobile Lab");
+      String newIdent = "Lab Assignment 7";
+      tlObj1.getProject("M02").getTask("Lab Assignment 6").setIndent(newIdent);
+      tlObj1.getProject("M118").setIdent("Apps");
+      tlObj1.newProject("Mobile Apps");
+
+      THEN("the search results follow the changes") {
+
+        REQUIRE(tlObj1.search("Mobile").size() == 3);
+        REQUIRE(tlObj1.search("Assignment 6").empty());
+        REQUIRE(tlObj1.search("Assignment 7").size() == 1);
+
+        MatchContainer matches = tlObj1.search("Write Mobile");
+        REQUIRE(matches.size() == 1);
+        REQUIRE(matches[0].project == "Apps");
+
+        AND_WHEN("a project and a task are deleted") {
+
+          tlObj1.deleteProject("Apps");
+          tlObj1.getProject("M02").deleteTask("Mobile Lab");
+
+          THEN("they are no longer found") {
+
+            MatchContainer matches = tlObj1.search("Mobile");
+            REQUIRE(matches.size() == 1);
+            REQUIRE(matches[0].project == "Mobile Apps");
+
+          } // THEN
+
+        } // AND_WHEN
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("searching with the json action") {
+
+      Json result = App::searchResults(tlObj1, "assignment 1");
+
+      THEN("the matching tasks are returned by project") {
+
+        REQUIRE(result.size() == 1);
+        REQUIRE(result["M02"].size() == 1);
+        REQUIRE(result["M02"]["Lab Assignment 1"]["completed"] == true);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
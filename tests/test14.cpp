@@ -0,0 +1,208 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for completing identifiers
+// and tags from a prefix with the PrefixIndex and
+// Completions classes.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <fstream>
+#include <string>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/prefixindex.h"
+
+SCENARIO("A PrefixIndex returns the strings starting with a prefix",
+         "[complete]") {
+
+  GIVEN("a PrefixIndex over several blocks of strings") {
+
+    std::vector<std::string> strings;
+    for (int i = 0; i < 100; i++) {
+      strings.push_back("task " + std::to_string(i));
+    }
+    strings.push_back("apple");
+    strings.push_back("task 5");
+    PrefixIndex index{strings};
+
+    REQUIRE(index.size() == 101);
+
+    WHEN("completing a prefix shared by strings in different blocks") {
+
+      std::vector<std::string> matches = index.complete("task 5", 20);
+
+      THEN("every match is returned in sorted order") {
+
+        REQUIRE(matches.size() == 11);
+        REQUIRE(matches[0] == "task 5");
+        REQUIRE(matches[1] == "task 50");
+        REQUIRE(matches[10] == "task 59");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("completing with a limit") {
+
+      THEN("only the first matches are returned") {
+
+        REQUIRE(index.complete("task", 3) ==
+                std::vector<std::string>({"task 0", "task 1", "task 10"}));
+        REQUIRE(index.complete("", 1) == std::vector<std::string>({"apple"}));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("completing a prefix that matches nothing") {
+
+      THEN("nothing is returned") {
+
+        REQUIRE(index.complete("b", 10).empty());
+        REQUIRE(index.complete("zebra", 10).empty());
+        REQUIRE(index.complete("task 5a", 10).empty());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the index is copied from its serialised form") {
+
+      std::string bytes = index.serialised();
+      const char *cursor = bytes.data();
+      PrefixIndex copy;
+
+      THEN("it returns the same matches") {
+
+        REQUIRE(PrefixIndex::view(cursor, bytes.data() + bytes.size(), copy));
+        REQUIRE(cursor == bytes.data() + bytes.size());
+        REQUIRE(copy.complete("task 9", 20) == index.complete("task 9", 20));
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("Completions are saved next to the database and loaded without it",
+         "[complete]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a database and its saved completions") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{ \"M02\": { \"Lab Assignment 1\": { \"completed\": true, "
+        "\"dueDate\": \"2024-11-13\", \"tags\": [ \"uni\", \"c\", "
+        "\"programming\" ] }, \"Lab Assignment 6\": { \"completed\": false, "
+        "\"dueDate\": \"2024-11-23\", \"tags\": [ \"uni\", \"c++\", "
+        "\"programming\", \"standard library\" ] } }, \"M118\": { \"Write "
+        "Mobile App\": { \"completed\": true, \"dueDate\": \"2023-11-30\", "
+        "\"tags\": [ \"uni\", \"programming\", \"android\" ] } } }"));
+
+    TodoList tlObj1{};
+    REQUIRE_NOTHROW(tlObj1.load(filePath));
+
+    Completions built;
+    built.build(tlObj1);
+    REQUIRE_NOTHROW(built.save(filePath, tlObj1.getGeneration()));
+
+    WHEN("the completions are loaded") {
+
+      Completions loaded;
+
+      THEN("they complete projects, tasks and tags") {
+
+        REQUIRE(loaded.load(filePath));
+        REQUIRE(loaded.projectIdents("M", 10) ==
+                std::vector<std::string>({"M02", "M118"}));
+        REQUIRE(loaded.taskIdents("M02", "Lab", 10) ==
+                std::vector<std::string>({"Lab Assignment 1", "Lab Assignment 6"}));
+        REQUIRE(loaded.taskIdents("M118", "Lab", 10).empty());
+        REQUIRE(loaded.tagNames("c", 10) ==
+                std::vector<std::string>({"c", "c++"}));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the database is changed") {
+
+      REQUIRE_NOTHROW(writeFileContents(filePath, "{}"));
+
+      THEN("the saved completions are rejected") {
+
+        Completions loaded;
+        REQUIRE_FALSE(loaded.load(filePath));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a task is renamed to one of the same length and saved at once") {
+
+      Completions mapped;
+      REQUIRE(mapped.load(filePath));
+
+      TodoList tlObj2{};
+      REQUIRE_NOTHROW(tlObj2.load(filePath));
+      std::string renamed = "Lab Assignment 7";
+      tlObj2.getProject("M02").getTask("Lab Assignment 6").setIndent(renamed);
+      REQUIRE_NOTHROW(tlObj2.save(filePath));
+
+      THEN("the saved completions are rejected, and those mapped still work") {
+
+        Completions loaded;
+        REQUIRE_FALSE(loaded.load(filePath));
+        REQUIRE(mapped.taskIdents("M02", "Lab", 10) ==
+                std::vector<std::string>({"Lab Assignment 1", "Lab Assignment 6"}));
+
+        AND_WHEN("completions built before the save are saved") {
+
+          REQUIRE_NOTHROW(built.save(filePath, tlObj1.getGeneration()));
+
+          THEN("they are not written over the database") {
+
+            REQUIRE_FALSE(loaded.load(filePath));
+
+          } // THEN
+
+        } // AND_WHEN
+
+        AND_WHEN("completions built after the save are saved") {
+
+          Completions rebuilt;
+          rebuilt.build(tlObj2);
+          REQUIRE_NOTHROW(rebuilt.save(filePath, tlObj2.getGeneration()));
+
+          THEN("they are loaded") {
+
+            REQUIRE(loaded.load(filePath));
+            REQUIRE(loaded.taskIdents("M02", "Lab", 10) ==
+                    std::vector<std::string>({"Lab Assignment 1", "Lab Assignment 7"}));
+
+          } // THEN
+
+        } // AND_WHEN
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
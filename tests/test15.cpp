@@ -0,0 +1,364 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for serving commands from
+// a database held in memory with the Server class.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/filelock.h"
+#include "../src/server.h"
+#include "../src/todo.h"
+
+#ifndef _WIN32
+
+SCENARIO("A Server runs commands against the database it holds in memory",
+         "[server]") {
+
+  const std::string filePath = "./tests/testdatabaseserver.json";
+  {
+    std::ifstream source("./tests/testdatabase.json");
+    std::ofstream copy(filePath);
+    copy << source.rdbuf();
+  }
+
+  auto fileContents = [&filePath]() {
+    std::ifstream file(filePath);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+  };
+
+  GIVEN("a Server serving the database") {
+
+    const std::string original = fileContents();
+    int serverStatus = -1;
+    {
+      Server server(filePath);
+      std::thread thread([&]() { serverStatus = server.run(); });
+
+      CHECK_THROWS_AS(Server(filePath), std::runtime_error);
+
+      std::stringstream out, err;
+      int status = -1;
+
+      Argv create({"test", "--db", filePath.c_str(), "--action", "create",
+                   "--project", "Served", "--task", "Task 1", "--tag", "a,b"});
+      CHECK(Server::forward(filePath, create.argc(), create.argv(), out, err, status));
+      CHECK(status == 0);
+      CHECK(out.str().empty());
+
+      WHEN("more commands are forwarded to it") {
+
+        THEN("they see each other's changes before the database is saved") {
+
+          Argv json({"test", "--db", filePath.c_str(), "--action", "json",
+                     "--project", "Served", "--task", "Task 1"});
+          CHECK(Server::forward(filePath, json.argc(), json.argv(), out, err, status));
+          CHECK(status == 0);
+          CHECK(Json::parse(out.str())["tags"] == Json({"a", "b"}));
+          CHECK(fileContents() == original);
+
+        } // THEN
+
+        THEN("errors are returned with the exit code") {
+
+          Argv json({"test", "--db", filePath.c_str(), "--action", "json",
+                     "--project", "Missing"});
+          CHECK(Server::forward(filePath, json.argc(), json.argv(), out, err, status));
+          CHECK(status == 1);
+          CHECK(out.str().empty());
+          CHECK(err.str() == "Error: invalid project argument(s).\n");
+
+        } // THEN
+
+        THEN("the todo command forwards to it") {
+
+          Argv json({"test", "--db", filePath.c_str(), "--action", "json",
+                     "--project", "Served"});
+          std::stringstream buffer;
+          std::streambuf *original = std::cout.rdbuf(buffer.rdbuf());
+          status = App::run(json.argc(), json.argv());
+          std::cout.rdbuf(original);
+
+          CHECK(status == 0);
+          CHECK(Json::parse(buffer.str()).contains("Task 1"));
+
+        } // THEN
+
+      } // WHEN
+
+      server.stop();
+      thread.join();
+    }
+
+    THEN("the changes are saved when it stops") {
+
+      REQUIRE(serverStatus == 0);
+      TodoList tlObj;
+      tlObj.load(filePath);
+      REQUIRE(tlObj.getProject("Served").getTask("Task 1").containsTag("a"));
+
+      AND_THEN("commands are no longer forwarded") {
+
+        std::stringstream out, err;
+        int status = -1;
+        Argv json({"test", "--db", filePath.c_str(), "--action", "json"});
+        REQUIRE_FALSE(Server::forward(filePath, json.argc(), json.argv(), out, err, status));
+        REQUIRE(std::ifstream(Server::socketPath(filePath)).fail());
+
+      } // AND_THEN
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a Server with changes not yet saved when another process saves the database") {
+
+    int serverStatus = -1;
+    Server server(filePath);
+    std::thread thread([&]() { serverStatus = server.run(); });
+
+    std::stringstream out, err;
+    int status = -1;
+    Argv create({"test", "--db", filePath.c_str(), "--action", "create",
+                 "--project", "M02", "--task", "Lab Assignment 9", "--tag", "served"});
+    CHECK(Server::forward(filePath, create.argc(), create.argv(), out, err, status));
+    CHECK(status == 0);
+
+    WHEN("the changes still fit the database saved") {
+
+      TodoList tlObj;
+      tlObj.load(filePath);
+      tlObj.newProject("Other");
+      tlObj.save(filePath);
+
+      server.stop();
+      thread.join();
+
+      THEN("they are made again on top of it and saved") {
+
+        REQUIRE(serverStatus == 0);
+        TodoList saved;
+        saved.load(filePath);
+        REQUIRE(saved.containsProject("Other"));
+        REQUIRE(saved.getProject("M02").getTask("Lab Assignment 9").containsTag("served"));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the changes no longer fit the database saved") {
+
+      TodoList tlObj;
+      tlObj.load(filePath);
+      tlObj.deleteProject("M02");
+      tlObj.save(filePath);
+
+      // Stops on its own at the next save, without being asked to
+      thread.join();
+
+      THEN("the Server stops without saving over it") {
+
+        REQUIRE(serverStatus == 1);
+        TodoList saved;
+        saved.load(filePath);
+        REQUIRE_FALSE(saved.containsProject("M02"));
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("a Server whose save waits for the database to be unlocked") {
+
+    int serverStatus = -1;
+    Server server(filePath);
+    std::thread thread([&]() { serverStatus = server.run(); });
+
+    std::unique_ptr<FileLock> lock(new FileLock(filePath, FileLock::EXCLUSIVE));
+    std::stringstream out, err;
+    int status = -1;
+    Argv create({"test", "--db", filePath.c_str(), "--action", "create",
+                 "--project", "Locked", "--task", "Task 1"});
+    CHECK(Server::forward(filePath, create.argc(), create.argv(), out, err, status));
+    CHECK(status == 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(Server::FLUSH_DELAY_MS + 300));
+
+    WHEN("commands are sent while it is being saved") {
+
+      // Forwarded on another thread, so that a Server stuck saving cannot
+      // hold up the test for ever
+      std::atomic<bool> answered{false};
+      std::stringstream readOut;
+      std::thread reading([&]() {
+        std::stringstream readErr;
+        int readStatus = -1;
+        Argv json({"test", "--db", filePath.c_str(), "--action", "json",
+                   "--project", "Locked"});
+        Argv update({"test", "--db", filePath.c_str(), "--action", "create",
+                     "--project", "Locked", "--task", "Task 2"});
+        Server::forward(filePath, json.argc(), json.argv(), readOut, readErr, readStatus);
+        Server::forward(filePath, update.argc(), update.argv(), readOut, readErr, readStatus);
+        answered = true;
+      });
+      for (int i = 0; i < 100 && !answered; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      }
+      const bool servedWhileSaving = answered;
+      const bool savedWhileLocked = fileContents().find("Locked") != std::string::npos;
+      lock.reset();
+      reading.join();
+
+      server.stop();
+      thread.join();
+
+      THEN("they are answered, and the changes made meanwhile are saved too") {
+
+        REQUIRE(servedWhileSaving);
+        REQUIRE_FALSE(savedWhileLocked);
+        REQUIRE(Json::parse(readOut.str()).contains("Task 1"));
+        REQUIRE(serverStatus == 0);
+        TodoList saved;
+        saved.load(filePath);
+        REQUIRE(saved.getProject("Locked").containsTask("Task 1"));
+        REQUIRE(saved.getProject("Locked").containsTask("Task 2"));
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  std::remove(filePath.c_str());
+  std::remove((filePath + ".stats").c_str());
+  std::remove((filePath + ".journal").c_str());
+
+} // SCENARIO
+
+SCENARIO("A Session saves on another thread while it goes on being changed",
+         "[server]") {
+
+  const std::string sessionPath = "./tests/testdatabasesession.json";
+  {
+    std::ifstream source("./tests/testdatabase.json");
+    std::ofstream copy(sessionPath);
+    copy << source.rdbuf();
+  }
+
+  GIVEN("a save begun after one change, and another change made before it is written") {
+
+    Session session(sessionPath);
+    session.getTodoList().newProject("First");
+    session.setModified();
+    std::shared_ptr<TodoList::PendingSave> pending = session.beginSave();
+    REQUIRE(pending);
+    REQUIRE(session.isSaving());
+    REQUIRE(session.beginSave() == nullptr);
+    session.getTodoList().newProject("Second");
+    session.setModified();
+
+    WHEN("it is written on another thread") {
+
+      std::thread writer([&]() { pending->write(); });
+      writer.join();
+      session.finishSave();
+
+      THEN("only the change made before it began is saved, and the other is kept") {
+
+        REQUIRE_FALSE(session.isSaving());
+        REQUIRE(session.isModified());
+        TodoList saved;
+        saved.load(sessionPath);
+        REQUIRE(saved.containsProject("First"));
+        REQUIRE_FALSE(saved.containsProject("Second"));
+        REQUIRE(session.getTodoList().getChanges().size() == 1);
+
+        AND_THEN("the next save saves the other") {
+
+          session.save();
+          REQUIRE_FALSE(session.isModified());
+          TodoList later;
+          later.load(sessionPath);
+          REQUIRE(later.containsProject("Second"));
+
+        } // AND_THEN
+
+      } // THEN
+
+      THEN("undoing the change made meanwhile keeps the one saved") {
+
+        session.restore(0);
+        REQUIRE(session.getTodoList().containsProject("First"));
+        REQUIRE_FALSE(session.getTodoList().containsProject("Second"));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the change made meanwhile is undone before it is written") {
+
+      std::thread writer([&]() { pending->write(); });
+      session.restore(1);
+      writer.join();
+
+      THEN("the change saved is kept") {
+
+        REQUIRE_FALSE(session.isSaving());
+        REQUIRE(session.getTodoList().containsProject("First"));
+        REQUIRE_FALSE(session.getTodoList().containsProject("Second"));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("another process saves the database first") {
+
+      TodoList other;
+      other.load(sessionPath);
+      other.newProject("Other");
+      other.save(sessionPath);
+
+      pending->write();
+
+      THEN("taking the save fails, and reload makes both changes again on what it saved") {
+
+        REQUIRE_THROWS_AS(session.finishSave(), ConflictError);
+        REQUIRE(session.isModified());
+        session.reload();
+        REQUIRE(session.getTodoList().containsProject("Other"));
+        REQUIRE(session.getTodoList().containsProject("First"));
+        REQUIRE(session.getTodoList().containsProject("Second"));
+        session.save();
+        TodoList saved;
+        saved.load(sessionPath);
+        REQUIRE(saved.containsProject("Other"));
+        REQUIRE(saved.containsProject("Second"));
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  std::remove(sessionPath.c_str());
+  std::remove((sessionPath + ".stats").c_str());
+
+} // SCENARIO
+
+#endif // _WIN32
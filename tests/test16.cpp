@@ -0,0 +1,130 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for running many commands
+// against a database loaded once with App::batch.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../src/todo.h"
+
+SCENARIO("A command line is split into arguments", "[batch]") {
+
+  GIVEN("command lines with quotes and escapes") {
+
+    THEN("they are split like a shell would") {
+
+      REQUIRE(App::splitCommand("  --action json  ") ==
+              std::vector<std::string>({"--action", "json"}));
+      REQUIRE(App::splitCommand("--project \"Lab Work\" --task 'it''s'") ==
+              std::vector<std::string>({"--project", "Lab Work", "--task", "its"}));
+      REQUIRE(App::splitCommand("--task a\\ b --tag \"say \\\"hi\\\"\" ''") ==
+              std::vector<std::string>({"--task", "a b", "--tag", "say \"hi\"", ""}));
+      REQUIRE(App::splitCommand("").empty());
+      REQUIRE_THROWS_AS(App::splitCommand("--project 'M02"), std::invalid_argument);
+
+    } // THEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("A batch of commands runs against a database loaded once",
+         "[batch]") {
+
+  const std::string filePath = "./tests/testdatabasebatch.json";
+  {
+    std::ifstream source("./tests/testdatabase.json");
+    std::ofstream copy(filePath);
+    copy << source.rdbuf();
+  }
+
+  GIVEN("a batch creating, reading and failing to read tasks") {
+
+    std::stringstream in;
+    in << "# a comment\n"
+       << "--action create --project Batch --task 'Task 1' --tag a,b\n"
+       << "\n"
+       << "--action create --project Batch --task 'Task 2' --completed\n"
+       << "--action json --project Batch --task 'Task 1'\n"
+       << "--action json --project Missing\n";
+    std::stringstream out, err;
+    Session session(filePath);
+
+    WHEN("the batch is run") {
+
+      int status = App::batch(session, in, out, err);
+
+      THEN("each command reports its exit code on its own line") {
+
+        REQUIRE(status == 1);
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(out, line)) {
+          lines.push_back(line);
+        }
+        REQUIRE(lines.size() == 5);
+        REQUIRE(lines[0] == "# 2 exit 0");
+        REQUIRE(lines[1] == "# 4 exit 0");
+        REQUIRE(Json::parse(lines[2])["tags"] == Json({"a", "b"}));
+        REQUIRE(lines[3] == "# 5 exit 0");
+        REQUIRE(lines[4] == "# 6 exit 1");
+        REQUIRE(err.str() == "Error: invalid project argument(s).\n");
+
+      } // THEN
+
+      THEN("the changes are saved at the end") {
+
+        REQUIRE_FALSE(session.isModified());
+        TodoList tlObj;
+        tlObj.load(filePath);
+        REQUIRE(tlObj.getProject("Batch").size() == 2);
+        REQUIRE(tlObj.getProject("Batch").getTask("Task 2").isComplete());
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("a batch with a command that fails after changing the database") {
+
+    std::stringstream in;
+    in << "--action create --project Batch --task 'Task 1'\n"
+       << "--action create --project Failed --task 'Task 2' --tag a --due never\n"
+       << "--action update --project Batch --task 'Task 1' --completed\n";
+    std::stringstream out, err;
+    Session session(filePath);
+
+    WHEN("the batch is run") {
+
+      int status = App::batch(session, in, out, err);
+
+      THEN("the changes of the failed command are undone, and the others saved") {
+
+        REQUIRE(status == 1);
+        REQUIRE(err.str() == "Invalid date: never\n");
+        REQUIRE_FALSE(session.getTodoList().containsProject("Failed"));
+        TodoList tlObj;
+        tlObj.load(filePath);
+        REQUIRE_FALSE(tlObj.containsProject("Failed"));
+        REQUIRE(tlObj.getProject("Batch").getTask("Task 1").isComplete());
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  std::remove(filePath.c_str());
+  std::remove((filePath + ".stats").c_str());
+  std::remove((filePath + ".journal").c_str());
+
+} // SCENARIO
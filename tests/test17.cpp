@@ -0,0 +1,98 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for typing commands against
+// a database held in memory with App::repl.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../src/todo.h"
+
+SCENARIO("Commands typed into the REPL run against a database loaded once",
+         "[repl]") {
+
+  const std::string filePath = "./tests/testdatabaserepl.json";
+  {
+    std::ifstream source("./tests/testdatabase.json");
+    std::ofstream copy(filePath);
+    copy << source.rdbuf();
+  }
+
+  GIVEN("a REPL session") {
+
+    Session session(filePath);
+    std::stringstream out, err;
+
+    WHEN("a task is created and committed") {
+
+      std::stringstream in;
+      in << "--action create --project Repl --task 'Task 1'\n"
+         << "commit\n"
+         << "--action json --project Repl\n"
+         << "exit\n"
+         << "--action delete --project Repl\n";
+      int status = App::repl(session, in, out, err);
+
+      THEN("each command is followed by its exit code and latency") {
+
+        REQUIRE(status == 0);
+        REQUIRE(err.str().empty());
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(out, line)) {
+          lines.push_back(line);
+        }
+        REQUIRE(lines.size() == 5);
+        REQUIRE(lines[0].find("todo> # exit 0 in ") == 0);
+        REQUIRE(lines[1].find("todo> # saved in ") == 0);
+        REQUIRE(lines[2] == "todo> {\"Task 1\":{\"completed\":false,\"dueDate\":\"\"}}");
+        REQUIRE(lines[3].find("# exit 0 in ") == 0);
+        REQUIRE(lines[3].find(" ms") == lines[3].size() - 3);
+        REQUIRE(lines[4] == "todo> ");
+
+      } // THEN
+
+      THEN("the commands after exit are not run") {
+
+        TodoList tlObj;
+        tlObj.load(filePath);
+        REQUIRE(tlObj.containsProject("Repl"));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the input ends without an exit") {
+
+      std::stringstream in;
+      in << "--action delete --project M02\n"
+         << "--action json --project M02\n";
+      int status = App::repl(session, in, out, err);
+
+      THEN("the changes are saved") {
+
+        REQUIRE(status == 0);
+        REQUIRE(err.str() == "Error: invalid project argument(s).\n");
+        REQUIRE_FALSE(session.isModified());
+        TodoList tlObj;
+        tlObj.load(filePath);
+        REQUIRE_FALSE(tlObj.containsProject("M02"));
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  std::remove(filePath.c_str());
+  std::remove((filePath + ".stats").c_str());
+  std::remove((filePath + ".journal").c_str());
+
+} // SCENARIO
@@ -0,0 +1,105 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for detecting a database
+// saved by another process between a TodoList loading
+// and saving it.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "../src/filelock.h"
+#include "../src/todolist.h"
+
+SCENARIO("A TodoList does not overwrite changes saved since it was loaded",
+         "[lock]") {
+
+  const std::string filePath = "./tests/testdatabaselock.json";
+  {
+    std::ifstream source("./tests/testdatabase.json");
+    std::ofstream copy(filePath);
+    copy << source.rdbuf();
+  }
+
+  GIVEN("two TodoLists loaded from the same database") {
+
+    TodoList first, second;
+    REQUIRE_NOTHROW(first.load(filePath));
+    REQUIRE_NOTHROW(second.load(filePath));
+    const FileGeneration loaded = FileGeneration::of(filePath);
+
+    WHEN("both are changed and the first is saved") {
+
+      first.newProject("First");
+      second.newProject("Second");
+      REQUIRE_NOTHROW(first.save(filePath));
+
+      THEN("the database is replaced by a new generation") {
+
+        REQUIRE(FileGeneration::of(filePath) != loaded);
+        REQUIRE(std::ifstream(filePath + ".tmp").fail());
+
+      } // THEN
+
+      THEN("the second cannot be saved over it") {
+
+        REQUIRE_THROWS_AS(second.save(filePath), ConflictError);
+
+        TodoList tlObj;
+        tlObj.load(filePath);
+        REQUIRE(tlObj.containsProject("First"));
+        REQUIRE_FALSE(tlObj.containsProject("Second"));
+
+      } // THEN
+
+      THEN("the first can be saved again") {
+
+        first.newProject("Again");
+        REQUIRE_NOTHROW(first.save(filePath));
+
+      } // THEN
+
+      THEN("reloading the change onto the new generation can be saved") {
+
+        TodoList retry;
+        retry.load(filePath);
+        retry.newProject("Second");
+        REQUIRE_NOTHROW(retry.save(filePath));
+
+        TodoList tlObj;
+        tlObj.load(filePath);
+        REQUIRE(tlObj.containsProject("First"));
+        REQUIRE(tlObj.containsProject("Second"));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("readers hold shared locks") {
+
+      FileLock reader1(filePath, FileLock::SHARED);
+      FileLock reader2(filePath, FileLock::SHARED);
+
+      THEN("another reader can still load the database") {
+
+        TodoList tlObj;
+        REQUIRE_NOTHROW(tlObj.load(filePath));
+        REQUIRE(tlObj.size() == first.size());
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  std::remove(filePath.c_str());
+  std::remove((filePath + ".stats").c_str());
+  std::remove((filePath + ".journal").c_str());
+  std::remove((filePath + ".lock").c_str());
+
+} // SCENARIO
@@ -0,0 +1,198 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for reading Snapshots of a
+// TodoList while it is changed.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../src/jsonwriter.h"
+#include "../src/server.h"
+#include "../src/snapshot.h"
+#include "../src/todolist.h"
+
+SCENARIO("Snapshots of a TodoList are not affected by later changes",
+         "[snapshot]") {
+
+  const std::string filePath = "./tests/testdatabase.json";
+
+  GIVEN("a Snapshot of a loaded TodoList") {
+
+    TodoList tlObj;
+    REQUIRE_NOTHROW(tlObj.load(filePath));
+    std::shared_ptr<const Snapshot> before = tlObj.snapshot();
+
+    THEN("it holds the projects and prints as the TodoList does") {
+
+      REQUIRE(before->size() == tlObj.size());
+      REQUIRE(before->findProject("M02")->size() == 2);
+      REQUIRE(before->findProject("M02")->findTask("Lab Assignment 1") != nullptr);
+      REQUIRE(before->findProject("Missing") == nullptr);
+
+      std::ostringstream fromList, fromSnapshot;
+      {
+        JsonWriter writer(fromList);
+        tlObj.write(writer);
+      }
+      {
+        JsonWriter writer(fromSnapshot);
+        before->write(writer);
+      }
+      REQUIRE(fromSnapshot.str() == fromList.str());
+
+    } // THEN
+
+    WHEN("projects are changed, created and deleted") {
+
+      tlObj.getProject("M02").newTask("Lab Assignment 7");
+      tlObj.newProject("New Project").newTask("New Task");
+      REQUIRE(tlObj.deleteProject("M118"));
+      std::shared_ptr<const Snapshot> after = tlObj.snapshot();
+
+      THEN("the earlier Snapshot still sees the projects as they were") {
+
+        REQUIRE(before->findProject("M02")->size() == 2);
+        REQUIRE(before->findProject("M118") != nullptr);
+        REQUIRE(before->findProject("New Project") == nullptr);
+
+      } // THEN
+
+      THEN("a new Snapshot sees the changes") {
+
+        REQUIRE(after->findProject("M02")->size() == 3);
+        REQUIRE(after->findProject("New Project")->findTask("New Task") != nullptr);
+        REQUIRE(after->findProject("M118") == nullptr);
+
+      } // THEN
+
+      THEN("unchanged projects are shared between the Snapshots") {
+
+        for (const auto &project : before->getProjects()) {
+          if (project->getIdent() != "M02" && project->getIdent() != "M118") {
+            REQUIRE(after->findProject(project->getIdent()) == project.get());
+          }
+        }
+        REQUIRE(after->findProject("M02") != before->findProject("M02"));
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("a reader reading Snapshots while a writer changes the TodoList") {
+
+    TodoList tlObj;
+    tlObj.newProject("Left");
+    tlObj.newProject("Right");
+    std::shared_ptr<const Snapshot> published = tlObj.snapshot();
+
+    // The writer adds a task to both projects before each Snapshot, so a
+    // reader that sees them differ has seen half of a change
+    std::atomic<bool> writing{true};
+    std::thread writer([&]() {
+      for (int i = 0; i < 200; i++) {
+        const std::string task = "Task " + std::to_string(i);
+        tlObj.getProject("Left").newTask(task);
+        tlObj.getProject("Right").newTask(task);
+        std::atomic_store(&published, tlObj.snapshot());
+      }
+      writing = false;
+    });
+
+    bool consistent = true;
+    unsigned int reads = 0;
+    while (writing || reads == 0) {
+      std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&published);
+      const Project *left = snapshot->findProject("Left");
+      const Project *right = snapshot->findProject("Right");
+      std::ostringstream out;
+      {
+        JsonWriter writer(out);
+        snapshot->write(writer);
+      }
+      consistent = consistent && left->size() == right->size() &&
+                   Json::parse(out.str())["Left"].size() == left->size();
+      reads++;
+    }
+    writer.join();
+
+    THEN("every Snapshot it read was whole") {
+
+      REQUIRE(consistent);
+      REQUIRE(std::atomic_load(&published)->findProject("Left")->size() == 200);
+
+    } // THEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+#ifndef _WIN32
+
+SCENARIO("A Server answers json commands from Snapshots", "[snapshot][server]") {
+
+  const std::string snapshotPath = "./tests/testdatabasesnapshot.json";
+  {
+    std::ifstream source("./tests/testdatabase.json");
+    std::ofstream copy(snapshotPath);
+    copy << source.rdbuf();
+  }
+
+  GIVEN("reads and a change sent on one connection without waiting for the answers") {
+
+    int serverStatus = -1;
+    {
+      Server server(snapshotPath);
+      std::thread thread([&]() { serverStatus = server.run(); });
+
+      Server::Client client(snapshotPath);
+      REQUIRE(client.isConnected());
+      REQUIRE(client.send({"test", "--db", snapshotPath, "--action", "json"}));
+      REQUIRE(client.send({"test", "--db", snapshotPath, "--action", "create",
+                           "--project", "Later"}));
+      REQUIRE(client.send({"test", "--db", snapshotPath, "--action", "json",
+                           "--project", "Later"}));
+      REQUIRE(client.send({"test", "--db", snapshotPath, "--action", "json"}));
+
+      int status[4];
+      String out[4], err[4];
+      for (int i = 0; i < 4; i++) {
+        REQUIRE(client.receive(status[i], out[i], err[i]));
+      }
+
+      server.stop();
+      thread.join();
+
+      THEN("they are answered in order, each seeing the commands before it") {
+
+        REQUIRE(status[0] == 0);
+        REQUIRE_FALSE(Json::parse(out[0]).contains("Later"));
+        REQUIRE(status[1] == 0);
+        REQUIRE(status[2] == 0);
+        REQUIRE(out[2] == "{}\n");
+        REQUIRE(Json::parse(out[3]).contains("Later"));
+        REQUIRE(serverStatus == 0);
+
+      } // THEN
+
+    }
+
+  } // GIVEN
+
+  std::remove(snapshotPath.c_str());
+  std::remove((snapshotPath + ".stats").c_str());
+
+} // SCENARIO
+
+#endif // _WIN32
@@ -0,0 +1,239 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for splitting work across
+// the workers of a ThreadPool.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/threadpool.h"
+#include "../src/todolist.h"
+
+SCENARIO("A ThreadPool runs every index of a range exactly once",
+         "[threadpool]") {
+
+  for (unsigned int size : {1u, 2u, 4u}) {
+
+    GIVEN("a ThreadPool with " + std::to_string(size) + " workers") {
+
+      ThreadPool pool(size);
+      REQUIRE(pool.size() == size);
+
+      std::vector<std::atomic<int>> runs(1000);
+      for (auto &count : runs) {
+        count = 0;
+      }
+
+      WHEN("a range is split into pieces of one index") {
+
+        pool.parallelFor(0, runs.size(), [&](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; i++) {
+            runs[i]++;
+          }
+        });
+
+        THEN("every index is run once") {
+
+          bool once = true;
+          for (const auto &count : runs) {
+            once = once && count == 1;
+          }
+          REQUIRE(once);
+
+        } // THEN
+
+      } // WHEN
+
+      WHEN("a range is split into larger pieces") {
+
+        std::atomic<bool> tooLarge{false};
+        pool.parallelFor(100, runs.size(), [&](std::size_t begin, std::size_t end) {
+          if (end - begin > 64) {
+            tooLarge = true;
+          }
+          for (std::size_t i = begin; i < end; i++) {
+            runs[i]++;
+          }
+        }, 64);
+
+        THEN("only the indexes in the range are run, once each") {
+
+          bool once = true;
+          for (std::size_t i = 0; i < runs.size(); i++) {
+            once = once && runs[i] == (i < 100 ? 0 : 1);
+          }
+          REQUIRE(once);
+          if (size > 1) {
+            REQUIRE_FALSE(tooLarge);
+          }
+
+        } // THEN
+
+      } // WHEN
+
+      WHEN("parallelFor is called from inside a parallelFor") {
+
+        std::atomic<unsigned int> inner{0};
+        pool.parallelFor(0, 10, [&](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; i++) {
+            pool.parallelFor(0, 100, [&](std::size_t b, std::size_t e) {
+              inner += e - b;
+            });
+          }
+        });
+
+        THEN("the inner ranges are all run") {
+
+          REQUIRE(inner == 1000);
+
+        } // THEN
+
+      } // WHEN
+
+      // With one worker, the caller runs the whole range itself
+      if (size > 1) WHEN("the last piece runs on another worker for a while") {
+
+        std::atomic<bool> started{false};
+        const std::clock_t cpu = std::clock();
+        const auto wall = std::chrono::steady_clock::now();
+        pool.parallelFor(0, 2, [&](std::size_t begin, std::size_t) {
+          if (begin == 1) {
+            started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+          } else {
+            while (!started) {
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+          }
+        });
+        const double waited = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - wall).count();
+        const double used = static_cast<double>(std::clock() - cpu) / CLOCKS_PER_SEC;
+
+        THEN("the caller sleeps rather than spins until it is done") {
+
+          REQUIRE(waited >= 0.3);
+          REQUIRE(used < 0.1);
+
+        } // THEN
+
+      } // WHEN
+
+      WHEN("a piece throws an exception") {
+
+        std::atomic<unsigned int> ran{0};
+        auto fn = [&](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; i++) {
+            if (i == 500) {
+              throw std::runtime_error("piece failed");
+            }
+            ran++;
+          }
+        };
+
+        THEN("it is thrown to the caller once the other pieces are done") {
+
+          REQUIRE_THROWS_AS(pool.parallelFor(0, 1000, fn), std::runtime_error);
+          REQUIRE(ran < 1000);
+
+          // The pool can still be used afterwards
+          std::atomic<unsigned int> after{0};
+          pool.parallelFor(0, 100, [&](std::size_t begin, std::size_t end) {
+            after += end - begin;
+          });
+          REQUIRE(after == 100);
+
+        } // THEN
+
+      } // WHEN
+
+    } // GIVEN
+
+  } // for
+
+} // SCENARIO
+
+SCENARIO("A ThreadPool reports how much work its workers have done",
+         "[threadpool]") {
+
+  GIVEN("a ThreadPool and the projects of a TodoList") {
+
+    ThreadPool pool(3);
+    TodoList tlObj;
+    REQUIRE_NOTHROW(tlObj.load("./tests/testdatabase.json"));
+
+    WHEN("it runs over every project") {
+
+      std::atomic<unsigned int> tasks{0};
+      pool.parallelForEach(tlObj.getProjects(), [&](const Project &project) {
+        tasks += project.size();
+      });
+
+      THEN("every task is counted") {
+
+        unsigned int expected = 0;
+        for (const Project &project : tlObj.getProjects()) {
+          expected += project.size();
+        }
+        REQUIRE(tasks == expected);
+
+      } // THEN
+
+      THEN("the pieces run are counted per worker") {
+
+        const std::vector<WorkerStats> stats = pool.stats();
+        REQUIRE(stats.size() == 3);
+        unsigned long long total = 0;
+        for (const WorkerStats &worker : stats) {
+          total += worker.tasks;
+        }
+        REQUIRE(total > 0);
+        REQUIRE(stats[0].tasks > 0);
+
+        pool.resetStats();
+        for (const WorkerStats &worker : pool.stats()) {
+          REQUIRE(worker.tasks == 0);
+          REQUIRE(worker.steals == 0);
+          REQUIRE(worker.busyNanoseconds == 0);
+        }
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the workers are asked their index") {
+
+      std::vector<std::atomic<int>> seen(pool.size());
+      for (auto &count : seen) {
+        count = 0;
+      }
+      pool.parallelFor(0, 1000, [&](std::size_t, std::size_t) {
+        seen[pool.currentWorker()]++;
+      });
+
+      THEN("each is between 0 and the size of the pool") {
+
+        int total = 0;
+        for (const auto &count : seen) {
+          total += count;
+        }
+        REQUIRE(total > 0);
+        REQUIRE(pool.currentWorker() == 0);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
@@ -0,0 +1,216 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for writing files through a
+// WriteQueue, with each of its backends.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "../src/writequeue.h"
+
+// Returns the contents of a file
+static std::string readWritten(const std::string &fileName) {
+  std::ifstream file(fileName, std::ios::binary);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+SCENARIO("A WriteQueue writes files in the background", "[writequeue]") {
+
+  const std::string filePath = "./tests/testwritequeue.txt";
+  std::remove(filePath.c_str());
+
+  std::vector<WriteQueue::Backend> backends = {WriteQueue::BLOCKING};
+  if (WriteQueue(WriteQueue::AUTOMATIC).getBackend() == WriteQueue::URING) {
+    backends.push_back(WriteQueue::URING);
+  }
+
+  for (WriteQueue::Backend backend : backends) {
+
+    GIVEN(std::string("a WriteQueue using ") +
+          (backend == WriteQueue::URING ? "io_uring" : "blocking writes")) {
+
+      WriteQueue queue(backend);
+      REQUIRE(queue.getBackend() == backend);
+
+      WHEN("data is written at offsets and flushed") {
+
+        const int fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(fd >= 0);
+        WriteQueue::Ticket second = queue.write(fd, "world\n", 6, false);
+        WriteQueue::Ticket first = queue.write(fd, "hello ", 0, true);
+        REQUIRE_NOTHROW(queue.wait(first));
+        REQUIRE_NOTHROW(queue.wait(second));
+        close(fd);
+
+        THEN("the file holds the data, and the tickets are done") {
+
+          REQUIRE(readWritten(filePath) == "hello world\n");
+          REQUIRE(queue.done(first));
+          REQUIRE(queue.done(second));
+
+        } // THEN
+
+      } // WHEN
+
+      WHEN("more data is written than fits in the buffers at once") {
+
+        std::string data;
+        while (data.size() < 3 * WriteQueue::BUFFER_SIZE * WriteQueue::BUFFER_COUNT) {
+          data += "Lab Assignment " + std::to_string(data.size()) + "\n";
+        }
+        const int fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(fd >= 0);
+        REQUIRE_NOTHROW(queue.wait(queue.write(fd, data, 0, true)));
+        close(fd);
+
+        THEN("all of it is written in order") {
+
+          REQUIRE(readWritten(filePath) == data);
+
+        } // THEN
+
+      } // WHEN
+
+      WHEN("lines are appended without waiting for each") {
+
+        const int fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+        REQUIRE(fd >= 0);
+        std::string expected;
+        for (int i = 0; i < 200; i++) {
+          const std::string line = "{\"sequence\":" + std::to_string(i) + "}\n";
+          queue.write(fd, line, -1, i % 50 == 49);
+          expected += line;
+        }
+        REQUIRE_NOTHROW(queue.drain());
+        close(fd);
+
+        THEN("every line is in the file, in order") {
+
+          REQUIRE(readWritten(filePath) == expected);
+
+        } // THEN
+
+      } // WHEN
+
+      WHEN("a write is cut short by a socket that is read slowly") {
+
+        int sockets[2];
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+        int size = 4096;
+        setsockopt(sockets[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+        std::string data;
+        while (data.size() < 2 * WriteQueue::BUFFER_SIZE * WriteQueue::BUFFER_COUNT) {
+          data += "Lab Assignment " + std::to_string(data.size()) + "\n";
+        }
+        std::string received;
+        std::thread reader([&]() {
+          char buffer[1000];
+          ssize_t length;
+          while ((length = read(sockets[1], buffer, sizeof(buffer))) > 0) {
+            received.append(buffer, length);
+          }
+        });
+        CHECK_NOTHROW(queue.wait(queue.write(sockets[0], data, -1, false)));
+        shutdown(sockets[0], SHUT_WR);
+        reader.join();
+        close(sockets[0]);
+        close(sockets[1]);
+
+        THEN("the rest is written after it, in order") {
+
+          REQUIRE(received == data);
+
+        } // THEN
+
+      } // WHEN
+
+      WHEN("a write takes every operation the queue can have in flight, then flushes") {
+
+        WriteQueue small(backend, 2);
+        const std::string data(2 * WriteQueue::BUFFER_SIZE, 'x');
+        const int fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(fd >= 0);
+        REQUIRE_NOTHROW(small.wait(small.write(fd, data, 0, true)));
+        close(fd);
+
+        THEN("the fsync waits for a free operation rather than for ever") {
+
+          REQUIRE(readWritten(filePath) == data);
+
+        } // THEN
+
+      } // WHEN
+
+      WHEN("writes are queued and checked on without waiting") {
+
+        const int fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(fd >= 0);
+        std::vector<WriteQueue::Ticket> tickets;
+        std::string expected;
+        for (int i = 0; i < 20; i++) {
+          const std::string chunk(WriteQueue::BUFFER_SIZE / 2, static_cast<char>('a' + i));
+          tickets.push_back(queue.write(fd, chunk, expected.size(), i == 19));
+          expected += chunk;
+        }
+        bool done = false;
+        while (!done) {
+          done = true;
+          for (WriteQueue::Ticket ticket : tickets) {
+            done = done && queue.done(ticket);
+          }
+          std::this_thread::yield();
+        }
+        close(fd);
+
+        THEN("every ticket becomes done on its own, with its data written") {
+
+          REQUIRE(readWritten(filePath) == expected);
+          for (WriteQueue::Ticket ticket : tickets) {
+            REQUIRE_NOTHROW(queue.wait(ticket));
+          }
+
+        } // THEN
+
+      } // WHEN
+
+      WHEN("a write fails") {
+
+        std::ofstream(filePath) << "read only";
+        const int fd = open(filePath.c_str(), O_RDONLY);
+        REQUIRE(fd >= 0);
+        WriteQueue::Ticket ticket = queue.write(fd, "data", 0, true);
+
+        THEN("waiting for it throws, once") {
+
+          REQUIRE_THROWS_AS(queue.wait(ticket), std::runtime_error);
+          REQUIRE_NOTHROW(queue.wait(ticket));
+          REQUIRE_NOTHROW(queue.drain());
+          close(fd);
+          REQUIRE(readWritten(filePath) == "read only");
+
+        } // THEN
+
+      } // WHEN
+
+    } // GIVEN
+
+  } // for
+
+  std::remove(filePath.c_str());
+
+} // SCENARIO
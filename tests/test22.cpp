@@ -0,0 +1,154 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for a Server answering many
+// connections, and many commands on one connection, at
+// once.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/server.h"
+
+#ifndef _WIN32
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Connect to a socket without sending anything
+static int connectRaw(const std::string &path) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+SCENARIO("A Server keeps many commands in flight", "[server]") {
+
+  const std::string filePath = "./tests/testdatabasepipeline.json";
+  {
+    std::ifstream source("./tests/testdatabase.json");
+    std::ofstream copy(filePath);
+    copy << source.rdbuf();
+  }
+
+  GIVEN("a Server serving the database") {
+
+    Server server(filePath);
+    std::thread thread([&]() { server.run(); });
+
+    WHEN("a client sends many commands before reading any answer") {
+
+      Server::Client client(filePath);
+      CHECK(client.isConnected());
+      const int count = 500;
+      bool sent = true;
+      for (int i = 0; i < count; i++) {
+        sent = sent && client.send({"todo", "--db", filePath, "--action", "create",
+                                    "--project", "Pipelined", "--task",
+                                    "Task " + std::to_string(i)});
+      }
+      sent = sent && client.send({"todo", "--db", filePath, "--action", "json",
+                                  "--project", "Pipelined", "--task", "Task 499"});
+      sent = sent && client.send({"todo", "--db", filePath, "--action", "json",
+                                  "--project", "Missing"});
+
+      int status = -1, failed = 0;
+      std::string out, err;
+      for (int i = 0; i < count; i++) {
+        if (!client.receive(status, out, err) || status != 0) {
+          failed++;
+        }
+      }
+
+      THEN("every command is answered, in order") {
+
+        CHECK(sent);
+        CHECK(failed == 0);
+        CHECK(client.receive(status, out, err));
+        CHECK(status == 0);
+        CHECK(Json::parse(out)["completed"] == false);
+        CHECK(client.receive(status, out, err));
+        CHECK(status == 1);
+        CHECK(err == "Error: invalid project argument(s).\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a client stops half way through a request") {
+
+      const int stalled = connectRaw(Server::socketPath(filePath));
+      CHECK(stalled >= 0);
+      const unsigned int argc = 3;
+      CHECK(write(stalled, &argc, sizeof(argc)) == sizeof(argc));
+
+      THEN("other clients are still answered") {
+
+        Server::Client client(filePath);
+        int status = -1;
+        std::string out, err;
+        CHECK(client.send({"todo", "--db", filePath, "--action", "json", "--project", "M02"}));
+        CHECK(client.receive(status, out, err));
+        CHECK(status == 0);
+        CHECK(Json::parse(out).contains("Lab Assignment 1"));
+
+      } // THEN
+
+      close(stalled);
+
+    } // WHEN
+
+    WHEN("a client sends a malformed request") {
+
+      const int bad = connectRaw(Server::socketPath(filePath));
+      CHECK(bad >= 0);
+      const unsigned int argc = 0;
+      CHECK(write(bad, &argc, sizeof(argc)) == sizeof(argc));
+
+      THEN("its connection is closed and the Server carries on") {
+
+        char byte;
+        CHECK(read(bad, &byte, 1) == 0);
+
+        Server::Client client(filePath);
+        int status = -1;
+        std::string out, err;
+        CHECK(client.send({"todo", "--db", filePath, "--action", "json", "--project", "M02"}));
+        CHECK(client.receive(status, out, err));
+        CHECK(status == 0);
+
+      } // THEN
+
+      close(bad);
+
+    } // WHEN
+
+    server.stop();
+    thread.join();
+
+  } // GIVEN
+
+  std::remove(filePath.c_str());
+  std::remove((filePath + ".stats").c_str());
+  std::remove((filePath + ".journal").c_str());
+  std::remove((filePath + ".lock").c_str());
+
+} // SCENARIO
+
+#endif // _WIN32
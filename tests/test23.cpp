@@ -0,0 +1,383 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for recording the changes
+// made to a TodoList in the journal of its database,
+// and reading them back with the feed action.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/changefeed.h"
+#include "../src/filelock.h"
+#include "../src/todo.h"
+#include "../src/todolist.h"
+
+// Returns the changes in the journal of a database after a sequence number
+static std::vector<Json> readFeed(const std::string &filePath, unsigned long long since) {
+  std::stringstream out;
+  ChangeFeed::read(filePath, since, out);
+  std::vector<Json> changes;
+  std::string line;
+  while (std::getline(out, line)) {
+    changes.push_back(Json::parse(line));
+  }
+  return changes;
+}
+
+SCENARIO("The changes made to a TodoList are appended to its journal", "[feed]") {
+
+  const std::string filePath = "./tests/testdatabasefeed.json";
+  const std::string otherPath = "./tests/testdatabasefeedcopy.json";
+  {
+    std::ifstream source("./tests/testdatabase.json");
+    std::ofstream copy(filePath);
+    copy << source.rdbuf();
+  }
+  std::remove(ChangeFeed::journalPath(filePath).c_str());
+  std::remove(ChangeFeed::oldJournalPath(filePath).c_str());
+
+  GIVEN("a database nothing follows") {
+
+    TodoList tlObj;
+    REQUIRE_NOTHROW(tlObj.load(filePath));
+    tlObj.newProject("Unfollowed");
+    REQUIRE_NOTHROW(tlObj.save(filePath));
+
+    THEN("no journal is kept for it") {
+
+      REQUIRE(std::ifstream(ChangeFeed::journalPath(filePath)).fail());
+      REQUIRE(tlObj.getChanges().empty());
+      REQUIRE(tlObj.getSequence() == 0);
+      REQUIRE(readFeed(filePath, 0).empty());
+
+    } // THEN
+
+  } // GIVEN
+
+  ChangeFeed::start(filePath);
+
+  GIVEN("a TodoList loaded from a database") {
+
+    TodoList tlObj;
+    REQUIRE_NOTHROW(tlObj.load(filePath));
+    REQUIRE(tlObj.getChanges().empty());
+    REQUIRE(tlObj.getSequence() == 0);
+
+    WHEN("projects, tasks and tags are changed and it is saved") {
+
+      Project &project = tlObj.newProject("Feed");
+      Task &task = project.newTask("Task 1");
+      task.addTag("a");
+      task.setComplete(true);
+      task.setComplete(true);
+      Date due;
+      due.setDate(2026, 11, 12);
+      task.setDueDate(due);
+      task.deleteTag("a");
+      String renamed = "Task 2";
+      task.setIndent(renamed);
+      tlObj.getProject("M02").deleteTask("Lab Assignment 1");
+      tlObj.getProject("Feed").setIdent("Feed 2");
+      tlObj.deleteProject("M118");
+      REQUIRE(tlObj.getChanges().size() == 10);
+      REQUIRE_NOTHROW(tlObj.save(filePath));
+
+      THEN("each change is in the journal, numbered in order") {
+
+        const std::vector<Json> changes = readFeed(filePath, 0);
+        REQUIRE(changes.size() == 10);
+        for (unsigned int i = 0; i < changes.size(); i++) {
+          REQUIRE(changes[i]["seq"] == i + 1);
+        }
+        REQUIRE(changes[0]["op"] == "project.created");
+        REQUIRE(changes[1]["op"] == "task.created");
+        REQUIRE(changes[1]["task"] == "Task 1");
+        REQUIRE(changes[2]["op"] == "tag.added");
+        REQUIRE(changes[2]["tag"] == "a");
+        REQUIRE(changes[3]["op"] == "task.completed");
+        REQUIRE(changes[3]["completed"] == true);
+        REQUIRE(changes[4]["op"] == "task.due");
+        REQUIRE(changes[4]["due"] == "2026-11-12");
+        REQUIRE(changes[5]["op"] == "tag.removed");
+        REQUIRE(changes[6]["op"] == "task.renamed");
+        REQUIRE(changes[6]["to"] == "Task 2");
+        REQUIRE(changes[7]["op"] == "task.deleted");
+        REQUIRE(changes[7]["project"] == "M02");
+        REQUIRE(changes[8]["op"] == "project.renamed");
+        REQUIRE(changes[8]["to"] == "Feed 2");
+        REQUIRE(changes[9]["op"] == "project.deleted");
+        REQUIRE(changes[9]["project"] == "M118");
+
+        REQUIRE(tlObj.getChanges().empty());
+        REQUIRE(tlObj.getSequence() == 10);
+        REQUIRE(ChangeFeed::lastSequence(filePath) == 10);
+
+      } // THEN
+
+      THEN("a consumer can resume after the last change it saw") {
+
+        TodoList reloaded;
+        reloaded.load(filePath);
+        REQUIRE(reloaded.getSequence() == 10);
+        reloaded.newProject("Later");
+        reloaded.save(filePath);
+
+        REQUIRE(readFeed(filePath, 8).size() == 3);
+        const std::vector<Json> changes = readFeed(filePath, 10);
+        REQUIRE(changes.size() == 1);
+        REQUIRE(changes[0]["seq"] == 11);
+        REQUIRE(changes[0]["value"] == Json::object());
+
+      } // THEN
+
+      THEN("a line left unfinished in the journal is skipped") {
+
+        std::ofstream(ChangeFeed::journalPath(filePath), std::ios::app) << "{\"op\":\"tag";
+        REQUIRE(ChangeFeed::lastSequence(filePath) == 10);
+        tlObj.newProject("After");
+        tlObj.save(filePath);
+
+        const std::vector<Json> changes = readFeed(filePath, 10);
+        REQUIRE(changes.size() == 1);
+        REQUIRE(changes[0]["seq"] == 11);
+        REQUIRE(changes[0]["project"] == "After");
+
+      } // THEN
+
+      THEN("saving another database over it records a reset") {
+
+        TodoList other;
+        other.load("./tests/testdatabase.json");
+        other.save(filePath);
+
+        const std::vector<Json> changes = readFeed(filePath, 10);
+        REQUIRE(changes.size() == 1);
+        REQUIRE(changes[0]["op"] == "reset");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the journal is read while another process is saving") {
+
+      tlObj.newProject("Locked");
+      REQUIRE_NOTHROW(tlObj.save(filePath));
+      std::vector<Json> changes;
+      std::atomic<bool> done{false};
+      std::thread reader;
+      {
+        FileLock saving(filePath, FileLock::EXCLUSIVE);
+        reader = std::thread([&]() {
+          changes = readFeed(filePath, 0);
+          done = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        CHECK_FALSE(done);
+      }
+      reader.join();
+
+      THEN("it is read once the save is done") {
+
+        REQUIRE(done);
+        REQUIRE_FALSE(changes.empty());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the database cannot be replaced") {
+
+      tlObj.newProject("Unsaved");
+      std::remove(otherPath.c_str());
+      REQUIRE(mkdir(otherPath.c_str(), 0755) == 0);
+      ChangeFeed::start(otherPath);
+      REQUIRE_THROWS_AS(tlObj.save(otherPath), std::runtime_error);
+      rmdir(otherPath.c_str());
+
+      THEN("nothing is appended to its journal, and the changes are kept") {
+
+        REQUIRE(readFeed(otherPath, 0).empty());
+        REQUIRE(tlObj.getChanges().size() == 1);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("it is saved as a new database") {
+
+      tlObj.newProject("Copied");
+      std::remove(ChangeFeed::journalPath(otherPath).c_str());
+      REQUIRE_NOTHROW(tlObj.save(otherPath));
+
+      THEN("no journal is started for it") {
+
+        REQUIRE(std::ifstream(ChangeFeed::journalPath(otherPath)).fail());
+        REQUIRE(tlObj.getChanges().empty());
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("the todo command") {
+
+    auto runTodo = [](std::initializer_list<const char *> args) {
+      Argv argv(args);
+      std::stringstream buffer;
+      std::streambuf *original = std::cout.rdbuf(buffer.rdbuf());
+      App::run(argv.argc(), argv.argv());
+      std::cout.rdbuf(original);
+      return buffer.str();
+    };
+
+    runTodo({"test", "--db", filePath.c_str(), "--action", "create", "--project", "Feed",
+             "--task", "Task 1", "--tag", "x"});
+
+    WHEN("the feed action is run with a sequence number") {
+
+      const std::string output = runTodo({"test", "--db", filePath.c_str(), "--action",
+                                          "feed", "--since", "1"});
+
+      THEN("it prints the changes after it, one per line") {
+
+        std::istringstream lines(output);
+        std::string line;
+        std::vector<Json> changes;
+        while (std::getline(lines, line)) {
+          changes.push_back(Json::parse(line));
+        }
+        REQUIRE(changes.size() == 2);
+        REQUIRE(changes[0]["op"] == "task.created");
+        REQUIRE(changes[1]["op"] == "tag.added");
+        REQUIRE(changes[1]["seq"] == 3);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the feed action is run without one") {
+
+      Json snapshot = Json::parse(runTodo({"test", "--db", filePath.c_str(), "--action",
+                                           "feed"}));
+
+      THEN("it prints the database and the last sequence number together") {
+
+        REQUIRE(snapshot["seq"] == 3);
+        REQUIRE(snapshot["database"]["Feed"]["Task 1"]["tags"] == Json({"x"}));
+        REQUIRE(snapshot["database"].contains("M02"));
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("a journal of many changes") {
+
+    TodoList tlObj;
+    REQUIRE_NOTHROW(tlObj.load(filePath));
+    Task &task = tlObj.newProject("Many").newTask("Task 1");
+    for (unsigned int i = 0; i < 5000; i++) {
+      task.addTag("tag " + std::to_string(i));
+    }
+    REQUIRE_NOTHROW(tlObj.save(filePath));
+    std::ofstream(ChangeFeed::journalPath(filePath), std::ios::app) << "{\"op\":\"tag";
+    tlObj.getProject("Many").deleteTask("Task 1");
+    REQUIRE_NOTHROW(tlObj.save(filePath));
+
+    THEN("the changes after any of them are found without reading the rest") {
+
+      for (unsigned long long since : {0, 1, 2, 3, 1000, 2501, 4999, 5001, 5002, 5003}) {
+        INFO("since " << since);
+        const std::vector<Json> changes = readFeed(filePath, since);
+        REQUIRE(changes.size() == 5003 - std::min<unsigned long long>(since, 5003));
+        if (!changes.empty()) {
+          REQUIRE(changes.front()["seq"] == since + 1);
+          REQUIRE(changes.back()["op"] == "task.deleted");
+        }
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a journal that grows past its largest size") {
+
+    TodoList tlObj;
+    REQUIRE_NOTHROW(tlObj.load(filePath));
+    const std::string large(ChangeFeed::MAX_JOURNAL_SIZE, 'x');
+    tlObj.newProject("Large").newTask("Task 1").addTag(large);
+    REQUIRE_NOTHROW(tlObj.save(filePath));
+    tlObj.getProject("Large").newTask("Task 2");
+    REQUIRE_NOTHROW(tlObj.save(filePath));
+
+    THEN("the next save moves it aside and starts a new one") {
+
+      REQUIRE(ChangeFeed::lastSequence(filePath) == 4);
+      REQUIRE(tlObj.getSequence() == 4);
+      std::ifstream journal(ChangeFeed::journalPath(filePath));
+      std::string line;
+      REQUIRE(std::getline(journal, line));
+      REQUIRE(Json::parse(line)["seq"] == 4);
+      REQUIRE_FALSE(std::getline(journal, line));
+
+      AND_THEN("the changes in both can be read") {
+
+        std::vector<Json> changes = readFeed(filePath, 0);
+        REQUIRE(changes.size() == 4);
+        REQUIRE(changes[2]["tag"] == large);
+        REQUIRE(changes[3]["task"] == "Task 2");
+        REQUIRE(readFeed(filePath, 3).size() == 1);
+        REQUIRE(readFeed(filePath, 4).empty());
+
+      } // AND_THEN
+
+      AND_WHEN("it is moved aside again") {
+
+        tlObj.getProject("Large").getTask("Task 2").addTag(large);
+        REQUIRE_NOTHROW(tlObj.save(filePath));
+        tlObj.deleteProject("Large");
+        REQUIRE_NOTHROW(tlObj.save(filePath));
+
+        THEN("reading changes no longer kept prints a reset") {
+
+          std::vector<Json> changes = readFeed(filePath, 2);
+          REQUIRE(changes.size() == 1);
+          REQUIRE(changes[0]["op"] == "reset");
+          REQUIRE(changes[0]["seq"] == 6);
+          REQUIRE(readFeed(filePath, 3).size() == 3);
+
+        } // THEN
+
+      } // AND_WHEN
+
+    } // THEN
+
+  } // GIVEN
+
+  for (const std::string &path : {filePath, otherPath}) {
+    for (const char *suffix : {"", ".stats", ".journal", ".journal.old", ".lock", ".tmp"}) {
+      std::remove((path + suffix).c_str());
+    }
+  }
+
+} // SCENARIO
@@ -0,0 +1,230 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for keeping a copy of a
+// database up to date from its journal, with a Replica
+// and with a Server following the database.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "../src/replica.h"
+#include "../src/server.h"
+
+// Returns every project of a TodoList as JSON, to compare two of them
+static Json contents(const TodoList &tl) {
+  Json j = Json::object();
+  for (const Project &project : tl.getProjects()) {
+    j[project.getIdent()] = project.json();
+  }
+  return j;
+}
+
+SCENARIO("A Replica applies the changes saved to a database", "[replica]") {
+
+  const std::string filePath = "./tests/testdatabaseprimary.json";
+  {
+    std::ifstream source("./tests/testdatabase.json");
+    std::ofstream copy(filePath);
+    copy << source.rdbuf();
+  }
+  std::remove(ChangeFeed::journalPath(filePath).c_str());
+  std::remove(ChangeFeed::oldJournalPath(filePath).c_str());
+
+  GIVEN("a copy of a database followed by a Replica") {
+
+    TodoList primary;
+    primary.load(filePath);
+    TodoList copy;
+    copy.load(filePath);
+    Replica replica(filePath);
+    REQUIRE(replica.poll(copy) == 0);
+
+    WHEN("the database is changed and saved") {
+
+      Task &task = primary.newProject("Replicated").newTask("Task 1");
+      task.addTag("a");
+      task.addTag("b");
+      task.setComplete(true);
+      Date due;
+      due.setDate(2026, 12, 11);
+      task.setDueDate(due);
+      task.deleteTag("a");
+      String renamed = "Task 2";
+      task.setIndent(renamed);
+      primary.getProject("M02").deleteTask("Lab Assignment 1");
+      primary.deleteProject("M118");
+      primary.save(filePath);
+
+      THEN("the copy is brought up to date without being loaded again") {
+
+        REQUIRE(replica.poll(copy) == 10);
+        REQUIRE(contents(copy) == contents(primary));
+        REQUIRE(copy.getSequence() == 10);
+        REQUIRE(copy.getChanges().empty());
+        REQUIRE(replica.poll(copy) == 0);
+
+        const Json status = replica.status(copy);
+        REQUIRE(status["seq"] == 10);
+        REQUIRE(status["primary_seq"] == 10);
+        REQUIRE(status["behind"] == 0);
+        REQUIRE(status["reloads"] == 0);
+        REQUIRE(status["lag_ms"] >= 0);
+
+      } // THEN
+
+      THEN("the copy reports how far behind it is until it polls") {
+
+        REQUIRE(replica.status(copy)["behind"] == 10);
+
+      } // THEN
+
+      THEN("a line left unfinished in the journal is skipped") {
+
+        replica.poll(copy);
+        std::ofstream(ChangeFeed::journalPath(filePath), std::ios::app) << "{\"op\":\"tag";
+        REQUIRE(replica.poll(copy) == 0);
+        primary.getProject("Replicated").getTask("Task 2").addTag("c");
+        primary.save(filePath);
+
+        REQUIRE(replica.poll(copy) == 1);
+        REQUIRE(copy.getProject("Replicated").getTask("Task 2").containsTag("c"));
+        REQUIRE(replica.status(copy)["reloads"] == 0);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("its journal is moved aside between polls") {
+
+      primary.newProject("Large").newTask("Task 1").addTag(
+          std::string(ChangeFeed::MAX_JOURNAL_SIZE, 'x'));
+      primary.save(filePath);
+      primary.getProject("Large").newTask("Task 2");
+      primary.save(filePath);
+
+      THEN("the rest of the old journal is applied before the new one") {
+
+        REQUIRE(replica.poll(copy) == 4);
+        REQUIRE(contents(copy) == contents(primary));
+        REQUIRE(replica.status(copy)["reloads"] == 0);
+        primary.deleteProject("Large");
+        primary.save(filePath);
+        REQUIRE(replica.poll(copy) == 1);
+        REQUIRE_FALSE(copy.containsProject("Large"));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("another database is saved over it") {
+
+      primary.newProject("Before");
+      primary.save(filePath);
+      REQUIRE(replica.poll(copy) == 1);
+      TodoList other;
+      other.newProject("Only");
+      other.save(filePath);
+
+      THEN("the copy loads the database again") {
+
+        REQUIRE(replica.poll(copy) == 1);
+        REQUIRE(copy.size() == 1);
+        REQUIRE(copy.containsProject("Only"));
+        REQUIRE(replica.status(copy)["reloads"] == 1);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a change does not fit the copy") {
+
+      copy.deleteProject("M02");
+      primary.getProject("M02").newTask("Lab Assignment 9");
+      primary.save(filePath);
+
+      THEN("the copy loads the database again") {
+
+        REQUIRE(replica.poll(copy) == 1);
+        REQUIRE(contents(copy) == contents(primary));
+        REQUIRE(replica.status(copy)["reloads"] == 1);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+#ifndef _WIN32
+
+  GIVEN("a Server serving a copy of the database") {
+
+    const std::string copyPath = "./tests/testdatabasereplica.json";
+    Server server(copyPath, filePath);
+    std::thread thread([&]() { server.run(); });
+
+    auto run = [&](std::vector<std::string> arguments, std::string &out) {
+      Server::Client client(copyPath);
+      arguments.insert(arguments.begin(), {"todo", "--db", copyPath});
+      int status = -1;
+      std::string err;
+      CHECK(client.send(arguments));
+      CHECK(client.receive(status, out, err));
+      return status;
+    };
+
+    WHEN("the database is changed and saved") {
+
+      TodoList primary;
+      primary.load(filePath);
+      primary.newProject("Served").newTask("Task 1");
+      primary.save(filePath);
+      std::this_thread::sleep_for(std::chrono::milliseconds(3 * Server::FOLLOW_INTERVAL_MS));
+
+      THEN("the copy answers with the change") {
+
+        std::string out;
+        CHECK(run({"--action", "json", "--project", "Served"}, out) == 0);
+        CHECK(Json::parse(out).contains("Task 1"));
+        CHECK(run({"--action", "replication"}, out) == 0);
+        CHECK(Json::parse(out)["seq"] == 2);
+        CHECK(Json::parse(out)["behind"] == 0);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a change is sent to the copy") {
+
+      std::string out;
+      const int status = run({"--action", "create", "--project", "Refused"}, out);
+
+      THEN("it is refused") {
+
+        CHECK(status == 1);
+        TodoList primary;
+        primary.load(filePath);
+        CHECK_FALSE(primary.containsProject("Refused"));
+
+      } // THEN
+
+    } // WHEN
+
+    server.stop();
+    thread.join();
+
+  } // GIVEN
+
+#endif // _WIN32
+
+  for (const char *suffix : {"", ".stats", ".journal", ".journal.old", ".lock"}) {
+    std::remove((filePath + suffix).c_str());
+  }
+
+} // SCENARIO
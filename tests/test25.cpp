@@ -0,0 +1,293 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for printing a TodoList as
+// JSON with a JsonWriter, and for the json action that
+// uses it.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iterator>
+#include <string>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/changefeed.h"
+#include "../src/jsonwriter.h"
+#include "../src/todo.h"
+#include "../src/todolist.h"
+
+// Returns what a JsonWriter writes for a TodoList
+static std::string written(const TodoList &tl, JsonWriter::Style style) {
+  std::stringstream out;
+  {
+    JsonWriter writer(out, style);
+    tl.write(writer);
+  }
+  return out.str();
+}
+
+SCENARIO("A JsonWriter prints a TodoList as nlohmann::json would", "[json]") {
+
+  GIVEN("a TodoList with awkward identifiers and tags, in sorted order") {
+
+    TodoList tlObj;
+    tlObj.newProject("A \"quoted\" project");
+    Project &project = tlObj.newProject("B project\\with\\slashes");
+    Task &task = project.newTask("Line\nbreak\tand\x01 control");
+    task.addTag("tag with \"quotes\"");
+    task.addTag("\xc3\xa9t\xc3\xa9");
+    task.setComplete(true);
+    Date due;
+    due.setDate(2026, 3, 4);
+    task.setDueDate(due);
+    project.newTask("No tags");
+
+    THEN("the compact output is the same as dumping json()") {
+
+      REQUIRE(tlObj.json().is_object());
+      REQUIRE(written(tlObj, JsonWriter::COMPACT) == tlObj.json().dump());
+
+    } // THEN
+
+    THEN("the pretty output is the same as dumping json() with an indent of four") {
+
+      REQUIRE(written(tlObj, JsonWriter::PRETTY) == tlObj.json().dump(4));
+
+    } // THEN
+
+    THEN("an empty TodoList is an empty object") {
+
+      REQUIRE(written(TodoList(), JsonWriter::COMPACT) == "{}");
+      REQUIRE(written(TodoList(), JsonWriter::PRETTY) == "{}");
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a TodoList larger than the buffer of a JsonWriter") {
+
+    TodoList tlObj;
+    for (int p = 0; p < 20; p++) {
+      Project &project = tlObj.newProject("Project " + std::to_string(100 + p));
+      for (int t = 0; t < 100; t++) {
+        project.newTask("Task " + std::to_string(1000 + t)).addTag("tag");
+      }
+    }
+
+    THEN("it is printed whole") {
+
+      const std::string output = written(tlObj, JsonWriter::COMPACT);
+      REQUIRE(output.size() > JsonWriter::BUFFER_SIZE);
+      REQUIRE(Json::parse(output) == tlObj.json());
+
+    } // THEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("The json action prints the database as JSON", "[json]") {
+
+  const std::string filePath = "./tests/testdatabasewriter.json";
+  {
+    std::ifstream source("./tests/testdatabase.json");
+    std::ofstream copy(filePath);
+    copy << source.rdbuf();
+  }
+
+  auto runTodo = [&](std::initializer_list<const char *> args) {
+    Argv argv(args);
+    std::stringstream buffer;
+    std::streambuf *original = std::cout.rdbuf(buffer.rdbuf());
+    App::run(argv.argc(), argv.argv());
+    std::cout.rdbuf(original);
+    return buffer.str();
+  };
+
+  std::ifstream file(filePath);
+  const Json database = Json::parse(file);
+
+  GIVEN("the json action without a project argument") {
+
+    const std::string compact = runTodo({"test", "--db", filePath.c_str(), "--action", "json"});
+    const std::string pretty = runTodo({"test", "--db", filePath.c_str(), "--action", "json",
+                                        "--pretty"});
+
+    THEN("the database is printed once, as an object rather than a string") {
+
+      REQUIRE(compact == database.dump() + "\n");
+      REQUIRE(pretty == database.dump(4) + "\n");
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("the json action with a project or task argument") {
+
+    const std::string project = runTodo({"test", "--db", filePath.c_str(), "--action", "json",
+                                         "--project", "M02", "--pretty"});
+    const std::string task = runTodo({"test", "--db", filePath.c_str(), "--action", "json",
+                                      "--project", "M02", "--task", "Lab Assignment 1"});
+
+    THEN("only that project or task is printed") {
+
+      REQUIRE(project == database["M02"].dump(4) + "\n");
+      REQUIRE(task == database["M02"]["Lab Assignment 1"].dump() + "\n");
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a project whose tasks were not added in sorted order") {
+
+    {
+      std::ofstream unsorted(filePath);
+      unsorted << "{\"P\":{\"B\":{\"completed\":false,\"dueDate\":\"\"},"
+                  "\"A\":{\"completed\":true,\"dueDate\":\"\"}}}";
+    }
+    const std::string project = runTodo({"test", "--db", filePath.c_str(), "--action", "json",
+                                         "--project", "P"});
+
+    THEN("the json action prints its tasks sorted, as json() does") {
+
+      REQUIRE(project == "{\"A\":{\"completed\":true,\"dueDate\":\"\"},"
+                         "\"B\":{\"completed\":false,\"dueDate\":\"\"}}\n");
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("projects and tasks added out of order by a batch, which keeps them loaded") {
+
+    Session session(filePath);
+    std::stringstream in;
+    in << "--action create --project Z --task B\n"
+       << "--action create --project Z --task A\n"
+       << "--action create --project 'A new project' --task Only\n";
+    std::stringstream out, err;
+    REQUIRE(App::batch(session, in, out, err) == 0);
+    REQUIRE(session.isLoaded());
+
+    THEN("the json action prints the same in the batch as on its own") {
+
+      for (const bool pretty : {false, true}) {
+        std::stringstream command;
+        command << "--action json" << (pretty ? " --pretty" : "") << "\n";
+        std::stringstream printed;
+        REQUIRE(App::batch(session, command, printed, err) == 0);
+
+        const std::string alone =
+            pretty ? runTodo({"test", "--db", filePath.c_str(), "--action", "json", "--pretty"})
+                   : runTodo({"test", "--db", filePath.c_str(), "--action", "json"});
+        REQUIRE(printed.str() == alone + "# 1 exit 0\n");
+        REQUIRE(Json::parse(alone).dump(pretty ? 4 : -1) + "\n" == alone);
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  for (const char *suffix : {"", ".stats", ".journal", ".lock"}) {
+    std::remove((filePath + suffix).c_str());
+  }
+
+} // SCENARIO
+
+// Returns the contents of a file
+static std::string fileContents(const std::string &path) {
+  std::ifstream file(path);
+  return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+SCENARIO("Saving writes the database, counters and journal as nlohmann::json would",
+         "[json]") {
+
+  const std::string filePath = "./tests/testdatabasesaved.json";
+
+  GIVEN("a TodoList with awkward identifiers, not added in sorted order") {
+
+    std::remove(filePath.c_str());
+    TodoList tlObj;
+    REQUIRE_NOTHROW(tlObj.save(filePath));
+    ChangeFeed::start(filePath);
+
+    Project &project = tlObj.newProject("Z \"quoted\" project");
+    Task &task = project.newTask("Line\nbreak\tand\x01 control");
+    task.addTag("tag with \"quotes\"");
+    task.addTag("\xc3\xa9t\xc3\xa9");
+    Date due;
+    due.setDate(2026, 3, 4);
+    task.setDueDate(due);
+    project.newTask("A task").setComplete(true);
+    tlObj.newProject("B project\\with\\slashes");
+    tlObj.getProject("B project\\with\\slashes").setIdent("A project");
+    const std::vector<Json> changes = tlObj.getChanges().recorded();
+    REQUIRE_NOTHROW(tlObj.save(filePath));
+
+    THEN("the database is json() dumped, with its projects and tasks sorted") {
+
+      REQUIRE(fileContents(filePath) == tlObj.json().dump() + "\n");
+
+    } // THEN
+
+    THEN("the counters are those dumped from the Json of each project") {
+
+      const Json stats = Json::parse(fileContents(filePath + ".stats"));
+      REQUIRE(fileContents(filePath + ".stats") == stats.dump() + "\n");
+      REQUIRE(stats["database"] == TodoList::fileSignature(tlObj.getGeneration()));
+      REQUIRE(stats["projects"].size() == 2);
+      REQUIRE(stats["projects"][0][0] == "Z \"quoted\" project");
+      REQUIRE(stats["projects"][0][1] ==
+              tlObj.getProject("Z \"quoted\" project").getStats().json());
+
+    } // THEN
+
+    THEN("each change is journalled as it was recorded, numbered and timed") {
+
+      std::ifstream journal(ChangeFeed::journalPath(filePath));
+      std::string line;
+      for (std::size_t i = 0; i < changes.size(); i++) {
+        REQUIRE(std::getline(journal, line));
+        Json change = Json::parse(line);
+        REQUIRE(line == change.dump());
+        REQUIRE(change["seq"] == i + 1);
+        REQUIRE(change["time"].is_number_integer());
+        change.erase("seq");
+        change.erase("time");
+        REQUIRE(change == changes[i]);
+      }
+      REQUIRE_FALSE(std::getline(journal, line));
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("an empty TodoList") {
+
+    TodoList tlObj;
+    REQUIRE_NOTHROW(tlObj.save(filePath));
+
+    THEN("the database is an empty object") {
+
+      REQUIRE(fileContents(filePath) == "{}\n");
+      TodoList loaded;
+      REQUIRE_NOTHROW(loaded.load(filePath));
+      REQUIRE(loaded.size() == 0);
+
+    } // THEN
+
+  } // GIVEN
+
+  for (const char *suffix : {"", ".stats", ".journal", ".lock"}) {
+    std::remove((filePath + suffix).c_str());
+  }
+
+} // SCENARIO
@@ -0,0 +1,145 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for the str() functions of
+// Date, Task, Project and TodoList: that each works out
+// its length first and allocates its string once.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "../src/todolist.h"
+
+// Every allocation made by the program is counted
+static std::atomic<unsigned long> allocations(0);
+
+void *operator new(std::size_t size) {
+  allocations++;
+  if (void *p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+  std::free(p);
+}
+
+// Returns the number of allocations made by a function
+template <typename F> static unsigned long countAllocations(F fn) {
+  const unsigned long before = allocations;
+  fn();
+  return allocations - before;
+}
+
+SCENARIO("The str() functions allocate their string once", "[str]") {
+
+  GIVEN("a TodoList with long identifiers, tags and dates") {
+
+    TodoList tlObj;
+    for (int p = 0; p < 5; p++) {
+      Project &project = tlObj.newProject("A project with a long identifier " + std::to_string(p));
+      for (int t = 0; t < 20; t++) {
+        Task &task = project.newTask("A task with a long identifier " + std::to_string(t));
+        task.addTag("a tag long enough not to fit in a small string");
+        task.addTag("short");
+        task.setComplete(t % 2 == 0);
+        if (t % 3 == 0) {
+          Date due;
+          due.setDate(2026, 1 + t % 12, 1 + t);
+          task.setDueDate(due);
+        }
+      }
+    }
+    tlObj.newProject("An empty project with a long identifier");
+    const Project &project = tlObj.getProjects().front();
+    const Task &task = project.getTasks().front();
+
+    THEN("each length is worked out exactly") {
+
+      REQUIRE(tlObj.str().size() == tlObj.str().capacity());
+      REQUIRE(project.str().size() == project.strLength());
+      REQUIRE(task.str().size() == task.strLength());
+      REQUIRE(task.tagsString().size() == task.tagsStringLength());
+      REQUIRE(task.getDueDate().str().size() == task.getDueDate().strLength());
+
+    } // THEN
+
+    THEN("each string is allocated once") {
+
+      String s;
+      REQUIRE(countAllocations([&]() { s = tlObj.str(); }) == 1);
+      REQUIRE(countAllocations([&]() { s = project.str(); }) == 1);
+      REQUIRE(countAllocations([&]() { s = task.str(); }) == 1);
+      REQUIRE(countAllocations([&]() { s = task.tagsString(); }) == 1);
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("tasks, projects and TodoLists with nothing in them") {
+
+    Task task("Task");
+    Project project("Project");
+    TodoList tlObj;
+
+    THEN("they are printed as before, with empty brackets") {
+
+      REQUIRE(task.str() ==
+              "\"Task\":{\"completed\":false,\"dueDate\":\"\",\"tags\":[]}");
+      REQUIRE(project.str() == "\"ident\":\"Project\":{}");
+      REQUIRE(tlObj.str() == "{}");
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a task from the test database") {
+
+    Task task("Lab Assignment 1");
+    task.setComplete(true);
+    Date due;
+    due.setDate(2024, 10, 13);
+    task.setDueDate(due);
+    task.addTag("uni");
+    task.addTag("c");
+
+    THEN("it is printed as before") {
+
+      REQUIRE(task.str() == "\"Lab Assignment 1\":{\"completed\":true,\"dueDate\":"
+                            "\"2024-10-13\",\"tags\":[\"uni\",\"c\"]}");
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("dates with short and long years") {
+
+    Date early, late;
+    early.setDate(5, 1, 2);
+    late.setDate(12345, 11, 30);
+
+    THEN("years are padded to four digits, and months and days to two") {
+
+      REQUIRE(early.str() == "0005-01-02");
+      REQUIRE(early.strLength() == 10);
+      REQUIRE(late.str() == "12345-11-30");
+      REQUIRE(late.strLength() == 11);
+      REQUIRE(Date().str().empty());
+      REQUIRE(Date().strLength() == 0);
+
+    } // THEN
+
+  } // GIVEN
+
+} // SCENARIO
@@ -0,0 +1,195 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for exporting every task of
+// a database, from a TodoList or straight from the
+// file, and for the export action.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/exporter.h"
+#include "../src/todo.h"
+
+// Remembers the tasks handed to it
+class TaskList : public Exporter {
+public:
+  std::vector<std::pair<String, Task>> tasks;
+
+  void task(const String &project, const Task &task) override {
+    tasks.emplace_back(project, task);
+  }
+};
+
+// Returns the lines an NdjsonExporter prints for a database file
+static std::string exportFile(const std::string &filePath) {
+  std::stringstream out;
+  NdjsonExporter exporter(out);
+  exporter.exportFile(filePath);
+  exporter.finish();
+  return out.str();
+}
+
+SCENARIO("The tasks of a database are exported one at a time", "[export]") {
+
+  const std::string filePath = "./tests/testdatabaseexport.json";
+
+  GIVEN("a database with empty projects, a task without tags and unknown members") {
+
+    std::ofstream(filePath)
+        << "{\"Empty\":{},\"Old\":null,\"P \\\"1\\\"\":{\"A\":{\"completed\":true,"
+           "\"dueDate\":\"2026-12-13\",\"extra\":{\"nested\":[1,{\"x\":null}]},"
+           "\"tags\":[\"x\",\"y\"]},\"B\":{\"completed\":false,\"dueDate\":\"\"}}}";
+
+    WHEN("it is exported straight from the file") {
+
+      TaskList exported;
+      exported.exportFile(filePath);
+
+      THEN("every task is handed over with its project") {
+
+        REQUIRE(exported.tasks.size() == 2);
+        REQUIRE(exported.tasks[0].first == "P \"1\"");
+        REQUIRE(exported.tasks[0].second.getIdent() == "A");
+        REQUIRE(exported.tasks[0].second.isComplete());
+        REQUIRE(exported.tasks[0].second.getDueDate().str() == "2026-12-13");
+        REQUIRE(exported.tasks[0].second.getTags() == TagContainer({"x", "y"}));
+        REQUIRE(exported.tasks[1].second.getIdent() == "B");
+        REQUIRE_FALSE(exported.tasks[1].second.getDueDate().isInitialised());
+        REQUIRE(exported.tasks[1].second.getTags().empty());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("it is exported as NDJSON") {
+
+      const std::string output = exportFile(filePath);
+
+      THEN("each task is a line of its own") {
+
+        REQUIRE(output ==
+                "{\"project\":\"P \\\"1\\\"\",\"task\":\"A\",\"completed\":true,"
+                "\"dueDate\":\"2026-12-13\",\"tags\":[\"x\",\"y\"]}\n"
+                "{\"project\":\"P \\\"1\\\"\",\"task\":\"B\",\"completed\":false,"
+                "\"dueDate\":\"\",\"tags\":[]}\n");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("the test database") {
+
+    {
+      std::ifstream source("./tests/testdatabase.json");
+      std::ofstream copy(filePath);
+      copy << source.rdbuf();
+    }
+
+    THEN("exporting the file prints the same as exporting the loaded TodoList") {
+
+      TodoList tlObj;
+      tlObj.load(filePath);
+      std::stringstream out;
+      NdjsonExporter exporter(out);
+      exporter.exportTodoList(tlObj);
+      exporter.finish();
+
+      const std::string output = out.str();
+      REQUIRE(output == exportFile(filePath));
+      REQUIRE(std::count(output.begin(), output.end(), '\n') == 3);
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a database that is cut short after its first task") {
+
+    std::ofstream(filePath) << "{\"P\":{\"A\":{\"completed\":true},\"B\":{\"comp";
+
+    THEN("the first task is handed over before the error is found") {
+
+      TaskList exported;
+      REQUIRE_THROWS_AS(exported.exportFile(filePath), std::runtime_error);
+      REQUIRE(exported.tasks.size() == 1);
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a database whose members have the wrong types") {
+
+    THEN("it is not exported") {
+
+      for (const char *database : {"[]", "{\"P\":[]}", "{\"P\":{\"A\":\"x\"}}",
+                                   "{\"P\":{\"A\":{\"completed\":1}}}",
+                                   "{\"P\":{\"A\":{\"tags\":[true]}}}",
+                                   "{\"P\":{\"A\":{\"dueDate\":\"soon\"}}}"}) {
+        std::ofstream(filePath) << database;
+        TaskList exported;
+        REQUIRE_THROWS_AS(exported.exportFile(filePath), std::runtime_error);
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("the export action") {
+
+    {
+      std::ifstream source("./tests/testdatabase.json");
+      std::ofstream copy(filePath);
+      copy << source.rdbuf();
+    }
+
+    auto runTodo = [](std::initializer_list<const char *> args, int &status) {
+      Argv argv(args);
+      std::stringstream buffer, errors;
+      std::streambuf *original = std::cout.rdbuf(buffer.rdbuf());
+      std::streambuf *originalErr = std::cerr.rdbuf(errors.rdbuf());
+      status = App::run(argv.argc(), argv.argv());
+      std::cout.rdbuf(original);
+      std::cerr.rdbuf(originalErr);
+      return buffer.str();
+    };
+
+    THEN("it prints each task as NDJSON by default") {
+
+      int status = -1;
+      const std::string output = runTodo({"test", "--db", filePath.c_str(), "--action",
+                                          "export"}, status);
+      REQUIRE(status == 0);
+      REQUIRE(output == exportFile(filePath));
+
+    } // THEN
+
+    THEN("an unknown format is refused") {
+
+      int status = -1;
+      runTodo({"test", "--db", filePath.c_str(), "--action", "export", "--format", "xml"},
+              status);
+      REQUIRE(status == 1);
+
+    } // THEN
+
+  } // GIVEN
+
+  for (const char *suffix : {"", ".stats", ".lock"}) {
+    std::remove((filePath + suffix).c_str());
+  }
+
+} // SCENARIO
@@ -0,0 +1,206 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for writing FlatBuffers and
+// for exporting a database as an Arrow IPC file.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/exporter.h"
+#include "../src/flatbuffer.h"
+#include "../src/todo.h"
+
+// Returns the little-endian number of size bytes at a position of a buffer
+static std::uint64_t readNumber(const std::string &buffer, std::size_t position,
+                                unsigned int size) {
+  std::uint64_t value = 0;
+  for (unsigned int i = 0; i < size; i++) {
+    value |= std::uint64_t(static_cast<unsigned char>(buffer[position + i])) << (8 * i);
+  }
+  return value;
+}
+
+// Returns where a field of the table at a position of a FlatBuffer is, or 0
+// if it is left out
+static std::size_t fieldPosition(const std::string &buffer, std::size_t table,
+                                 unsigned int slot) {
+  const std::size_t vtable = table - static_cast<std::int32_t>(readNumber(buffer, table, 4));
+  if (4 + 2 * slot >= readNumber(buffer, vtable, 2)) {
+    return 0;
+  }
+  const std::size_t offset = readNumber(buffer, vtable + 4 + 2 * slot, 2);
+  return offset == 0 ? 0 : table + offset;
+}
+
+// Returns where the object an offset at a position of a FlatBuffer points to is
+static std::size_t follow(const std::string &buffer, std::size_t position) {
+  return position + readNumber(buffer, position, 4);
+}
+
+SCENARIO("FlatBuffers can be written", "[flatbuffer]") {
+
+  GIVEN("a table of scalars, a string and a vector of tables") {
+
+    std::shared_ptr<FlatObject> child = FlatObject::table();
+    child->scalar(0, 7, 1);
+    std::shared_ptr<FlatObject> root = FlatObject::table();
+    root->scalar(0, 0x1122, 2).offset(1, FlatObject::string("name"));
+    root->scalar(3, 0x0102030405060708, 8).offset(4, FlatObject::vector({child, child}));
+
+    const std::string buffer = FlatObject::build(root);
+
+    THEN("each field can be read back, aligned to its size") {
+
+      REQUIRE(buffer.size() % 8 == 0);
+      const std::size_t table = follow(buffer, 0);
+      REQUIRE(table % 4 == 0);
+
+      REQUIRE(readNumber(buffer, fieldPosition(buffer, table, 0), 2) == 0x1122);
+      REQUIRE(fieldPosition(buffer, table, 2) == 0);
+      REQUIRE(fieldPosition(buffer, table, 5) == 0);
+      const std::size_t big = fieldPosition(buffer, table, 3);
+      REQUIRE(big % 8 == 0);
+      REQUIRE(readNumber(buffer, big, 8) == 0x0102030405060708);
+
+      const std::size_t name = follow(buffer, fieldPosition(buffer, table, 1));
+      REQUIRE(readNumber(buffer, name, 4) == 4);
+      REQUIRE(buffer.substr(name + 4, 5) == std::string("name", 5));
+
+      const std::size_t vector = follow(buffer, fieldPosition(buffer, table, 4));
+      REQUIRE(readNumber(buffer, vector, 4) == 2);
+      for (unsigned int i = 0; i < 2; i++) {
+        const std::size_t element = follow(buffer, vector + 4 + 4 * i);
+        REQUIRE(readNumber(buffer, fieldPosition(buffer, element, 0), 1) == 7);
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a vector of structs with 8-byte members") {
+
+    std::string bytes;
+    FlatObject::appendLittleEndian(bytes, 42, 8);
+    std::shared_ptr<FlatObject> root = FlatObject::table();
+    root->scalar(0, 1, 1).offset(1, FlatObject::structs(bytes, 1, 8));
+
+    const std::string buffer = FlatObject::build(root);
+
+    THEN("the structs are aligned to 8 bytes") {
+
+      const std::size_t structs = follow(buffer, fieldPosition(buffer, follow(buffer, 0), 1));
+      REQUIRE(readNumber(buffer, structs, 4) == 1);
+      REQUIRE((structs + 4) % 8 == 0);
+      REQUIRE(readNumber(buffer, structs + 4, 8) == 42);
+
+    } // THEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("A database can be exported as an Arrow IPC file", "[export]") {
+
+  const std::string filePath = "./tests/testdatabasearrow.json";
+
+  GIVEN("a database with a due date, a task without one and repeated tags") {
+
+    std::ofstream(filePath)
+        << "{\"P\":{\"A\":{\"completed\":true,\"dueDate\":\"2024-10-13\",\"tags\":[\"x\",\"y\"]},"
+           "\"B\":{\"completed\":false,\"dueDate\":\"\",\"tags\":[\"y\"]}},"
+           "\"Q\":{\"C\":{\"completed\":false,\"dueDate\":\"1969-12-31\",\"tags\":[]}}}";
+
+    WHEN("it is exported") {
+
+      std::stringstream out;
+      ArrowExporter exporter(out);
+      exporter.exportFile(filePath);
+      exporter.finish();
+      const std::string file = out.str();
+
+      THEN("the file starts and ends with the magic string around its footer") {
+
+        REQUIRE(file.size() % 8 == 2);
+        REQUIRE(file.substr(0, 8) == std::string("ARROW1\0\0", 8));
+        REQUIRE(file.substr(file.size() - 6) == "ARROW1");
+        const std::size_t footerLength = readNumber(file, file.size() - 10, 4);
+        const std::size_t footer = file.size() - 10 - footerLength;
+        REQUIRE(footer % 8 == 0);
+        REQUIRE(readNumber(file, footer - 8, 8) == 0x00000000ffffffff);
+
+        const std::string metadata = file.substr(footer, footerLength);
+        const std::size_t table = follow(metadata, 0);
+        const std::size_t dictionaries = follow(metadata, fieldPosition(metadata, table, 2));
+        const std::size_t records = follow(metadata, fieldPosition(metadata, table, 3));
+        REQUIRE(readNumber(metadata, dictionaries, 4) == 2);
+        REQUIRE(readNumber(metadata, records, 4) == 1);
+
+        // Each block is the offset of a message, the length of its metadata
+        // and the length of its body
+        for (const std::size_t block : {dictionaries + 4, dictionaries + 28, records + 4}) {
+          const std::size_t offset = readNumber(metadata, block, 8);
+          const std::size_t metadataLength = readNumber(metadata, block + 8, 4);
+          REQUIRE(offset % 8 == 0);
+          REQUIRE(readNumber(file, offset, 4) == 0xffffffff);
+          REQUIRE(readNumber(file, offset + 4, 4) + 8 == metadataLength);
+        }
+
+      } // THEN
+
+      THEN("the dictionaries hold each identifier once") {
+
+        REQUIRE(file.find("PQ") != std::string::npos);
+        REQUIRE(file.find("xy") != std::string::npos);
+        REQUIRE(file.find("ABC") != std::string::npos);
+
+      } // THEN
+
+      THEN("due dates are counted in days from 1970-01-01") {
+
+        std::string days;
+        FlatObject::appendLittleEndian(days, 20009, 4);
+        FlatObject::appendLittleEndian(days, 0, 4);
+        FlatObject::appendLittleEndian(days, 0xffffffff, 4);
+        REQUIRE(file.find(days) != std::string::npos);
+
+      } // THEN
+
+    } // WHEN
+
+    THEN("the export action writes the same file with the arrow format") {
+
+      Argv argv({"test", "--db", filePath.c_str(), "--action", "export", "--format", "arrow"});
+      std::stringstream buffer;
+      std::streambuf *original = std::cout.rdbuf(buffer.rdbuf());
+      const int status = App::run(argv.argc(), argv.argv());
+      std::cout.rdbuf(original);
+
+      std::stringstream out;
+      ArrowExporter exporter(out);
+      exporter.exportFile(filePath);
+      exporter.finish();
+
+      REQUIRE(status == 0);
+      REQUIRE(buffer.str() == out.str());
+
+    } // THEN
+
+  } // GIVEN
+
+  for (const char *suffix : {"", ".stats", ".lock"}) {
+    std::remove((filePath + suffix).c_str());
+  }
+
+} // SCENARIO
@@ -0,0 +1,173 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for escaping strings in JSON
+// output, with each escaper the CPU supports, and for
+// the str() functions escaping identifiers and tags.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "../src/jsonwriter.h"
+#include "../src/todolist.h"
+
+// Returns a string escaped by nlohmann::json, without its quotes
+static std::string dumped(const std::string &s) {
+  const std::string quoted = Json(s).dump();
+  return quoted.substr(1, quoted.size() - 2);
+}
+
+SCENARIO("Strings are escaped as nlohmann::json escapes them", "[escape]") {
+
+  const Simd::Level original = JsonWriter::getEscaper();
+
+  GIVEN("strings of every length up to 100 with a byte to escape at each position") {
+
+    THEN("every escaper the CPU supports escapes them the same") {
+
+      for (const Simd::Level escaper : {Simd::SCALAR, Simd::SSE2, Simd::AVX2}) {
+        if (!JsonWriter::setEscaper(escaper)) {
+          continue;
+        }
+        INFO("escaper " << Simd::name(escaper));
+        for (const char special : {'"', '\\', '\n', '\x01', '\x1f', '\x7f', ' '}) {
+          for (std::size_t length = 1; length <= 100; length++) {
+            for (std::size_t at = 0; at < length; at++) {
+              std::string s(length, 'a');
+              s[at] = special;
+              s[length - 1] = at % 3 == 0 ? '\t' : 'z';
+              std::string escaped;
+              JsonWriter::appendEscaped(escaped, s);
+              REQUIRE(escaped == dumped(s));
+              REQUIRE(JsonWriter::escapedLength(s) == escaped.size());
+            }
+          }
+        }
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("strings without anything to escape, or with multi-byte characters") {
+
+    THEN("they are copied as they are") {
+
+      for (const std::string &s : {std::string(), std::string(64, 'x'),
+                                  std::string("caf\xc3\xa9 \xe2\x82\xac")}) {
+        std::string escaped;
+        JsonWriter::appendEscaped(escaped, s);
+        REQUIRE(escaped == s);
+        REQUIRE(JsonWriter::escapedLength(s) == s.size());
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("strings with multi-byte characters, valid or not, at each position") {
+
+    // Returns what Json::dump or appendEscaped threw, or the string escaped
+    auto escapeDumped = [](const std::string &s) {
+      try {
+        return dumped(s);
+      } catch (const Json::type_error &e) {
+        return std::string(e.what());
+      }
+    };
+    auto escapeWritten = [](const std::string &s) {
+      try {
+        std::string escaped;
+        JsonWriter::appendEscaped(escaped, s);
+        return escaped;
+      } catch (const Json::type_error &e) {
+        return std::string(e.what());
+      }
+    };
+
+    THEN("every escaper copies the valid ones and throws as Json::dump does") {
+
+      for (const Simd::Level escaper : {Simd::SCALAR, Simd::SSE2, Simd::AVX2}) {
+        if (!JsonWriter::setEscaper(escaper)) {
+          continue;
+        }
+        INFO("escaper " << Simd::name(escaper));
+        for (const std::string &character : {
+                 std::string("\xc3\xa9"), std::string("\xf0\x9f\x98\x80"), std::string("\xff"),
+                 std::string("\xc3("), std::string("\xe0\x80\x80"), std::string("\xed\xa0\x80"),
+                 std::string("\xc0\xaf"), std::string("\xf4\x90\x80\x80"), std::string("\x80")}) {
+          for (std::size_t length = 1; length <= 40; length++) {
+            for (std::size_t at = 0; at <= length; at++) {
+              std::string s(length, 'a');
+              s.insert(at, character);
+              INFO("string " << s);
+              REQUIRE(escapeWritten(s) == escapeDumped(s));
+            }
+          }
+        }
+        for (const std::string &s : {std::string("\xc3"), std::string("abc\xe2\x82"),
+                                    std::string(40, 'a') + "\xf0\x9f\x98"}) {
+          std::string escaped;
+          REQUIRE_THROWS_AS(JsonWriter::appendEscaped(escaped, s), Json::type_error);
+          REQUIRE(escapeWritten(s) == escapeDumped(s));
+        }
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a TodoList with a project whose identifier is not valid UTF-8") {
+
+    const std::string filePath = "./tests/testdatabaseutf8.json";
+    {
+      std::ofstream file(filePath);
+      file << "{}\n";
+    }
+    TodoList tlObj;
+    tlObj.newProject("bad \xff name");
+
+    THEN("saving it throws as Json::dump does, and leaves the database as it was") {
+
+      REQUIRE_THROWS_AS(tlObj.save(filePath), Json::type_error);
+      std::ifstream file(filePath);
+      const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+      REQUIRE(content == "{}\n");
+
+    } // THEN
+
+    std::remove(filePath.c_str());
+    std::remove((filePath + ".lock").c_str());
+
+  } // GIVEN
+
+  GIVEN("a task and a project whose identifiers and tags have quotes in") {
+
+    Project project("The \"big\" project");
+    Task &task = project.newTask("Read \\ write");
+    task.addTag("a \"quoted\" tag");
+    task.addTag("line\nbreak");
+
+    THEN("their str() is valid JSON with the strings as they were") {
+
+      const Json parsed = Json::parse("{" + task.str() + "}");
+      REQUIRE(parsed["Read \\ write"]["tags"][0] == "a \"quoted\" tag");
+      REQUIRE(parsed["Read \\ write"]["tags"][1] == "line\nbreak");
+      REQUIRE(Json::parse(task.tagsString()) == Json({"a \"quoted\" tag", "line\nbreak"}));
+      REQUIRE(project.str().find("The \\\"big\\\" project") != std::string::npos);
+      REQUIRE(task.str().size() == task.strLength());
+      REQUIRE(project.str().size() == project.strLength());
+
+    } // THEN
+
+  } // GIVEN
+
+  JsonWriter::setEscaper(original);
+
+} // SCENARIO
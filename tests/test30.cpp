@@ -0,0 +1,233 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for the TodoParser: that
+// every indexer indexes text as a byte-at-a-time scan
+// does, that databases are read as nlohmann::json reads
+// them, and that anything else is left to nlohmann.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/todolist.h"
+#include "../src/todoparser.h"
+
+// Returns what the index of a text should be, reading it a byte at a time,
+// or false if a string is not closed or has a control character in. As in
+// simdjson, a backslash escapes the byte after it even outside a string,
+// where it is never valid.
+static bool referenceIndex(const std::string &text, std::vector<std::uint32_t> &indexes) {
+  indexes.clear();
+  bool inString = false;
+  bool escape = false;
+  bool inOther = false;
+  for (std::size_t i = 0; i < text.size(); i++) {
+    const unsigned char c = static_cast<unsigned char>(text[i]);
+    const bool quote = c == '"' && !escape;
+    escape = c == '\\' && !escape;
+    if (inString) {
+      if (c < 0x20) {
+        return false;
+      }
+      if (quote) {
+        indexes.push_back(i);
+        inString = false;
+      }
+      continue;
+    }
+    const bool structural = c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+    const bool whitespace = c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    if (quote) {
+      indexes.push_back(i);
+      inString = true;
+    } else if (structural) {
+      indexes.push_back(i);
+    } else if (!whitespace && !inOther) {
+      indexes.push_back(i);
+    }
+    inOther = !quote && !structural && !whitespace;
+  }
+  return !inString;
+}
+
+// Returns a TodoList's JSON after loading a database written as text
+static Json loaded(const std::string &filePath, const std::string &text) {
+  std::ofstream(filePath, std::ios::binary) << text;
+  TodoList tlObj;
+  tlObj.load(filePath);
+  return tlObj.json();
+}
+
+SCENARIO("Every indexer indexes text as a byte-at-a-time scan does", "[parser]") {
+
+  const Simd::Level original = TodoParser::getIndexer();
+
+  GIVEN("random text made of quotes, runs of backslashes, structural characters and words") {
+
+    std::mt19937 random(42);
+    const char *pieces[] = {"\"", "\\", "\\\\", "\\\\\\", "\\\"", "{", "}", "[", "]", ":",
+                            ",", " ", "\n", "true", "ab", "\xc3\xa9", "\x01"};
+    std::vector<std::string> texts;
+    for (unsigned int n = 0; n < 2000; n++) {
+      std::string text;
+      const std::size_t length = random() % 300;
+      while (text.size() < length) {
+        text += pieces[random() % (sizeof(pieces) / sizeof(pieces[0]))];
+      }
+      texts.push_back(text);
+    }
+
+    THEN("the indexes, and whether the text could be indexed, are the same") {
+
+      for (const Simd::Level level : {Simd::SCALAR, Simd::SSE2, Simd::AVX2}) {
+        if (!TodoParser::setIndexer(level)) {
+          continue;
+        }
+        INFO("indexer " << Simd::name(level));
+        for (const std::string &text : texts) {
+          INFO("text " << text);
+          std::vector<std::uint32_t> expected, indexes;
+          const bool valid = referenceIndex(text, expected);
+          REQUIRE(TodoParser::index(text, indexes) == valid);
+          if (valid) {
+            REQUIRE(indexes == expected);
+          }
+        }
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  TodoParser::setIndexer(original);
+
+} // SCENARIO
+
+SCENARIO("Databases are read by the TodoParser as nlohmann::json reads them", "[parser]") {
+
+  const std::string filePath = "./tests/testdatabaseparser.json";
+
+  GIVEN("random databases with escapes, unicode and long identifiers") {
+
+    std::mt19937 random(7);
+    auto identifier = [&random]() {
+      const char *pieces[] = {"a", "Lab ", "\"", "\\", "/", "\n", "\t", "\x01", "\xc3\xa9",
+                              "\xf0\x9f\x98\x80", "{}", "[]", ":", ","};
+      std::string s;
+      const unsigned int length = 1 + random() % 12;
+      for (unsigned int i = 0; i < length; i++) {
+        s += pieces[random() % (sizeof(pieces) / sizeof(pieces[0]))];
+      }
+      return s;
+    };
+
+    THEN("loading each gives the database, compact or indented") {
+
+      for (unsigned int n = 0; n < 50; n++) {
+        Json database = Json::object();
+        const unsigned int projects = random() % 5;
+        for (unsigned int p = 0; p < projects; p++) {
+          Json &project = database[identifier()] = Json::object();
+          const unsigned int tasks = random() % 5;
+          for (unsigned int t = 0; t < tasks; t++) {
+            Json tags = Json::array();
+            for (unsigned int i = 0; i < 1 + random() % 3; i++) {
+              tags.push_back(identifier() + std::to_string(i));
+            }
+            project[identifier()] = {{"completed", random() % 2 == 0},
+                                     {"dueDate", random() % 2 ? "2024-10-13" : ""},
+                                     {"tags", tags}};
+          }
+        }
+        REQUIRE(loaded(filePath, database.dump()) == database);
+        REQUIRE(loaded(filePath, database.dump(2)) == database);
+
+        std::vector<TodoParser::ParsedProject> parsed;
+        REQUIRE(TodoParser::parse(database.dump(), parsed));
+        REQUIRE(parsed.size() == database.size());
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("databases with escaped characters, out of order and repeated identifiers") {
+
+    THEN("they are read as nlohmann::json reads them") {
+
+      for (const std::string text :
+           {"{\"P\\u00e9\\/\":{\"T\\ud83d\\ude00\":{\"completed\":true,\"dueDate\":\"\","
+            "\"tags\":[\"\\u0041\\n\"]}}}",
+            "{\"Q\":{\"B\":{\"completed\":true},\"A\":{\"completed\":false}},\"P\":{}}",
+            "{\"P\":{\"A\":{\"completed\":true}},\"P\":{\"B\":{\"tags\":[\"x\"]}}}",
+            "{\"P\":{\"A\":{\"tags\":[\"x\"],\"tags\":[\"y\"],\"completed\":true,"
+            "\"completed\":false}}}",
+            " \r\n\t{ } "}) {
+        std::vector<TodoParser::ParsedProject> parsed;
+        REQUIRE(TodoParser::parse(text, parsed));
+
+        const Json database = Json::parse(text);
+        Json expected = Json::object();
+        for (auto &project : database.items()) {
+          expected[project.key()] = Json::object();
+          for (auto &task : project.value().items()) {
+            Task t(task.key());
+            if (task.value().contains("completed")) {
+              t.setComplete(task.value().at("completed"));
+            }
+            for (auto &tag : task.value().value("tags", Json::array())) {
+              t.addTag(tag);
+            }
+            expected[project.key()][task.key()] = t.json();
+          }
+        }
+        REQUIRE(loaded(filePath, text) == expected);
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("databases the TodoParser does not read") {
+
+    THEN("they are left to nlohmann::json, which reads them or says why not") {
+
+      for (const std::string text :
+           {"{\"P\":{\"A\":{\"completed\":true,\"priority\":1}}}", "{\"P\":null}",
+            "{\"P\":{\"A\":{\"completed\":true}}}\xef\xbb\xbf", "\xef\xbb\xbf{}"}) {
+        std::vector<TodoParser::ParsedProject> parsed;
+        REQUIRE_FALSE(TodoParser::parse(text, parsed));
+      }
+      REQUIRE(loaded(filePath, "{\"P\":{\"A\":{\"completed\":true,\"priority\":1}}}") ==
+              Json::parse("{\"P\":{\"A\":{\"completed\":true,\"dueDate\":\"\"}}}"));
+      REQUIRE(loaded(filePath, "\xef\xbb\xbf{\"P\":null}") == Json::parse("{\"P\":{}}"));
+
+      for (const std::string text :
+           {"", "{", "{\"P\":{},}", "{\"P\":{}}}", "{\"P\":{\"A\":{\"completed\":truex}}}",
+            "{\"P\":{\"A\":{\"dueDate\":\"\\ud83d\"}}}", "{\"P\\x\":{}}", "{\"\x01\":{}}",
+            "{\"\xc3\":{}}", "{\"\xed\xa0\x80\":{}}", "{\"P\":{\"A\":{\"dueDate\":\"soon\"}}}",
+            "{\"P\":{\"A\":{\"completed\":1}}}", "{\"P\":{\"A\":{\"tags\":[1]}}}"}) {
+        std::vector<TodoParser::ParsedProject> parsed;
+        REQUIRE_FALSE(TodoParser::parse(text, parsed));
+        std::ofstream(filePath, std::ios::binary) << text;
+        TodoList tlObj;
+        REQUIRE_THROWS(tlObj.load(filePath));
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  for (const char *suffix : {"", ".stats", ".lock"}) {
+    std::remove((filePath + suffix).c_str());
+  }
+
+} // SCENARIO
@@ -0,0 +1,113 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for reading and writing
+// dates as YYYY-MM-DD, one at a time and many at once.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../src/date.h"
+
+// Returns a date written with printf, zero-padded
+static std::string printed(unsigned int year, unsigned int month, unsigned int day) {
+  char text[32];
+  std::snprintf(text, sizeof(text), "%04u-%02u-%02u", year, month, day);
+  return text;
+}
+
+SCENARIO("Every date can be read and written as YYYY-MM-DD", "[date]") {
+
+  GIVEN("every day of every month of some years, leap or not") {
+
+    THEN("each is written as printf writes it and read back the same") {
+
+      std::vector<Date> dates;
+      std::vector<std::string> expected;
+      for (unsigned int year : {0u, 7u, 999u, 1900u, 2000u, 2023u, 2024u, 9999u}) {
+        for (unsigned int month = 1; month <= 12; month++) {
+          for (unsigned int day = 1; day <= 31; day++) {
+            Date date;
+            if (date.checkValidDate(year, month, day)) {
+              date.setDate(year, month, day);
+              dates.push_back(date);
+              expected.push_back(printed(year, month, day));
+            }
+          }
+        }
+      }
+      REQUIRE(dates.size() == 8 * 365 + 4);
+
+      std::vector<std::string> texts;
+      Date::formatMany(dates, texts);
+      REQUIRE(texts == expected);
+
+      std::vector<Date> parsed;
+      REQUIRE(Date::parseMany(texts, parsed));
+      REQUIRE(parsed.size() == dates.size());
+      for (std::size_t i = 0; i < dates.size(); i++) {
+        REQUIRE(parsed[i] == dates[i]);
+        REQUIRE(parsed[i].isInitialised());
+        REQUIRE(dates[i].str() == expected[i]);
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a date with a year of more than four digits") {
+
+    Date date;
+    date.setDate(12345, 6, 7);
+
+    THEN("it is written in full") {
+
+      REQUIRE(date.str() == "12345-06-07");
+      REQUIRE(date.strLength() == 11);
+
+    } // THEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("Texts that are not dates as YYYY-MM-DD are not read", "[date]") {
+
+  GIVEN("dates with a character that is not a digit, or that do not exist") {
+
+    const std::vector<std::string> texts = {
+        "20a4-01-01", "+024-01-01", " 024-01-01", "2024-1 -01", "2024-01-0/", "2024-01-0:",
+        "2024-\xb1" "1-01", "2024-\x81" "1-01", "2024-00-10", "2024-13-10", "2024-01-00",
+        "2024-01-32", "2023-02-29", "2024-04-31", "2024/01/01", "2024-01-1", "2024-01-011"};
+
+    THEN("each is rejected, leaving the date as it was, and setting it throws") {
+
+      for (const std::string &text : texts) {
+        INFO("text " << text);
+        Date date;
+        date.setDate(2000, 1, 1);
+        REQUIRE_FALSE(Date::parse(text.data(), text.size(), date));
+        REQUIRE(date.str() == "2000-01-01");
+        REQUIRE_THROWS_AS(date.setDateFromString(text), std::invalid_argument);
+      }
+
+    } // THEN
+
+    THEN("reading them with valid and empty dates says one was not read") {
+
+      std::vector<Date> dates;
+      REQUIRE_FALSE(Date::parseMany({"2024-02-29", "", texts[0]}, dates));
+      REQUIRE(dates.size() == 3);
+      REQUIRE(dates[0].str() == "2024-02-29");
+      REQUIRE_FALSE(dates[1].isInitialised());
+
+    } // THEN
+
+  } // GIVEN
+
+} // SCENARIO
@@ -0,0 +1,195 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for the compact JSON each
+// Project keeps between writes, and for printing JSON
+// that has already been written with a JsonWriter.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/jsonwriter.h"
+#include "../src/todo.h"
+
+// Returns the JSON a writer of a style prints for a TodoList
+static std::string printJson(const TodoList &tl, JsonWriter::Style style) {
+  std::stringstream out;
+  {
+    JsonWriter writer(out, style);
+    tl.write(writer);
+  }
+  return out.str();
+}
+
+SCENARIO("A Project keeps its compact JSON until it or a task changes", "[json]") {
+
+  GIVEN("a TodoList with two projects, one written before") {
+
+    TodoList tl;
+    tl.newProject("Q").newTask("C");
+    Project &p = tl.newProject("P");
+    Task &a = p.newTask("A");
+    a.addTag("x");
+    a.addTag("y");
+    p.newTask("B").setComplete(true);
+
+    const std::string before = printJson(tl, JsonWriter::COMPACT);
+    REQUIRE(before == "{\"P\":{\"A\":{\"completed\":false,\"dueDate\":\"\",\"tags\":[\"x\",\"y\"]},"
+                      "\"B\":{\"completed\":true,\"dueDate\":\"\"}},"
+                      "\"Q\":{\"C\":{\"completed\":false,\"dueDate\":\"\"}}}");
+
+    THEN("writing it again uses the same JSON") {
+
+      const std::shared_ptr<const std::string> first = p.compactJson();
+      REQUIRE(p.compactJson().get() == first.get());
+      REQUIRE(printJson(tl, JsonWriter::COMPACT) == before);
+      REQUIRE(p.compactJson().get() == first.get());
+
+    } // THEN
+
+    THEN("each change to the project or a task writes it again") {
+
+      Date due;
+      due.setDate(2024, 10, 13);
+      const std::vector<std::function<void()>> changes = {
+          [&]() { p.getTask("A").setComplete(true); },
+          [&]() { p.getTask("A").setDueDate(due); },
+          [&]() { p.getTask("A").addTag("z"); },
+          [&]() { p.getTask("A").deleteTag("x"); },
+          [&]() { p.getTask("A").mergeTags({"w"}); },
+          [&]() {
+            std::string ident = "A2";
+            p.getTask("A").setIndent(ident);
+          },
+          [&]() { p.newTask("D"); },
+          [&]() { p.addTask(Task("E")); },
+          [&]() { p.deleteTask("B"); },
+          [&]() { tl.getProject("P").setIdent("P2"); },
+      };
+
+      for (const std::function<void()> &change : changes) {
+        Project &project = tl.getProject(tl.getProjects().back().getIdent());
+        const unsigned long generation = project.getGeneration();
+        const std::shared_ptr<const std::string> json = project.compactJson();
+        const std::shared_ptr<const std::string> other = tl.getProject("Q").compactJson();
+        change();
+
+        REQUIRE(project.getGeneration() > generation);
+        REQUIRE(project.compactJson().get() != json.get());
+        REQUIRE(Json::parse(*project.compactJson()) == project.json());
+        REQUIRE(tl.getProject("Q").compactJson().get() == other.get());
+        REQUIRE(Json::parse(printJson(tl, JsonWriter::COMPACT)) == tl.json());
+        REQUIRE(Json::parse(printJson(tl, JsonWriter::PRETTY)) == tl.json());
+      }
+
+    } // THEN
+
+    THEN("a copy keeps the JSON until it is changed, apart from the original") {
+
+      const std::shared_ptr<const std::string> json = p.compactJson();
+      Project copy(p);
+      REQUIRE(copy.compactJson().get() == json.get());
+
+      copy.getTask("A").addTag("z");
+      REQUIRE(copy.compactJson()->find("\"z\"") != std::string::npos);
+      REQUIRE(p.compactJson().get() == json.get());
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a project with more JSON than a quarter of a writer's buffer") {
+
+    TodoList tl;
+    Project &p = tl.newProject("P");
+    for (unsigned int i = 0; i < 2000; i++) {
+      p.newTask("Task " + std::to_string(i)).addTag("tag");
+    }
+    REQUIRE(p.compactJson()->size() > JsonWriter::BUFFER_SIZE / 4);
+
+    THEN("it is printed whole after what comes before it") {
+
+      const std::string json = printJson(tl, JsonWriter::COMPACT);
+      REQUIRE(json == "{\"P\":" + *p.compactJson() + "}");
+      REQUIRE(Json::parse(json) == tl.json());
+
+    } // THEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("JSON already written can be printed with a JsonWriter", "[json]") {
+
+  GIVEN("a writer printing an array of values") {
+
+    std::stringstream out;
+    const std::string large = "\"" + std::string(JsonWriter::BUFFER_SIZE, 'x') + "\"";
+
+    WHEN("small and large values written before are printed with others") {
+
+      {
+        JsonWriter writer(out, JsonWriter::COMPACT);
+        writer.beginArray();
+        writer.value(true);
+        writer.fragment("{\"a\":[1,2]}");
+        writer.fragment(large);
+        writer.value("s");
+        writer.endArray();
+      }
+
+      THEN("they are separated like any other value") {
+
+        REQUIRE(out.str() == "[true,{\"a\":[1,2]}," + large + ",\"s\"]");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("A session prints changes made since the database was last printed", "[json]") {
+
+  const std::string filePath = "./tests/testdatabasefragment.json";
+  std::ofstream(filePath) << "{\"P\":{\"A\":{\"completed\":false,\"dueDate\":\"\",\"tags\":[]}}}";
+
+  GIVEN("a batch printing the database before and after a change") {
+
+    std::stringstream in;
+    in << "--action json\n"
+       << "--action update --project P --task A --completed\n"
+       << "--action json\n";
+    std::stringstream out, err;
+    Session session(filePath);
+
+    THEN("the second print has the change") {
+
+      REQUIRE(App::batch(session, in, out, err) == 0);
+      std::vector<std::string> lines;
+      std::string line;
+      while (std::getline(out, line)) {
+        lines.push_back(line);
+      }
+      REQUIRE(lines.size() == 5);
+      REQUIRE(lines[0] == "{\"P\":{\"A\":{\"completed\":false,\"dueDate\":\"\"}}}");
+      REQUIRE(lines[3] == "{\"P\":{\"A\":{\"completed\":true,\"dueDate\":\"\"}}}");
+
+    } // THEN
+
+  } // GIVEN
+
+  for (const char *suffix : {"", ".stats", ".lock", ".journal"}) {
+    std::remove((filePath + suffix).c_str());
+  }
+
+} // SCENARIO
@@ -0,0 +1,211 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for printing a database as
+// JSON as it is read, without loading it, with the
+// json action and with a JsonExporter.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/lib_cxxopts.hpp"
+
+#include "../src/exporter.h"
+#include "../src/todo.h"
+
+// Returns what a command prints against a session, and its exit code
+static std::string runCommand(Session &session, const std::vector<std::string> &arguments,
+                              int &status, std::string &error) {
+  cxxopts::Options options = App::cxxoptsSetup();
+  std::vector<std::string> argv = {"test"};
+  argv.insert(argv.end(), arguments.begin(), arguments.end());
+  std::stringstream out, err;
+  status = App::execute(session, options, argv, out, err);
+  error = err.str();
+  return out.str();
+}
+
+// Returns what a TodoList loaded from a database prints with a JsonWriter
+static std::string loadedJson(const std::string &filePath, JsonWriter::Style style) {
+  TodoList tlObj;
+  tlObj.load(filePath);
+  std::stringstream out;
+  {
+    JsonWriter writer(out, style);
+    tlObj.write(writer);
+  }
+  return out.str() + "\n";
+}
+
+SCENARIO("The json action prints a database as it is read", "[json]") {
+
+  const std::string filePath = "./tests/testdatabasestream.json";
+
+  GIVEN("a database with empty projects, escapes, due dates and unknown members") {
+
+    std::ofstream(filePath)
+        << "{\"Empty\":{},\"Old\":null,\"P \\\"1\\\"\":{\"A\":{\"completed\":true,"
+           "\"dueDate\":\"2026-02-03\",\"extra\":{\"nested\":[1,{\"x\":null}]},"
+           "\"tags\":[\"x\",\"\\u00e9\"]},\"B\":{\"completed\":false,\"dueDate\":\"\"}},"
+           "\"Q\":{\"C\":{\"tags\":[]}}}";
+
+    THEN("it prints, compact or pretty, what the loaded database prints, "
+         "without loading it") {
+
+      for (const bool pretty : {false, true}) {
+        Session session(filePath);
+        int status;
+        std::string error;
+        std::vector<std::string> arguments = {"--db", filePath, "--action", "json"};
+        if (pretty) {
+          arguments.push_back("--pretty");
+        }
+        const std::string output = runCommand(session, arguments, status, error);
+
+        REQUIRE(status == 0);
+        REQUIRE(error.empty());
+        REQUIRE_FALSE(session.isLoaded());
+        REQUIRE(output == loadedJson(filePath, pretty ? JsonWriter::PRETTY
+                                                      : JsonWriter::COMPACT));
+      }
+
+    } // THEN
+
+    THEN("a session that has changed the database prints the changes") {
+
+      Session session(filePath);
+      int status;
+      std::string error;
+      runCommand(session, {"--db", filePath, "--action", "create", "--project", "New"},
+                 status, error);
+      REQUIRE(status == 0);
+      const std::string output =
+          runCommand(session, {"--db", filePath, "--action", "json"}, status, error);
+
+      REQUIRE(status == 0);
+      REQUIRE(Json::parse(output).contains("New"));
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a database saved by a TodoList") {
+
+    TodoList saved;
+    for (unsigned int p = 0; p < 20; p++) {
+      Project &project = saved.newProject("Project " + std::to_string(p));
+      for (unsigned int t = 0; t < 50; t++) {
+        Task &task = project.newTask("Task " + std::to_string(t));
+        task.addTag("tag " + std::to_string(t % 7));
+        task.setComplete(t % 3 == 0);
+      }
+    }
+    saved.save(filePath);
+
+    THEN("a JsonExporter prints it as the loaded TodoList prints itself") {
+
+      std::stringstream out;
+      JsonExporter exporter(out, JsonWriter::COMPACT);
+      exporter.exportFile(filePath);
+      exporter.finish();
+      REQUIRE(out.str() + "\n" == loadedJson(filePath, JsonWriter::COMPACT));
+
+      TodoList tlObj;
+      tlObj.load(filePath);
+      std::stringstream fromList;
+      JsonExporter listExporter(fromList, JsonWriter::COMPACT);
+      listExporter.exportTodoList(tlObj);
+      listExporter.finish();
+      REQUIRE(fromList.str() == out.str());
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a database that is not valid") {
+
+    std::ofstream(filePath) << "{\"P\":{\"A\":{\"completed\":true}},\"Q\":{\"B\":{\"dueDate\":\"soon\"}}}";
+
+    THEN("the json action says why, without printing any of it") {
+
+      Session session(filePath);
+      int status;
+      std::string error;
+      const std::string output =
+          runCommand(session, {"--db", filePath, "--action", "json"}, status, error);
+
+      REQUIRE(status == 1);
+      REQUIRE(error.find("Error: Invalid database") == 0);
+      REQUIRE(output.empty());
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a database out of order, with a project and a task given twice") {
+
+    std::ofstream(filePath)
+        << "{\"Z\":{\"B\":{},\"A\":{\"completed\":true}},\"A\":{\"X\":{},\"X\":{\"tags\":[\"t\"]}},"
+           "\"Z\":{\"C\":{}}}";
+
+    THEN("the json action prints it as loading it leaves it, sorted and keeping "
+         "the last of each") {
+
+      Session session(filePath);
+      int status;
+      std::string error;
+      const std::string output =
+          runCommand(session, {"--db", filePath, "--action", "json"}, status, error);
+
+      REQUIRE(status == 0);
+      REQUIRE(error.empty());
+      REQUIRE(output == loadedJson(filePath, JsonWriter::COMPACT));
+      const Json printed = Json::parse(output);
+      REQUIRE(printed.size() == 2);
+      REQUIRE(output.find("{\"A\":{\"X\":") == 0);
+      REQUIRE(printed["A"].size() == 1);
+      REQUIRE(printed["A"]["X"]["tags"] == Json({"t"}));
+      REQUIRE(printed["Z"].size() == 1);
+      REQUIRE(printed["Z"].contains("C"));
+
+      std::stringstream out;
+      JsonExporter exporter(out, JsonWriter::COMPACT);
+      REQUIRE_FALSE(exporter.exportFileInOrder(filePath));
+      REQUIRE(out.str().empty());
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a database that does not exist") {
+
+    std::remove(filePath.c_str());
+
+    THEN("the json action says so") {
+
+      Session session(filePath);
+      int status;
+      std::string error;
+      const std::string output =
+          runCommand(session, {"--db", filePath, "--action", "json"}, status, error);
+
+      REQUIRE(status == 1);
+      REQUIRE(error == "Error: File failed to open.\n");
+      REQUIRE(output.empty());
+
+    } // THEN
+
+  } // GIVEN
+
+  for (const char *suffix : {"", ".stats", ".lock", ".journal"}) {
+    std::remove((filePath + suffix).c_str());
+  }
+
+} // SCENARIO
@@ -0,0 +1,208 @@
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for reading a file on another
+// thread with a FileReader, and for handing a database
+// to a TodoParser a piece at a time as it is read.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/filereader.h"
+#include "../src/todolist.h"
+#include "../src/todoparser.h"
+
+// Returns a file as read by a FileReader with buffers of a size
+static std::string readPieces(const std::string &filePath, std::size_t bufferSize,
+                              unsigned int bufferCount) {
+  FileReader reader(filePath, bufferSize, bufferCount);
+  std::string text;
+  const char *data;
+  std::size_t length;
+  bool fits = true;
+  while (reader.next(data, length)) {
+    fits = fits && length > 0 && length <= bufferSize;
+    text.append(data, length);
+  }
+  REQUIRE(fits);
+  REQUIRE_FALSE(reader.next(data, length));
+  return text;
+}
+
+// Returns whether two lists of projects read by a TodoParser are the same
+static bool sameProjects(const std::vector<TodoParser::ParsedProject> &a,
+                         const std::vector<TodoParser::ParsedProject> &b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.size(); i++) {
+    if (a[i].ident != b[i].ident || a[i].tasks.size() != b[i].tasks.size()) {
+      return false;
+    }
+    for (std::size_t j = 0; j < a[i].tasks.size(); j++) {
+      if (a[i].tasks[j].json() != b[i].tasks[j].json() ||
+          a[i].tasks[j].getIdent() != b[i].tasks[j].getIdent()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+SCENARIO("A FileReader reads a file in pieces on another thread", "[filereader]") {
+
+  const std::string filePath = "./tests/testfilereader.txt";
+
+  GIVEN("files of different sizes") {
+
+    std::mt19937 random(3);
+
+    THEN("the pieces taken make up the file, whatever the size and number of buffers") {
+
+      for (const std::size_t size : {0, 1, 63, 64, 4096, 100000}) {
+        std::string contents;
+        for (std::size_t i = 0; i < size; i++) {
+          contents += static_cast<char>(random());
+        }
+        std::ofstream(filePath, std::ios::binary) << contents;
+
+        for (const std::size_t bufferSize : {1, 7, 64, 1000, 1 << 20}) {
+          for (const unsigned int bufferCount : {0, 2, 3, 8}) {
+            INFO("size " << size << ", buffers " << bufferCount << " of " << bufferSize);
+            REQUIRE(readPieces(filePath, bufferSize, bufferCount) == contents);
+          }
+        }
+        FileReader reader(filePath);
+        REQUIRE(reader.isOpen());
+        REQUIRE(reader.size() == size);
+      }
+
+    } // THEN
+
+    THEN("a reader can be destroyed before the whole file is taken") {
+
+      std::ofstream(filePath, std::ios::binary) << std::string(100000, 'x');
+      for (unsigned int n = 0; n < 20; n++) {
+        FileReader reader(filePath, 100, 2);
+        const char *data;
+        std::size_t length;
+        REQUIRE(reader.next(data, length));
+        REQUIRE(std::string(data, length) == std::string(100, 'x'));
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a file that does not exist") {
+
+    std::remove(filePath.c_str());
+
+    THEN("it is not open, and has nothing to take") {
+
+      FileReader reader(filePath);
+      const char *data;
+      std::size_t length;
+      REQUIRE_FALSE(reader.isOpen());
+      REQUIRE_FALSE(reader.next(data, length));
+
+    } // THEN
+
+  } // GIVEN
+
+  std::remove(filePath.c_str());
+
+} // SCENARIO
+
+SCENARIO("A TodoParser can be handed a database a piece at a time", "[parser]") {
+
+  const std::string filePath = "./tests/testdatabasepieces.json";
+
+  GIVEN("databases, and text that is not one as save writes it") {
+
+    TodoList tlObj;
+    for (unsigned int p = 0; p < 30; p++) {
+      Project &project = tlObj.newProject("Project \"" + std::to_string(p * 7 % 30) + "\"");
+      for (unsigned int t = 0; t < p % 5; t++) {
+        Task &task = project.newTask("T\xc3\xa9" + std::to_string(t));
+        task.setComplete(t % 2 == 0);
+        task.addTag("tag" + std::to_string(t));
+        Date date;
+        date.setDateFromString("2024-10-1" + std::to_string(t));
+        task.setDueDate(date);
+      }
+    }
+    const std::string database = tlObj.json().dump();
+    const std::vector<std::string> texts = {
+        database,
+        tlObj.json().dump(2),
+        "{}",
+        " \n{ } ",
+        "{\"P\":{\"B\":{\"completed\":true},\"A\":{\"completed\":false}},\"A\":{}}",
+        "{\"P\":{\"A\":{\"completed\":true,\"priority\":1}}}",
+        "{\"P\":{}},",
+        "{\"P\":{\"A\":{\"dueDate\":\"\x01\"}}}",
+        "{\"P\":{\"A\":{\"dueDate\":\"2024",
+        "\xef\xbb\xbf{}"};
+
+    THEN("the projects read are those parse reads, however the text is split") {
+
+      std::mt19937 random(11);
+      for (const std::string &text : texts) {
+        INFO("text " << text.substr(0, 80));
+        std::vector<TodoParser::ParsedProject> expected;
+        const bool valid = TodoParser::parse(text, expected);
+
+        for (unsigned int n = 0; n < 20; n++) {
+          const std::size_t most = n == 0 ? 1 : 1 + random() % 300;
+          TodoParser parser(n % 2 ? text.size() : 0);
+          for (std::size_t position = 0; position < text.size();) {
+            const std::size_t length = std::min<std::size_t>(1 + random() % most,
+                                                             text.size() - position);
+            parser.feed(text.data() + position, length);
+            position += length;
+          }
+          std::vector<TodoParser::ParsedProject> parsed;
+          REQUIRE(parser.finish(parsed) == valid);
+          REQUIRE(parser.getText() == text);
+          if (valid) {
+            REQUIRE(sameProjects(parsed, expected));
+          }
+        }
+      }
+
+    } // THEN
+
+    THEN("loading the database from a file read in pieces gives the same TodoList") {
+
+      std::ofstream(filePath, std::ios::binary) << database;
+      TodoList loaded;
+      loaded.load(filePath);
+      REQUIRE(loaded.json() == tlObj.json());
+
+      std::ofstream(filePath, std::ios::binary) << "\xef\xbb\xbf" << database;
+      TodoList fallback;
+      fallback.load(filePath);
+      REQUIRE(fallback.json() == tlObj.json());
+
+      std::remove(filePath.c_str());
+      TodoList missing;
+      REQUIRE_THROWS_WITH(missing.load(filePath), "File failed to open.");
+
+    } // THEN
+
+  } // GIVEN
+
+  for (const char *suffix : {"", ".stats", ".lock"}) {
+    std::remove((filePath + suffix).c_str());
+  }
+
+} // SCENARIO